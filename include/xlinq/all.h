@@ -33,15 +33,17 @@ SOFTWARE.
 #include "xlinq_exception.h"
 #include "xlinq_base.h"
 #include "xlinq_aggregate.h"
+#include "xlinq_aggregate_by.h"
 #include "xlinq_all.h"
 #include "xlinq_any.h"
 #include "xlinq_avg.h"
 #include "xlinq_concat.h"
-#include "xlinq_count.h
+#include "xlinq_count.h"
 #include "xlinq_distinct.h"
 #include "xlinq_element_at.h"
 #include "xlinq_enumerable.h"
 #include "xlinq_except.h"
+#include "xlinq_external_sort.h"
 #include "xlinq_first.h"
 #include "xlinq_from_array.h"
 #include "xlinq_from_container.h"
@@ -51,18 +53,28 @@ SOFTWARE.
 #include "xlinq_from.h"
 #include "xlinq_gather.h"
 #include "xlinq_group_by.h"
+#include "xlinq_hash_set.h"
 #include "xlinq_intersect.h"
 #include "xlinq_join.h"
 #include "xlinq_last.h"
 #include "xlinq_lookup.h"
 #include "xlinq_max.h"
+#include "xlinq_merge_join.h"
 #include "xlinq_min.h"
+#include "xlinq_parallel.h"
+#include "xlinq_predicate.h"
+#include "xlinq_radix_sort.h"
+#include "xlinq_reduce.h"
 #include "xlinq_reverse.h"
 #include "xlinq_select.h"
 #include "xlinq_select_many.h"
+#include "xlinq_semi_join.h"
 #include "xlinq_sequence_equals.h"
 #include "xlinq_skip.h"
 #include "xlinq_sort.h"
+#include "xlinq_spill.h"
+#include "xlinq_static.h"
+#include "xlinq_stats.h"
 #include "xlinq_stl.h"
 #include "xlinq_sum.h"
 #include "xlinq_take.h"
@@ -30,6 +30,7 @@ SOFTWARE.
 #define XLINQ_AGGREGATE_H_
 
 #include "xlinq_base.h"
+#include "xlinq_static.h"
 #include <type_traits>
 
 namespace xlinq
@@ -45,12 +46,16 @@ namespace xlinq
 			template<typename TElem>
 			TElem int_aggregate(std::shared_ptr<IEnumerable<TElem>> enumerable)
 			{
-				auto en = enumerable->getEnumerator();
-				en->next();
-				auto aggVal = en->current();
-				while(en->next())
+				_BatchReader<TElem> reader(enumerable->getEnumerator());
+				if (!reader.read())
+					throw IterationFinishedException();
+				auto aggVal = reader[0];
+				for (int i = 1; i < reader.size(); ++i)
+					aggVal = _aggregator(aggVal, reader[i]);
+				while (reader.read())
 				{
-					aggVal = _aggregator(aggVal, en->current());
+					for (int i = 0; i < reader.size(); ++i)
+						aggVal = _aggregator(aggVal, reader[i]);
 				}
 				return aggVal;
 			}
@@ -74,22 +79,42 @@ namespace xlinq
 			{
 				return int_aggregate((std::shared_ptr<IEnumerable<TElem>>)enumerable);
 			}
+
+			template<typename TSource>
+			typename TSource::ElemType build(const StaticEnumerable<TSource>& enumerable)
+			{
+				auto en = enumerable.derived().getEnumerator();
+				if (!en.next())
+					throw IterationFinishedException();
+				auto result = en.current();
+				while (en.next())
+					result = _aggregator(result, en.current());
+				return result;
+			}
+
+			template<typename TQuery>
+			auto build(const ParallelEnumerable<TQuery>& enumerable) -> decltype(enumerable.derived().aggregate(_aggregator))
+			{
+				return enumerable.derived().aggregate(_aggregator);
+			}
 		};
 
 		template<typename TResult, typename TAggregator>
 		class _AggregateResultBuilder
 		{
+		protected:
 			TResult _seed;
 			TAggregator _aggregator;
 
 			template<typename TElem>
 			TResult int_aggregate(std::shared_ptr<IEnumerable<TElem>> enumerable)
 			{
-				auto en = enumerable->getEnumerator();
+				_BatchReader<TElem> reader(enumerable->getEnumerator());
 				TResult aggVal = _seed;
-				while (en->next())
+				while (reader.read())
 				{
-					aggVal = _aggregator(aggVal, en->current());
+					for (int i = 0; i < reader.size(); ++i)
+						aggVal = _aggregator(aggVal, reader[i]);
 				}
 				return aggVal;
 			}
@@ -113,6 +138,33 @@ namespace xlinq
 			{
 				return int_aggregate((std::shared_ptr<IEnumerable<TElem>>)enumerable);
 			}
+
+			template<typename TSource>
+			TResult build(const StaticEnumerable<TSource>& enumerable)
+			{
+				auto en = enumerable.derived().getEnumerator();
+				TResult aggVal = _seed;
+				while (en.next())
+					aggVal = _aggregator(aggVal, en.current());
+				return aggVal;
+			}
+		};
+
+		template<typename TResult, typename TAggregator, typename TCombiner>
+		class _AggregateCombineBuilder : public _AggregateResultBuilder<TResult, TAggregator>
+		{
+			TCombiner _combiner;
+		public:
+			_AggregateCombineBuilder(TResult seed, TAggregator aggregator, TCombiner combiner)
+				: _AggregateResultBuilder<TResult, TAggregator>(seed, aggregator), _combiner(combiner) {}
+
+			using _AggregateResultBuilder<TResult, TAggregator>::build;
+
+			template<typename TQuery>
+			TResult build(const ParallelEnumerable<TQuery>& enumerable)
+			{
+				return enumerable.derived().aggregate(this->_seed, this->_aggregator, _combiner);
+			}
 		};
 	}
 	/*@endcond*/
@@ -140,6 +192,19 @@ namespace xlinq
 	{
 		return internal::_AggregateResultBuilder<TResult, TAggregator>(seed, aggregator);
 	}
+
+	/**
+	*	Aggregates collection elements to any element type using given function, seed and combiner.
+	*	Sequential queries are aggregated the same way as without combiner. Parallel queries
+	*	aggregate each part of collection starting with seed and then merge partial results
+	*	in collection order using combiner, so seed should be neutral element of combiner.
+	*	@return Builder of aggregate expression.
+	*/
+	template<typename TResult, typename TAggregator, typename TCombiner>
+	XLINQ_INLINE internal::_AggregateCombineBuilder<TResult, TAggregator, TCombiner> aggregate(TResult seed, TAggregator aggregator, TCombiner combiner)
+	{
+		return internal::_AggregateCombineBuilder<TResult, TAggregator, TCombiner>(seed, aggregator, combiner);
+	}
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,172 @@
+/*
+MIT License
+
+Copyright (c) 2017 TrolleY
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+*	@file xlinq_aggregate_by.h
+*	Aggregating collection elements grouped by common key.
+*	@author TrolleY
+*/
+#ifndef XLINQ_AGGREGATE_BY_H_
+#define XLINQ_AGGREGATE_BY_H_
+
+#include "xlinq_base.h"
+#include "xlinq_from.h"
+#include <memory>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace xlinq
+{
+	/*@cond XLINQ_INTERNAL*/
+	namespace internal
+	{
+		template<typename TKeySelector, typename TKey, typename TElem, typename TResult, typename TAggregator>
+		class _AggregateByEnumerable : public IEnumerable<std::pair<TKey, TResult>>
+		{
+		private:
+			std::shared_ptr<IEnumerable<TElem>> _source;
+			TKeySelector _keySelector;
+			TResult _seed;
+			TAggregator _aggregator;
+
+		public:
+			_AggregateByEnumerable(std::shared_ptr<IEnumerable<TElem>> source, TKeySelector keySelector, TResult seed, TAggregator aggregator)
+				: _source(source), _keySelector(keySelector), _seed(seed), _aggregator(aggregator) {}
+
+			std::shared_ptr<IEnumerator<std::pair<TKey, TResult>>> createEnumerator() override
+			{
+				std::unordered_map<TKey, int> index;
+				auto results = std::make_shared<std::vector<std::pair<TKey, TResult>>>();
+				_BatchReader<TElem> reader(_source->getEnumerator());
+				while (reader.read())
+				{
+					for (int i = 0; i < reader.size(); ++i)
+					{
+						TKey key = _keySelector(reader[i]);
+						auto it = index.find(key);
+						if (it == index.end())
+						{
+							it = index.insert(std::make_pair(key, (int)results->size())).first;
+							results->push_back(std::make_pair(key, _seed));
+						}
+						auto& result = (*results)[it->second].second;
+						result = _aggregator(result, reader[i]);
+					}
+				}
+				return from(results)->getEnumerator();
+			}
+		};
+
+		template<typename TKeySelector, typename TResult, typename TAggregator>
+		class _AggregateByBuilder
+		{
+		protected:
+			TKeySelector _keySelector;
+			TResult _seed;
+			TAggregator _aggregator;
+
+		public:
+			_AggregateByBuilder(TKeySelector keySelector, TResult seed, TAggregator aggregator)
+				: _keySelector(keySelector), _seed(seed), _aggregator(aggregator) {}
+
+			template<typename TElem>
+			auto build(std::shared_ptr<IEnumerable<TElem>> enumerable) -> std::shared_ptr<IEnumerable<std::pair<typename std::decay<typename unaryreturntype<TKeySelector, TElem>::type>::type, TResult>>>
+			{
+				typedef typename std::decay<typename unaryreturntype<TKeySelector, TElem>::type>::type TKey;
+				return std::shared_ptr<IEnumerable<std::pair<TKey, TResult>>>(
+					new _AggregateByEnumerable<TKeySelector, TKey, TElem, TResult, TAggregator>(enumerable, _keySelector, _seed, _aggregator));
+			}
+
+			template<typename TElem>
+			auto build(std::shared_ptr<IBidirectionalEnumerable<TElem>> enumerable) -> std::shared_ptr<IEnumerable<std::pair<typename std::decay<typename unaryreturntype<TKeySelector, TElem>::type>::type, TResult>>>
+			{
+				return build((std::shared_ptr<IEnumerable<TElem>>)enumerable);
+			}
+
+			template<typename TElem>
+			auto build(std::shared_ptr<IRandomAccessEnumerable<TElem>> enumerable) -> std::shared_ptr<IEnumerable<std::pair<typename std::decay<typename unaryreturntype<TKeySelector, TElem>::type>::type, TResult>>>
+			{
+				return build((std::shared_ptr<IEnumerable<TElem>>)enumerable);
+			}
+		};
+
+		template<typename TKeySelector, typename TResult, typename TAggregator, typename TCombiner>
+		class _AggregateByCombineBuilder : public _AggregateByBuilder<TKeySelector, TResult, TAggregator>
+		{
+			TCombiner _combiner;
+
+		public:
+			_AggregateByCombineBuilder(TKeySelector keySelector, TResult seed, TAggregator aggregator, TCombiner combiner)
+				: _AggregateByBuilder<TKeySelector, TResult, TAggregator>(keySelector, seed, aggregator), _combiner(combiner) {}
+
+			using _AggregateByBuilder<TKeySelector, TResult, TAggregator>::build;
+
+			template<typename TQuery>
+			auto build(const ParallelEnumerable<TQuery>& enumerable) -> decltype(enumerable.derived().aggregate_by(this->_keySelector, this->_seed, this->_aggregator, _combiner))
+			{
+				return enumerable.derived().aggregate_by(this->_keySelector, this->_seed, this->_aggregator, _combiner);
+			}
+		};
+	}
+	/*@endcond*/
+
+	/**
+	*	Aggregates elements grouped by common key.
+	*	This function may be used instead of group_by followed by aggregation of each
+	*	group, because elements are folded into accumulator of their group immediately
+	*	and are not stored. Result collection contains pairs of key and accumulator
+	*	in order of first key occurrence. Key must have defined std::hash and std::equal_to
+	*	type spetialization.
+	*	@param keySelector Function extracting key from element.
+	*	@param seed Initial value of accumulator of each group.
+	*	@param aggregator Function folding element into accumulator.
+	*	@return Builder of aggregate_by expression.
+	*/
+	template<typename TKeySelector, typename TResult, typename TAggregator>
+	XLINQ_INLINE internal::_AggregateByBuilder<TKeySelector, TResult, TAggregator> aggregate_by(TKeySelector keySelector, TResult seed, TAggregator aggregator)
+	{
+		return internal::_AggregateByBuilder<TKeySelector, TResult, TAggregator>(keySelector, seed, aggregator);
+	}
+
+	/**
+	*	Aggregates elements grouped by common key using combiner for partial results.
+	*	Sequential queries are aggregated the same way as without combiner. Parallel
+	*	queries fold each part of collection into thread local tables and merge
+	*	accumulators of the same key using combiner, so seed should be neutral
+	*	element of combiner.
+	*	@param keySelector Function extracting key from element.
+	*	@param seed Initial value of accumulator of each group.
+	*	@param aggregator Function folding element into accumulator.
+	*	@param combiner Function merging two accumulators of the same key.
+	*	@return Builder of aggregate_by expression.
+	*/
+	template<typename TKeySelector, typename TResult, typename TAggregator, typename TCombiner>
+	XLINQ_INLINE internal::_AggregateByCombineBuilder<TKeySelector, TResult, TAggregator, TCombiner> aggregate_by(TKeySelector keySelector, TResult seed, TAggregator aggregator, TCombiner combiner)
+	{
+		return internal::_AggregateByCombineBuilder<TKeySelector, TResult, TAggregator, TCombiner>(keySelector, seed, aggregator, combiner);
+	}
+}
+
+#endif
\ No newline at end of file
@@ -30,6 +30,7 @@ SOFTWARE.
 #define XLINQ_ALL_H_
 
 #include "xlinq_base.h"
+#include "xlinq_static.h"
 
 namespace xlinq
 {
@@ -78,6 +79,24 @@ namespace xlinq
 				}
 				return true;
 			}
+
+			template<typename TSource>
+			bool build(const StaticEnumerable<TSource>& enumerable)
+			{
+				auto enumerator = enumerable.derived().getEnumerator();
+				while (enumerator.next())
+				{
+					if (!_predicate(enumerator.current()))
+						return false;
+				}
+				return true;
+			}
+
+			template<typename TQuery>
+			auto build(const ParallelEnumerable<TQuery>& enumerable) -> decltype(enumerable.derived().all(_predicate))
+			{
+				return enumerable.derived().all(_predicate);
+			}
 		};
 	}
 	/*@endcond*/
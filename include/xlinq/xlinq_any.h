@@ -30,6 +30,7 @@ SOFTWARE.
 #define XLINQ_ANY_H_
 
 #include "xlinq_base.h"
+#include "xlinq_static.h"
 #include "xlinq_where.h"
 
 namespace xlinq
@@ -57,6 +58,18 @@ namespace xlinq
 			{
 				return enumerable->getEnumerator()->next();
 			}
+
+			template<typename TSource>
+			bool build(const StaticEnumerable<TSource>& enumerable)
+			{
+				return enumerable.derived().getEnumerator().next();
+			}
+
+			template<typename TQuery>
+			auto build(const ParallelEnumerable<TQuery>& enumerable) -> decltype(enumerable.derived().any())
+			{
+				return enumerable.derived().any();
+			}
 		};
 
 		template<typename TPredicate>
@@ -83,6 +96,18 @@ namespace xlinq
 			{
 				return (enumerable >> where(_predicate))->getEnumerator()->next();
 			}
+
+			template<typename TSource>
+			bool build(const StaticEnumerable<TSource>& enumerable)
+			{
+				return (enumerable >> where(_predicate)).getEnumerator().next();
+			}
+
+			template<typename TQuery>
+			auto build(const ParallelEnumerable<TQuery>& enumerable) -> decltype(enumerable.derived().any(_predicate))
+			{
+				return enumerable.derived().any(_predicate);
+			}
 		};
 	}
 	/*@endcond*/
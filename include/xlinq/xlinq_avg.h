@@ -30,6 +30,8 @@ SOFTWARE.
 #define XLINQ_AVG_H_
 
 #include "xlinq_base.h"
+#include "xlinq_reduce.h"
+#include "xlinq_static.h"
 
 namespace xlinq
 {
@@ -39,21 +41,36 @@ namespace xlinq
 		template<typename TAvgElem>
 		class _AvgBuilder
 		{
+			SumMode _mode;
+
 			template<typename TElem>
 			TAvgElem int_avg(std::shared_ptr<IEnumerable<TElem>> enumerable)
 			{
-				auto en = enumerable->getEnumerator();
-				en->next();
-				TAvgElem avgVal = (TAvgElem)en->current();
-				TAvgElem items = 1;
-				while(en->next())
-				{
-					avgVal += (TAvgElem)en->current();
-					items++;
-				}
-				return avgVal / items;
+				_BatchReader<TElem> reader(enumerable->getEnumerator());
+				if (!reader.read())
+					throw IterationFinishedException();
+				long long items;
+				TAvgElem avgVal = sum_batches<TAvgElem>(reader, _mode, items);
+				return avgVal / (TAvgElem)items;
+			}
+
+			template<typename TElem>
+			TAvgElem span_avg(const TElem* data, int size)
+			{
+				if (!size)
+					throw IterationFinishedException();
+				return sum_span<TAvgElem>(data, size, _mode) / (TAvgElem)size;
 			}
 		public:
+			_AvgBuilder() : _mode(SumMode::FAST) {}
+
+			_AvgBuilder mode(SumMode mode) const
+			{
+				_AvgBuilder builder(*this);
+				builder._mode = mode;
+				return builder;
+			}
+
 			template<typename TElem>
 			TAvgElem build(std::shared_ptr<IEnumerable<TElem>> enumerable)
 			{
@@ -69,8 +86,35 @@ namespace xlinq
 			template<typename TElem>
 			TAvgElem build(std::shared_ptr<IRandomAccessEnumerable<TElem>> enumerable)
 			{
+				auto data = enumerable->data();
+				if (data)
+					return span_avg(data, enumerable->size());
 				return int_avg((std::shared_ptr<IEnumerable<TElem>>)enumerable);
 			}
+
+			template<typename TSource>
+			TAvgElem build(const StaticEnumerable<TSource>& enumerable)
+			{
+				auto en = enumerable.derived().getEnumerator();
+				if (!en.next())
+					throw IterationFinishedException();
+				if (_mode != SumMode::FAST && std::is_floating_point<TAvgElem>::value)
+				{
+					std::vector<TAvgElem> elements;
+					do
+						elements.push_back(en.current());
+					while (en.next());
+					return span_avg(elements.data(), (int)elements.size());
+				}
+				TAvgElem avgVal = (TAvgElem)en.current();
+				TAvgElem items = 1;
+				while (en.next())
+				{
+					avgVal += (TAvgElem)en.current();
+					items++;
+				}
+				return avgVal / items;
+			}
 		};
 	}
 	/*@endcond*/
@@ -79,6 +123,8 @@ namespace xlinq
 	*	Calculates average value of collection elements.
 	*	This function may be used to calculate average of collection elements.
 	*	It will throw IterationFinishedException if collection contains no elements.
+	*	Elements are summed as in sum, with vector instructions where possible.
+	*	Summation algorithm may be chosen with mode method of returned builder.
 	*	@return Builder of average expression.
 	*/
 	template<typename TAvgElem>
@@ -91,6 +137,8 @@ namespace xlinq
 	*	Calculates average value of collection elements.
 	*	This function may be used to calculate average of collection elements.
 	*	It will throw IterationFinishedException if collection contains no elements.
+	*	Elements are summed as in sum, with vector instructions where possible.
+	*	Summation algorithm may be chosen with mode method of returned builder.
 	*	@return Builder of average expression.
 	*/
 	XLINQ_INLINE internal::_AvgBuilder<double> avg()
@@ -30,8 +30,10 @@ SOFTWARE.
 #define XLINQ_BASE_H_
 
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <type_traits>
+#include <vector>
 #include "xlinq_defs.h"
 #include "xlinq_exception.h"
 
@@ -106,6 +108,45 @@ namespace xlinq
 		*/
 		virtual TElem current() XLINQ_ABSTRACT;
 
+		/**
+		*	Returns address of current element of enumeration.
+		*	This method allows to access current element without copying it. Enumerators
+		*	which point at elements stored in some collection return address of the element,
+		*	stages which only pass elements through forward the call to their source.
+		*	Enumerators producing elements on the fly return NULL, so #current has to be used.
+		*	Returned address is valid until enumerator is moved or source collection changes.
+		*	@throws IterationNotStartedException when called before first call of #next method.
+		*	@throws IterationFinishedException when called after #next method returned false.
+		*	@return address of current enumeration element or NULL.
+		*/
+		virtual const TElem* current_ptr()
+		{
+			return nullptr;
+		}
+
+		/**
+		*	Moves enumeration forward by many elements at once.
+		*	This method appends up to count next elements of enumeration to given buffer.
+		*	It behaves as if #next and #current were called for each appended element, but
+		*	it allows enumerators to fetch elements without paying for virtual call per element.
+		*	If returned number is smaller than count, then end enumeration guard has been reached.
+		*	After this call enumeration may be continued with #next or #next_batch, but
+		*	the value returned by #current is unspecified until #next is called.
+		*	@param buffer Buffer to append elements to. It is not cleared before appending.
+		*	@param count Maximal number of elements to append. It should be positive.
+		*	@return Number of appended elements.
+		*/
+		virtual int next_batch(std::vector<TElem>& buffer, int count)
+		{
+			int fetched = 0;
+			while (fetched < count && next())
+			{
+				buffer.push_back(current());
+				++fetched;
+			}
+			return fetched;
+		}
+
 		/**
 		*	Checks if enumerators equals.
 		*	The enumerators are equal when they were created from the same IEnumerable and
@@ -223,6 +264,17 @@ namespace xlinq
 		*/
 		typedef TElem ElemType;
 
+		/**
+		*	Returns number of elements in collection if it is known without enumeration.
+		*	This method allows consumers to count, reserve space for or bound access to
+		*	collection elements without traversing it. Stages which preserve or compute number
+		*	of elements of their sources, like select, take, skip, reverse and concat,
+		*	pass it further. Stages whose number of elements depends on elements, like where,
+		*	return -1.
+		*	@return Number of elements in collection, or -1 if it is not known.
+		*/
+		virtual int known_size() { return -1; }
+
 		_XLINQ_GET_ENUMERATOR(IEnumerator<TElem>)
 	};
 
@@ -277,6 +329,24 @@ namespace xlinq
 		*/
 		virtual int size() XLINQ_ABSTRACT;
 
+		/**
+		*	Returns number of elements in collection.
+		*	Random access collections always know their size.
+		*	@return Number of elements in collection.
+		*/
+		int known_size() override { return size(); }
+
+		/**
+		*	Accesses contiguous storage of collection elements.
+		*	This method allows to bypass enumerators when collection elements are stored
+		*	in one contiguous block of memory. Number of elements in the block is returned
+		*	by #size method. The pointer is valid as long as the underlying collection is not
+		*	modified or deallocated.
+		*	@return Pointer to the first element of collection, or nullptr if collection
+		*	elements are not stored contiguously.
+		*/
+		virtual const TElem* data() { return nullptr; }
+
 		_XLINQ_GET_ENUMERATOR(IRandomAccessEnumerator<TElem>)
 
 		_XLINQ_GET_END_ENUMERATOR(IRandomAccessEnumerator<TElem>)
@@ -299,6 +369,26 @@ namespace xlinq
 		virtual TKey getKey() const XLINQ_ABSTRACT;
 	};
 
+	/**
+	*	Base class of queries executed in parallel.
+	*	Parallel queries are created by parallel builder from random access
+	*	collections. Deriving class provides query operations as methods
+	*	which are called by builders supporting parallel execution.
+	*/
+	template<typename TDerived>
+	class ParallelEnumerable
+	{
+	public:
+		/**
+		*	Returns reference to deriving query.
+		*	@return Reference to deriving query.
+		*/
+		const TDerived& derived() const
+		{
+			return static_cast<const TDerived&>(*this);
+		}
+	};
+
 	/*@cond XLINQ_INTERNAL*/
 	namespace internal
 	{
@@ -368,6 +458,59 @@ namespace xlinq
 			}
 		};
 		
+		template<typename TElem>
+		class _BatchReader
+		{
+		private:
+			std::shared_ptr<IEnumerator<TElem>> _enumerator;
+			std::vector<TElem> _batch;
+			bool _finished;
+
+		public:
+			_BatchReader(std::shared_ptr<IEnumerator<TElem>> enumerator)
+				: _enumerator(enumerator), _finished(false)
+			{
+				_batch.reserve(XLINQ_BATCH_SIZE);
+			}
+
+			bool read()
+			{
+				_batch.clear();
+				if (_finished)
+					return false;
+				_finished = _enumerator->next_batch(_batch, XLINQ_BATCH_SIZE) < XLINQ_BATCH_SIZE;
+				return !_batch.empty();
+			}
+
+			int size() const { return (int)_batch.size(); }
+
+			const TElem& operator[](int index) const { return _batch[index]; }
+
+			const std::vector<TElem>& batch() const { return _batch; }
+		};
+
+		template<typename TElem>
+		class _SortedFrontSource
+		{
+		public:
+			virtual ~_SortedFrontSource() {}
+
+			virtual std::shared_ptr<IRandomAccessEnumerable<TElem>> sorted_front(int count) XLINQ_ABSTRACT;
+		};
+
+		template<typename TEnumerator, typename TPredicate>
+		bool current_matches(TEnumerator& enumerator, TPredicate& predicate)
+		{
+			auto elem = enumerator->current_ptr();
+			return elem ? (bool)predicate(*elem) : (bool)predicate(enumerator->current());
+		}
+
+		inline std::uint64_t mix_hash(std::size_t hash)
+		{
+			std::uint64_t mixed = (std::uint64_t)hash * 0x9E3779B97F4A7C15ull;
+			return mixed ^ (mixed >> 29);
+		}
+
 		template<typename TValue, typename TBuilder>
 		auto build(std::shared_ptr<TValue> ptr, TBuilder builder) -> decltype(builder.build(std::declval<std::shared_ptr<typename EnumerableTypeSelector<TValue>::type>>()))
 		{
@@ -389,6 +532,18 @@ namespace xlinq
 		return internal::build(obj, builder);
 	}
 
+	/**
+	*	Nice syntax operator for executing parallel xlinq command.
+	*	@param obj The parallel query object.
+	*	@param builder The expression builder object. It should have build method
+	*	accepting parallel queries defined.
+	*/
+	template<typename TQuery, typename TBuilder>
+	auto operator>>(const ParallelEnumerable<TQuery>& obj, TBuilder builder) -> decltype(builder.build(obj))
+	{
+		return builder.build(obj);
+	}
+
 	/**
 	*	Function extracting enumerator from enumerable.
 	*	@return Builder of getEnumerator expression.
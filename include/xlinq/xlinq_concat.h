@@ -33,6 +33,7 @@ SOFTWARE.
 #include <cassert>
 #include "xlinq_base.h"
 #include "xlinq_from.h"
+#include "xlinq_static.h"
 
 namespace xlinq
 {
@@ -67,6 +68,11 @@ namespace xlinq
 				return _firstFinished ? _second->current() : _first->current();
 			}
 
+			const TElem* current_ptr() override
+			{
+				return _firstFinished ? _second->current_ptr() : _first->current_ptr();
+			}
+
 			bool equals(std::shared_ptr<IEnumerator<TElem>> other) const override
 			{
 				auto pother = std::dynamic_pointer_cast<ConcatEnumerator<TElem>>(other);
@@ -124,6 +130,11 @@ namespace xlinq
 				return _firstFinished ? _second->current() : _first->current();
 			}
 
+			const TElem* current_ptr() override
+			{
+				return _firstFinished ? _second->current_ptr() : _first->current_ptr();
+			}
+
 			bool equals(std::shared_ptr<IEnumerator<TElem>> other) const override
 			{
 				auto pother = std::dynamic_pointer_cast<ConcatBidirectionalEnumerator<TElem>>(other);
@@ -240,6 +251,11 @@ namespace xlinq
 				return _index < _firstSize ? _first->current() : _second->current();
 			}
 
+			const TElem* current_ptr() override
+			{
+				return _index < _firstSize ? _first->current_ptr() : _second->current_ptr();
+			}
+
 			bool equals(std::shared_ptr<IEnumerator<TElem>> other) const override
 			{
 				auto pother = std::dynamic_pointer_cast<ConcatRandomAccessEnumerator<TElem>>(other);
@@ -296,6 +312,13 @@ namespace xlinq
 			ConcatEnumerable(std::shared_ptr<IEnumerable<TElem>> first, std::shared_ptr<IEnumerable<TElem>> second)
 				: _first(first), _second(second) {}
 
+			int known_size() override
+			{
+				int first = _first->known_size();
+				int second = _second->known_size();
+				return first < 0 || second < 0 ? -1 : first + second;
+			}
+
 			std::shared_ptr<IEnumerator<TElem>> createEnumerator() override
 			{
 				return std::shared_ptr<IEnumerator<TElem>>(new ConcatEnumerator<TElem>(_first->getEnumerator(), _second->getEnumerator()));
@@ -313,6 +336,13 @@ namespace xlinq
 			ConcatBidirectionalEnumerable(std::shared_ptr<IBidirectionalEnumerable<TElem>> first, std::shared_ptr<IBidirectionalEnumerable<TElem>> second)
 				: _first(first), _second(second) {}
 
+			int known_size() override
+			{
+				int first = _first->known_size();
+				int second = _second->known_size();
+				return first < 0 || second < 0 ? -1 : first + second;
+			}
+
 			std::shared_ptr<IEnumerator<TElem>> createEnumerator() override
 			{
 				return std::shared_ptr<IEnumerator<TElem>>(new ConcatBidirectionalEnumerator<TElem>(_first->getEnumerator(), _second->getEnumerator(), false));
@@ -435,6 +465,73 @@ namespace xlinq
 			}
 		};
 
+		template<typename TFirstEnumerator, typename TSecondEnumerator, typename TElem>
+		class _StaticConcatEnumerator
+		{
+		private:
+			TFirstEnumerator _first;
+			TSecondEnumerator _second;
+			bool _firstFinished;
+
+		public:
+			_StaticConcatEnumerator(TFirstEnumerator first, TSecondEnumerator second)
+				: _first(first), _second(second), _firstFinished(false) {}
+
+			bool next()
+			{
+				if (!_firstFinished)
+				{
+					if (_first.next())
+						return true;
+					_firstFinished = true;
+				}
+				return _second.next();
+			}
+
+			TElem current()
+			{
+				return _firstFinished ? _second.current() : _first.current();
+			}
+		};
+
+		template<typename TFirst, typename TSecond>
+		class _StaticConcatEnumerable : public StaticEnumerable<_StaticConcatEnumerable<TFirst, TSecond>>
+		{
+		private:
+			TFirst _first;
+			TSecond _second;
+
+		public:
+			static_assert(std::is_same<typename TFirst::ElemType, typename TSecond::ElemType>::value, "Concatenated enumerables must have the same element type");
+
+			typedef typename TFirst::ElemType ElemType;
+			typedef _StaticConcatEnumerator<typename TFirst::Enumerator, typename TSecond::Enumerator, ElemType> Enumerator;
+
+			_StaticConcatEnumerable(const TFirst& first, const TSecond& second)
+				: _first(first), _second(second) {}
+
+			Enumerator getEnumerator() const
+			{
+				return Enumerator(_first.getEnumerator(), _second.getEnumerator());
+			}
+		};
+
+		template<typename TSecond>
+		class _StaticConcatBuilder
+		{
+		private:
+			TSecond _second;
+
+		public:
+			_StaticConcatBuilder(const TSecond& second) : _second(second) {}
+
+			template<typename TFirst>
+			_StaticConcatEnumerable<TFirst, TSecond> build(const StaticEnumerable<TFirst>& enumerable)
+			{
+				return _StaticConcatEnumerable<TFirst, TSecond>(enumerable.derived(), _second);
+			}
+		};
+
 		template<typename TEnumerable, typename TElem>
 		struct ConcatBuilderSelectorHelper
 		{
@@ -520,6 +617,17 @@ namespace xlinq
 	{
 		return typename internal::ConcatBuilderSelectorHelper<decltype(from(enumerable)), typename TEnumerable::ElemType>::builder(from(enumerable));
 	}
+
+	/**
+	*	Function concatenating two static enumerables into single static enumerable.
+	*	@param enumerable Static enumerable which will be concatenated.
+	*	@return Builder of static concat expression.
+	*/
+	template<typename TSecond>
+	XLINQ_INLINE internal::_StaticConcatBuilder<TSecond> concat(const StaticEnumerable<TSecond>& enumerable)
+	{
+		return internal::_StaticConcatBuilder<TSecond>(enumerable.derived());
+	}
 }
 
 #endif
\ No newline at end of file
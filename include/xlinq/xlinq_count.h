@@ -30,6 +30,7 @@ SOFTWARE.
 #define XLINQ_COUNT_H_
 
 #include "xlinq_base.h"
+#include "xlinq_static.h"
 
 namespace xlinq
 {
@@ -42,19 +43,20 @@ namespace xlinq
 			template<typename TElem>
 			int build(std::shared_ptr<IEnumerable<TElem>> enumerable)
 			{
-				int count = 0;
-				for (auto it = enumerable->getEnumerator(); it->next();)
-					++count;
+				int count = enumerable->known_size();
+				if (count >= 0)
+					return count;
+				count = 0;
+				_BatchReader<TElem> reader(enumerable->getEnumerator());
+				while (reader.read())
+					count += reader.size();
 				return count;
 			}
 
 			template<typename TElem>
 			int build(std::shared_ptr<IBidirectionalEnumerable<TElem>> enumerable)
 			{
-				int count = 0;
-				for (auto it = enumerable->getEnumerator(); it->next();)
-					++count;
-				return count;
+				return build((std::shared_ptr<IEnumerable<TElem>>)enumerable);
 			}
 
 			template<typename TElem>
@@ -62,6 +64,22 @@ namespace xlinq
 			{
 				return enumerable->size();
 			}
+
+			template<typename TSource>
+			int build(const StaticEnumerable<TSource>& enumerable)
+			{
+				auto en = enumerable.derived().getEnumerator();
+				int count = 0;
+				while (en.next())
+					++count;
+				return count;
+			}
+
+			template<typename TQuery>
+			auto build(const ParallelEnumerable<TQuery>& enumerable) -> decltype(enumerable.derived().count())
+			{
+				return enumerable.derived().count();
+			}
 		};
 	}
 	/*@endcond*/
@@ -70,7 +88,9 @@ namespace xlinq
 	/**
 	*	Returns number of elements in collection.
 	*	This function may be used to count number of elements in collection.
-	*	It does not count elements if the collection implements IRandomAccessEnumerable interface.
+	*	It does not count elements if the collection knows its size, which is the case for
+	*	IRandomAccessEnumerable and for select, take, skip, reverse and concat of such collections.
+	*	Other collections are counted in batches of XLINQ_BATCH_SIZE elements.
 	*	@return Builder of first expression.
 	*/
 	XLINQ_INLINE internal::_CountBuilder count()
@@ -40,6 +40,71 @@ SOFTWARE.
 */
 #define XLINQ_ABSTRACT = 0
 
+/**
+*	Defines number of elements fetched at once by batched operations.
+*	It may be overriden before including xlinq headers.
+*/
+#ifndef XLINQ_BATCH_SIZE
+#define XLINQ_BATCH_SIZE 256
+#endif
+
+/**
+*	Defines minimal number of elements processed by single task of parallel query.
+*	It may be overriden before including xlinq headers.
+*/
+#ifndef XLINQ_PARALLEL_CHUNK_SIZE
+#define XLINQ_PARALLEL_CHUNK_SIZE 4096
+#endif
+
+/**
+*	Defines number of threads executing parallel queries including calling thread.
+*	Value 0 means number of hardware threads. It may be overriden before including xlinq headers.
+*/
+#ifndef XLINQ_PARALLEL_THREADS
+#define XLINQ_PARALLEL_THREADS 0
+#endif
+
+/**
+*	Defines minimal number of elements sorted with radix sort instead of comparison sort.
+*	It may be overriden before including xlinq headers.
+*/
+#ifndef XLINQ_RADIX_SORT_MIN_SIZE
+#define XLINQ_RADIX_SORT_MIN_SIZE 256
+#endif
+
+/**
+*	Defines maximal number of temporary files merged at once by external_sort.
+*	More runs are merged in several passes. It may be overriden before including xlinq headers.
+*/
+#ifndef XLINQ_EXTERNAL_SORT_MERGE_WAYS
+#define XLINQ_EXTERNAL_SORT_MERGE_WAYS 64
+#endif
+
+/**
+*	Defines number of elements of smaller collection put into single partition by partitioned join.
+*	It may be overriden before including xlinq headers.
+*/
+#ifndef XLINQ_JOIN_PARTITION_SIZE
+#define XLINQ_JOIN_PARTITION_SIZE 8192
+#endif
+
+/**
+*	Defines minimal number of distinct keys for which semi_join and anti_join use Bloom filter.
+*	It may be overriden before including xlinq headers.
+*/
+#ifndef XLINQ_SEMI_JOIN_BLOOM_MIN_SIZE
+#define XLINQ_SEMI_JOIN_BLOOM_MIN_SIZE 16384
+#endif
+
+/**
+*	Defines whether SSE2 and AVX2 code paths may be used.
+*	When set to 0, reductions and hash sets use portable scalar code.
+*	It may be overriden before including xlinq headers.
+*/
+#ifndef XLINQ_SIMD
+#define XLINQ_SIMD 1
+#endif
+
 namespace xlinq
 {
 	/**
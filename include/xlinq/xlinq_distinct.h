@@ -30,11 +30,11 @@ SOFTWARE.
 #define XLINQ_DISTINCT_H_
 
 #include <memory>
-#include <unordered_set>
 #include <unordered_map>
 #include <list>
 #include "xlinq_base.h"
 #include "xlinq_from.h"
+#include "xlinq_hash_set.h"
 
 namespace xlinq
 {
@@ -44,16 +44,16 @@ namespace xlinq
 		template<typename TElem, typename THasher, typename TEqComp>
 		class _DistinctEnumerator : public IEnumerator<TElem>
 		{
-			std::unordered_set<TElem, THasher, TEqComp> _set;
+			FlatHashSet<TElem, THasher, TEqComp> _set;
 			std::shared_ptr<IEnumerator<TElem>> _source;
 		public:
-			_DistinctEnumerator(const std::unordered_set<TElem, THasher, TEqComp>& set, std::shared_ptr<IEnumerator<TElem>> source)
+			_DistinctEnumerator(const FlatHashSet<TElem, THasher, TEqComp>& set, std::shared_ptr<IEnumerator<TElem>> source)
 				: _set(set), _source(source) {}
 
 			bool next() override
 			{
 				while (_source->next())
-					if (_set.insert(_source->current()).second)
+					if (_set.insert(_source->current()))
 						return true;
 				return false;
 			}
@@ -81,7 +81,6 @@ namespace xlinq
 		template<typename TElem, typename THasher, typename TEqComp>
 		class _DistinctEnumerable : public IEnumerable<TElem>
 		{
-			const int default_buckets = 8;
 			THasher _hasher;
 			TEqComp _eqComp;
 			std::shared_ptr<IEnumerable<TElem>> _source;
@@ -91,7 +90,7 @@ namespace xlinq
 
 			std::shared_ptr<IEnumerator<TElem>> createEnumerator() override
 			{
-				return std::shared_ptr<IEnumerator<TElem>>(new _DistinctEnumerator<TElem, THasher, TEqComp>(std::unordered_set<TElem, THasher, TEqComp>(default_buckets, _hasher, _eqComp), _source->getEnumerator()));
+				return std::shared_ptr<IEnumerator<TElem>>(new _DistinctEnumerator<TElem, THasher, TEqComp>(FlatHashSet<TElem, THasher, TEqComp>(_hasher, _eqComp, size_hint(_source)), _source->getEnumerator()));
 			}
 		};
 
@@ -178,16 +177,16 @@ namespace xlinq
 		class _DistinctByEnumerator : public IEnumerator<TElem>
 		{
 			TSelector _selector;
-			std::unordered_set<TSelect, THasher, TEqComp> _set;
+			FlatHashSet<TSelect, THasher, TEqComp> _set;
 			std::shared_ptr<IEnumerator<TElem>> _source;
 		public:
-			_DistinctByEnumerator(TSelector selector, const std::unordered_set<TSelect, THasher, TEqComp>& set, std::shared_ptr<IEnumerator<TElem>> source)
+			_DistinctByEnumerator(TSelector selector, const FlatHashSet<TSelect, THasher, TEqComp>& set, std::shared_ptr<IEnumerator<TElem>> source)
 				: _selector(selector), _set(set), _source(source) {}
 
 			bool next() override
 			{
 				while (_source->next())
-					if (_set.insert(_selector(_source->current())).second)
+					if (_set.insert(_selector(_source->current())))
 						return true;
 				return false;
 			}
@@ -215,7 +214,6 @@ namespace xlinq
 		template<typename TSelector, typename TSelect, typename TElem, typename THasher, typename TEqComp>
 		class _DistinctByEnumerable : public IEnumerable<TElem>
 		{
-			const int default_buckets = 8;
 			TSelector _selector;
 			THasher _hasher;
 			TEqComp _eqComp;
@@ -226,7 +224,7 @@ namespace xlinq
 
 			std::shared_ptr<IEnumerator<TElem>> createEnumerator() override
 			{
-				return std::shared_ptr<IEnumerator<TElem>>(new _DistinctByEnumerator<TSelector, TSelect, TElem, THasher, TEqComp>(_selector, std::unordered_set<TSelect, THasher, TEqComp>(default_buckets, _hasher, _eqComp), _source->getEnumerator()));
+				return std::shared_ptr<IEnumerator<TElem>>(new _DistinctByEnumerator<TSelector, TSelect, TElem, THasher, TEqComp>(_selector, FlatHashSet<TSelect, THasher, TEqComp>(_hasher, _eqComp, size_hint(_source)), _source->getEnumerator()));
 			}
 		};
 
@@ -45,6 +45,9 @@ namespace xlinq
 			template<typename TElem>
 			TElem build(std::shared_ptr<IEnumerable<TElem>> enumerable)
 			{
+				int size = enumerable->known_size();
+				if (size >= 0 && _index >= size)
+					throw IterationFinishedException();
 				auto enumerator = enumerable->getEnumerator();
 				for (int i = 0; i <= _index; i++)
 					enumerator->next();
@@ -54,10 +57,7 @@ namespace xlinq
 			template<typename TElem>
 			TElem build(std::shared_ptr<IBidirectionalEnumerable<TElem>> enumerable)
 			{
-				auto enumerator = enumerable->getEnumerator();
-				for (int i = 0; i <= _index; i++)
-					enumerator->next();
-				return enumerator->current();
+				return build((std::shared_ptr<IEnumerable<TElem>>)enumerable);
 			}
 
 			template<typename TElem>
@@ -78,7 +78,8 @@ namespace xlinq
 			template<typename TElem>
 			TElem build(std::shared_ptr<IEnumerable<TElem>> enumerable)
 			{
-				if (_index < 0)
+				int size = enumerable->known_size();
+				if (_index < 0 || (size >= 0 && _index >= size))
 					return (TElem)_default;
 				auto enumerator = enumerable->getEnumerator();
 				for (int i = 0; i <= _index; i++)
@@ -89,12 +90,7 @@ namespace xlinq
 			template<typename TElem>
 			TElem build(std::shared_ptr<IBidirectionalEnumerable<TElem>> enumerable)
 			{
-				if (_index < 0)
-					return (TElem)_default;
-				auto enumerator = enumerable->getEnumerator();
-				for (int i = 0; i <= _index; i++)
-					if (!enumerator->next()) return (TElem)_default;
-				return enumerator->current();
+				return build((std::shared_ptr<IEnumerable<TElem>>)enumerable);
 			}
 
 			template<typename TElem>
@@ -29,6 +29,8 @@ SOFTWARE.
 #ifndef XLINQ_ENUMERABLE_H_
 #define XLINQ_ENUMERABLE_H_
 
+#include <limits>
+#include <type_traits>
 #include <vector>
 #include "xlinq_base.h"
 #include "xlinq_from.h"
@@ -91,6 +93,11 @@ namespace xlinq
 			{
 				return std::shared_ptr<IBidirectionalEnumerator<TElem>>(new EmptyEnumerator<TElem>(true));
 			}
+		public:
+			int known_size() override
+			{
+				return 0;
+			}
 		};
 
 		template<typename TElem>
@@ -186,6 +193,11 @@ namespace xlinq
 		public:
 			RepeatEnumerable(TElem element, int size) : InfiniteRepeatEnumerable<TElem>(element), _size(size) {}
 
+			int known_size() override
+			{
+				return _size > 0 ? _size : 0;
+			}
+
 			std::shared_ptr<IEnumerator<TElem>> createEnumerator() override
 			{
 				return std::shared_ptr<IEnumerator<TElem>>(new RepeatEnumerator<TElem>(this->shared_from_this(), _size));
@@ -243,8 +255,30 @@ namespace xlinq
 			TElem _lower;
 			TElem _upper;
 			int _size;
+
+			template<typename TBound>
+			static int range_size(TBound lower, TBound upper, std::true_type)
+			{
+				if (!(lower < upper) || (unsigned long long)upper - (unsigned long long)lower > (unsigned long long)std::numeric_limits<int>::max())
+					return -1;
+				return (int)((unsigned long long)upper - (unsigned long long)lower);
+			}
+
+			template<typename TBound>
+			static int range_size(TBound, TBound, std::false_type)
+			{
+				return -1;
+			}
 		public:
-			RangeEnumerable(TElem lower, TElem upper) : _lower(lower), _upper(upper) {}
+			RangeEnumerable(TElem lower, TElem upper) : _lower(lower), _upper(upper)
+			{
+				_size = range_size(lower, upper, std::is_integral<TElem>());
+			}
+
+			int known_size() override
+			{
+				return _size;
+			}
 
 			std::shared_ptr<IEnumerator<TElem>> createEnumerator() override
 			{
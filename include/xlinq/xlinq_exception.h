@@ -129,6 +129,21 @@ namespace xlinq
 		*/
 		KeyNotFoundException() : Exception("The specified key was not found") {}
 	};
+
+	/**
+	*	Error indicating that elements could not be spilled to temporary storage.
+	*	This error is thrown when operation exceeding its memory budget is not able
+	*	to create, write or read temporary file holding its elements.
+	*/
+	class SpillFailedException : public Exception
+	{
+	public:
+		/**
+		*	Constructor.
+		*	Creates new instance of SpillFailedException with default error message.
+		*/
+		SpillFailedException() : Exception("Temporary storage of spilled elements could not be accessed.") {}
+	};
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,348 @@
+/*
+MIT License
+
+Copyright (c) 2017 TrolleY
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+*	@file xlinq_external_sort.h
+*	Sorting collections exceeding memory budget.
+*	@author TrolleY
+*/
+#ifndef XLINQ_EXTERNAL_SORT_H_
+#define XLINQ_EXTERNAL_SORT_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include "xlinq_base.h"
+#include "xlinq_exception.h"
+#include "xlinq_from.h"
+#include "xlinq_sort.h"
+#include "xlinq_spill.h"
+
+namespace xlinq
+{
+	/*@cond XLINQ_INTERNAL*/
+	namespace internal
+	{
+		template<typename TElem, typename TComparer, typename TSerializer>
+		class _ExternalMergeEnumerator : public IEnumerator<TElem>
+		{
+			typedef std::pair<TElem, int> Head;
+
+			class HeadComparer
+			{
+			public:
+				TComparer comparer;
+
+				HeadComparer(TComparer comparer) : comparer(comparer) {}
+
+				bool operator()(const Head& first, const Head& second)
+				{
+					if (comparer(second.first, first.first)) return true;
+					if (comparer(first.first, second.first)) return false;
+					return first.second > second.second;
+				}
+			};
+
+			std::shared_ptr<std::vector<std::shared_ptr<_SpillFile>>> _runs;
+			std::vector<long long> _offsets;
+			std::vector<Head> _heap;
+			HeadComparer _comparer;
+			TSerializer _serializer;
+			TElem _current;
+			bool _started, _finished;
+
+			bool read(int run, TElem& elem)
+			{
+				return (*_runs)[run]->read(_offsets[run], elem, _serializer);
+			}
+
+		public:
+			_ExternalMergeEnumerator(std::shared_ptr<std::vector<std::shared_ptr<_SpillFile>>> runs, TComparer comparer, TSerializer serializer)
+				: _runs(runs), _offsets(runs->size(), 0), _comparer(comparer), _serializer(serializer), _started(false), _finished(false) {}
+
+			bool next() override
+			{
+				if (!_started)
+				{
+					_started = true;
+					_heap.reserve(_runs->size());
+					for (int run = 0; run < (int)_runs->size(); ++run)
+					{
+						Head head(TElem(), run);
+						if (read(run, head.first))
+							_heap.push_back(std::move(head));
+					}
+					std::make_heap(_heap.begin(), _heap.end(), _comparer);
+				}
+				if (_heap.empty())
+				{
+					_finished = true;
+					return false;
+				}
+				std::pop_heap(_heap.begin(), _heap.end(), _comparer);
+				Head& head = _heap.back();
+				_current = std::move(head.first);
+				if (read(head.second, head.first))
+					std::push_heap(_heap.begin(), _heap.end(), _comparer);
+				else _heap.pop_back();
+				return true;
+			}
+
+			TElem current() override
+			{
+				if (!_started)
+					throw IterationNotStartedException();
+				if (_finished)
+					throw IterationFinishedException();
+				return _current;
+			}
+
+			const TElem* current_ptr() override
+			{
+				return _started && !_finished ? &_current : nullptr;
+			}
+
+			bool equals(std::shared_ptr<IEnumerator<TElem>> other) const override
+			{
+				auto pother = std::dynamic_pointer_cast<_ExternalMergeEnumerator<TElem, TComparer, TSerializer>>(other);
+				if (!pother)
+					return false;
+				return this->_runs == pother->_runs &&
+					this->_started == pother->_started &&
+					this->_finished == pother->_finished &&
+					this->_offsets == pother->_offsets;
+			}
+
+			std::shared_ptr<IEnumerator<TElem>> clone() const override
+			{
+				return std::shared_ptr<IEnumerator<TElem>>(new _ExternalMergeEnumerator<TElem, TComparer, TSerializer>(*this));
+			}
+		};
+
+		template<typename TElem, typename TComparer, typename TSerializer>
+		class _ExternalSortEnumerable : public IEnumerable<TElem>
+		{
+			std::shared_ptr<IEnumerable<TElem>> _source;
+			int _memoryBudget;
+			TComparer _comparer;
+			TSerializer _serializer;
+			std::mutex _mutex;
+			std::shared_ptr<std::vector<TElem>> _sorted;
+			std::shared_ptr<std::vector<std::shared_ptr<_SpillFile>>> _runs;
+
+			std::shared_ptr<_SpillFile> merge_runs(std::vector<std::shared_ptr<_SpillFile>>& runs, std::size_t first)
+			{
+				auto merged = std::make_shared<std::vector<std::shared_ptr<_SpillFile>>>(runs.begin() + first, runs.end());
+				runs.resize(first);
+				_ExternalMergeEnumerator<TElem, TComparer, TSerializer> merge(merged, _comparer, _serializer);
+				auto run = std::make_shared<_SpillFile>();
+				while (merge.next())
+					run->write(*merge.current_ptr(), _serializer);
+				run->finish();
+				return run;
+			}
+
+			void sort_source()
+			{
+				auto source = _source->getEnumerator();
+				auto runs = std::make_shared<std::vector<std::shared_ptr<_SpillFile>>>();
+				std::vector<int> levels;
+				std::size_t ways = std::max(XLINQ_EXTERNAL_SORT_MERGE_WAYS, 2);
+				std::vector<TElem> chunk;
+				while (true)
+				{
+					chunk.clear();
+					bool finished = source->next_batch(chunk, _memoryBudget) < _memoryBudget;
+					sort_elements(chunk, _comparer);
+					if (finished && runs->empty())
+					{
+						_sorted = std::make_shared<std::vector<TElem>>(std::move(chunk));
+						return;
+					}
+					if (!chunk.empty())
+					{
+						auto run = std::make_shared<_SpillFile>();
+						for (auto& elem : chunk)
+							run->write(elem, _serializer);
+						run->finish();
+						runs->push_back(run);
+						levels.push_back(0);
+						while (levels.size() >= ways && levels[levels.size() - ways] == levels.back())
+						{
+							int level = levels.back() + 1;
+							levels.resize(levels.size() - ways);
+							runs->push_back(merge_runs(*runs, runs->size() - ways));
+							levels.push_back(level);
+						}
+					}
+					if (finished)
+					{
+						while (runs->size() > ways)
+						{
+							std::size_t merged = std::min(ways, runs->size() - ways + 1);
+							runs->push_back(merge_runs(*runs, runs->size() - merged));
+						}
+						_runs = runs;
+						return;
+					}
+				}
+			}
+
+		public:
+			_ExternalSortEnumerable(std::shared_ptr<IEnumerable<TElem>> source, int memoryBudget, TComparer comparer, TSerializer serializer)
+				: _source(source), _memoryBudget(std::max(memoryBudget, 1)), _comparer(comparer), _serializer(serializer) {}
+
+			std::shared_ptr<IEnumerator<TElem>> createEnumerator() override
+			{
+				{
+					std::lock_guard<std::mutex> lock(_mutex);
+					if (_source)
+					{
+						sort_source();
+						_source = nullptr;
+					}
+				}
+				if (_sorted)
+					return from(_sorted)->getEnumerator();
+				return std::shared_ptr<IEnumerator<TElem>>(new _ExternalMergeEnumerator<TElem, TComparer, TSerializer>(_runs, _comparer, _serializer));
+			}
+		};
+
+		template<typename TComparer, typename TSerializer>
+		class _ExternalSortBuilder
+		{
+			int _memoryBudget;
+			TComparer _comparer;
+			TSerializer _serializer;
+
+		public:
+			_ExternalSortBuilder(int memoryBudget, TComparer comparer, TSerializer serializer)
+				: _memoryBudget(memoryBudget), _comparer(comparer), _serializer(serializer) {}
+
+			template<typename TElem>
+			std::shared_ptr<IEnumerable<TElem>> build(std::shared_ptr<IEnumerable<TElem>> enumerable)
+			{
+				return std::shared_ptr<IEnumerable<TElem>>(new _ExternalSortEnumerable<TElem, TComparer, TSerializer>(enumerable, _memoryBudget, _comparer, _serializer));
+			}
+
+			template<typename TElem>
+			std::shared_ptr<IEnumerable<TElem>> build(std::shared_ptr<IBidirectionalEnumerable<TElem>> enumerable)
+			{
+				return build((std::shared_ptr<IEnumerable<TElem>>)enumerable);
+			}
+
+			template<typename TElem>
+			std::shared_ptr<IEnumerable<TElem>> build(std::shared_ptr<IRandomAccessEnumerable<TElem>> enumerable)
+			{
+				return build((std::shared_ptr<IEnumerable<TElem>>)enumerable);
+			}
+		};
+
+		class _ExternalSortBuilderDefault
+		{
+			int _memoryBudget;
+
+		public:
+			_ExternalSortBuilderDefault(int memoryBudget) : _memoryBudget(memoryBudget) {}
+
+			template<typename TElem>
+			std::shared_ptr<IEnumerable<TElem>> build(std::shared_ptr<IEnumerable<TElem>> enumerable)
+			{
+				return _ExternalSortBuilder<std::less<TElem>, _BinarySerializer>(_memoryBudget, std::less<TElem>(), _BinarySerializer()).build(enumerable);
+			}
+
+			template<typename TElem>
+			std::shared_ptr<IEnumerable<TElem>> build(std::shared_ptr<IBidirectionalEnumerable<TElem>> enumerable)
+			{
+				return build((std::shared_ptr<IEnumerable<TElem>>)enumerable);
+			}
+
+			template<typename TElem>
+			std::shared_ptr<IEnumerable<TElem>> build(std::shared_ptr<IRandomAccessEnumerable<TElem>> enumerable)
+			{
+				return build((std::shared_ptr<IEnumerable<TElem>>)enumerable);
+			}
+		};
+	}
+	/*@endcond*/
+
+	/**
+	*	Performs stable sort on collection not fitting into memory.
+	*	This function may be used to sort collections which are too big to be
+	*	sorted by sort. Source is read in chunks of at most memoryBudget elements,
+	*	each of them is sorted and written to temporary file as separate run. Runs
+	*	are lazily merged during enumeration, so only one element of each run is held
+	*	in memory. Whenever XLINQ_EXTERNAL_SORT_MERGE_WAYS runs of the same size are
+	*	written, they are merged into one bigger run, so number of open temporary
+	*	files grows only logarithmically with size of source. If source fits into
+	*	memory budget, no files are created. Source is read and sorted on first
+	*	enumeration only. Sorted runs are kept until expression is destroyed, and
+	*	further enumerators just merge them again. Elements have to be trivially
+	*	copyable, as they are written to files byte by byte.
+	*	@param memoryBudget Maximal number of elements held in memory while sorting.
+	*	@return Builder of external_sort expression.
+	*/
+	XLINQ_INLINE internal::_ExternalSortBuilderDefault external_sort(int memoryBudget)
+	{
+		return internal::_ExternalSortBuilderDefault(memoryBudget);
+	}
+
+	/**
+	*	Performs stable sort on collection not fitting into memory.
+	*	This function works as external_sort(int), but compares elements with
+	*	given comparer.
+	*	@param memoryBudget Maximal number of elements held in memory while sorting.
+	*	@param comparer Functor returning true if first element goes before second one.
+	*	@return Builder of external_sort expression.
+	*/
+	template<typename TComparer>
+	XLINQ_INLINE internal::_ExternalSortBuilder<TComparer, internal::_BinarySerializer> external_sort(int memoryBudget, TComparer comparer)
+	{
+		return internal::_ExternalSortBuilder<TComparer, internal::_BinarySerializer>(memoryBudget, comparer, internal::_BinarySerializer());
+	}
+
+	/**
+	*	Performs stable sort on collection not fitting into memory.
+	*	This function works as external_sort(int, TComparer), but writes elements
+	*	to temporary files with given serializer. Serializer has to provide
+	*	void write(std::FILE*, const TElem&) method and bool read(std::FILE*, TElem&)
+	*	method reading element written by former one, which returns false on failure.
+	*	Elements have to be default constructible.
+	*	@param memoryBudget Maximal number of elements held in memory while sorting.
+	*	@param comparer Functor returning true if first element goes before second one.
+	*	@param serializer Functor writing and reading elements from temporary files.
+	*	@return Builder of external_sort expression.
+	*/
+	template<typename TComparer, typename TSerializer>
+	XLINQ_INLINE internal::_ExternalSortBuilder<TComparer, TSerializer> external_sort(int memoryBudget, TComparer comparer, TSerializer serializer)
+	{
+		return internal::_ExternalSortBuilder<TComparer, TSerializer>(memoryBudget, comparer, serializer);
+	}
+}
+
+#endif
\ No newline at end of file
@@ -30,6 +30,7 @@ SOFTWARE.
 #define XLINQ_FIRST_H_
 
 #include "xlinq_base.h"
+#include "xlinq_static.h"
 #include "xlinq_where.h"
 
 namespace xlinq
@@ -59,10 +60,22 @@ namespace xlinq
 			template<typename TElem>
 			TElem build(std::shared_ptr<IRandomAccessEnumerable<TElem>> enumerable)
 			{
+				auto sorted = std::dynamic_pointer_cast<_SortedFrontSource<TElem>>(enumerable);
+				if (sorted)
+					enumerable = sorted->sorted_front(1);
 				auto enumerator = enumerable->getEnumerator();
 				enumerator->next();
 				return enumerator->current();
 			}
+
+			template<typename TSource>
+			typename TSource::ElemType build(const StaticEnumerable<TSource>& enumerable)
+			{
+				auto enumerator = enumerable.derived().getEnumerator();
+				if (!enumerator.next())
+					throw IterationFinishedException();
+				return enumerator.current();
+			}
 		};
 
 		template<typename TPredicate>
@@ -95,6 +108,15 @@ namespace xlinq
 				enumerator->next();
 				return enumerator->current();
 			}
+
+			template<typename TSource>
+			typename TSource::ElemType build(const StaticEnumerable<TSource>& enumerable)
+			{
+				auto enumerator = (enumerable >> where(_predicate)).getEnumerator();
+				if (!enumerator.next())
+					throw IterationFinishedException();
+				return enumerator.current();
+			}
 		};
 
 		template<typename TElem>
@@ -118,9 +140,19 @@ namespace xlinq
 
 			TElem build(std::shared_ptr<IRandomAccessEnumerable<TElem>> enumerable)
 			{
+				auto sorted = std::dynamic_pointer_cast<_SortedFrontSource<TElem>>(enumerable);
+				if (sorted)
+					enumerable = sorted->sorted_front(1);
 				auto enumerator = enumerable->getEnumerator();
 				return enumerator->next() ? enumerator->current() : _default;
 			}
+
+			template<typename TSource>
+			TElem build(const StaticEnumerable<TSource>& enumerable)
+			{
+				auto enumerator = enumerable.derived().getEnumerator();
+				return enumerator.next() ? enumerator.current() : _default;
+			}
 		};
 
 		template<typename TElem, typename TPredicate>
@@ -148,6 +180,13 @@ namespace xlinq
 				auto enumerator = (enumerable >> where(_predicate))->getEnumerator();
 				return enumerator->next() ? enumerator->current() : _default;
 			}
+
+			template<typename TSource>
+			TElem build(const StaticEnumerable<TSource>& enumerable)
+			{
+				auto enumerator = (enumerable >> where(_predicate)).getEnumerator();
+				return enumerator.next() ? enumerator.current() : _default;
+			}
 		};
 	}
 	/*@endcond*/
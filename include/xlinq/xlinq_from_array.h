@@ -33,6 +33,7 @@ SOFTWARE.
 #include <memory>
 #include <cassert>
 #include <type_traits>
+#include <vector>
 #include "xlinq_base.h"
 #include "xlinq_exception.h"
 
@@ -142,6 +143,26 @@ namespace xlinq
 				return *(_begin + _index);
 			}
 
+			const TElem* current_ptr() override
+			{
+				assert_started();
+				assert_finished();
+				return _begin + _index;
+			}
+
+			int next_batch(std::vector<TElem>& buffer, int count) override
+			{
+				assert(count > 0);
+				assert_finished();
+				auto first = _started ? _index + 1 : _index;
+				auto fetched = _size - first < count ? _size - first : count;
+				for (auto ptr = _begin + first, end = ptr + fetched; ptr != end; ++ptr)
+					buffer.push_back(*ptr);
+				_started = true;
+				_index = fetched < count ? _size : first + fetched - 1;
+				return fetched;
+			}
+
 			bool equals(std::shared_ptr<IEnumerator<TElem>> other) const override
 			{
 				auto pother = std::dynamic_pointer_cast<_ArrayEnumerator<TElem>>(other);
@@ -226,6 +247,11 @@ namespace xlinq
 			{
 				return _size;
 			}
+
+			const TElem* data() override
+			{
+				return _array;
+			}
 		};
 
 		template<typename TElem, int SIZE>
@@ -325,6 +351,26 @@ namespace xlinq
 				return _array[_index];
 			}
 
+			const TElem* current_ptr() override
+			{
+				assert_started();
+				assert_finished();
+				return &_array[_index];
+			}
+
+			int next_batch(std::vector<TElem>& buffer, int count) override
+			{
+				assert(count > 0);
+				assert_finished();
+				auto first = _started ? _index + 1 : _index;
+				auto fetched = SIZE - first < count ? SIZE - first : count;
+				for (auto i = first; i < first + fetched; ++i)
+					buffer.push_back(_array[i]);
+				_started = true;
+				_index = fetched < count ? SIZE : first + fetched - 1;
+				return fetched;
+			}
+
 			bool equals(std::shared_ptr<IEnumerator<TElem>> other) const override
 			{
 				auto pother = std::dynamic_pointer_cast<_StdArrayEnumerator<TElem, SIZE>>(other);
@@ -407,6 +453,11 @@ namespace xlinq
 			{
 				return SIZE;
 			}
+
+			const TElem* data() override
+			{
+				return _array.data();
+			}
 		};
 
 		template<typename TArray, typename TElem>
@@ -542,6 +593,13 @@ namespace xlinq
 				assert_finished();
 				return _currentEnumerator->current();
 			}
+
+			const TElem* current_ptr() override
+			{
+				assert_started();
+				assert_finished();
+				return _currentEnumerator->current_ptr();
+			}
 			/*TArray* _begin;
 			int _size;
 			int _index;
@@ -650,6 +708,11 @@ namespace xlinq
 			{
 				return _size * array_size<TArray>::value;
 			}
+
+			const TElem* data() override
+			{
+				return reinterpret_cast<const TElem*>(_array);
+			}
 		};
 
 		template<typename TArray, int SIZE, bool elemIsArray, typename TElem>
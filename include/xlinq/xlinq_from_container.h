@@ -33,6 +33,10 @@ SOFTWARE.
 #include <memory>
 #include <iterator>
 #include <cassert>
+#include <type_traits>
+#include <array>
+#include <vector>
+#include <string>
 #include "xlinq_base.h"
 #include "xlinq_exception.h"
 
@@ -41,6 +45,59 @@ namespace xlinq
 	/*@cond XLINQ_INTERNAL*/
 	namespace internal
 	{
+		template<typename TContainer>
+		struct is_contiguous_container : public std::false_type {};
+
+		template<typename TElem, typename TAllocator>
+		struct is_contiguous_container<std::vector<TElem, TAllocator>> : public std::true_type {};
+
+		template<typename TAllocator>
+		struct is_contiguous_container<std::vector<bool, TAllocator>> : public std::false_type {};
+
+		template<typename TElem, std::size_t SIZE>
+		struct is_contiguous_container<std::array<TElem, SIZE>> : public std::true_type {};
+
+		template<typename TChar, typename TTraits, typename TAllocator>
+		struct is_contiguous_container<std::basic_string<TChar, TTraits, TAllocator>> : public std::true_type {};
+
+		template<typename TContainer>
+		const typename TContainer::value_type* container_data(TContainer& container, std::true_type)
+		{
+			return container.empty() ? nullptr : &container[0];
+		}
+
+		template<typename TContainer>
+		const typename TContainer::value_type* container_data(TContainer&, std::false_type)
+		{
+			return nullptr;
+		}
+
+		template<typename TContainer>
+		const typename TContainer::value_type* container_data(TContainer& container)
+		{
+			return container_data(container, is_contiguous_container<TContainer>());
+		}
+
+		template<typename TElem, typename TIterator>
+		const TElem* iterator_address(const TIterator& it, std::true_type)
+		{
+			return std::addressof(*it);
+		}
+
+		template<typename TElem, typename TIterator>
+		const TElem* iterator_address(const TIterator&, std::false_type)
+		{
+			return nullptr;
+		}
+
+		template<typename TElem, typename TIterator>
+		const TElem* iterator_address(const TIterator& it)
+		{
+			typedef typename std::iterator_traits<TIterator>::reference reference;
+			return iterator_address<TElem>(it, std::integral_constant<bool, std::is_reference<reference>::value &&
+				std::is_same<typename std::decay<reference>::type, TElem>::value>());
+		}
+
 		template<typename TIterator, typename TElem>
 		class _StlEnumerator : public IEnumerator<TElem>
 		{
@@ -76,6 +133,34 @@ namespace xlinq
 				return *_begin;
 			}
 
+			const TElem* current_ptr() override
+			{
+				if (!_started)
+				{
+					throw IterationNotStartedException();
+				}
+				assert_finished();
+				return iterator_address<TElem>(_begin);
+			}
+
+			int next_batch(std::vector<TElem>& buffer, int count) override
+			{
+				assert(count > 0);
+				assert_finished();
+				if (!_started)
+					_started = true;
+				else ++_begin;
+				int fetched = 0;
+				while (_begin != _end)
+				{
+					buffer.push_back(*_begin);
+					if (++fetched == count)
+						break;
+					++_begin;
+				}
+				return fetched;
+			}
+
 			bool equals(std::shared_ptr<IEnumerator<TElem>> other) const override
 			{
 				auto pother = std::dynamic_pointer_cast<_StlEnumerator<TIterator, TElem>>(other);
@@ -140,6 +225,31 @@ namespace xlinq
 				return *_current;
 			}
 
+			const TElem* current_ptr() override
+			{
+				assert_started();
+				assert_finished();
+				return iterator_address<TElem>(_current);
+			}
+
+			int next_batch(std::vector<TElem>& buffer, int count) override
+			{
+				assert(count > 0);
+				assert_finished();
+				if (!_started)
+					_started = true;
+				else ++_current;
+				int fetched = 0;
+				while (_current != _end)
+				{
+					buffer.push_back(*_current);
+					if (++fetched == count)
+						break;
+					++_current;
+				}
+				return fetched;
+			}
+
 			bool equals(std::shared_ptr<IEnumerator<TElem>> other) const override
 			{
 				auto pother = std::dynamic_pointer_cast<_StlBidirectionalEnumerator<TIterator, TElem>>(other);
@@ -256,6 +366,31 @@ namespace xlinq
 				return *_current;
 			}
 
+			const TElem* current_ptr() override
+			{
+				assert_started();
+				assert_finished();
+				return iterator_address<TElem>(_current);
+			}
+
+			int next_batch(std::vector<TElem>& buffer, int count) override
+			{
+				assert(count > 0);
+				assert_finished();
+				if (!_started)
+					_started = true;
+				else ++_current;
+				int fetched = 0;
+				while (_current != _end)
+				{
+					buffer.push_back(*_current);
+					if (++fetched == count)
+						break;
+					++_current;
+				}
+				return fetched;
+			}
+
 			bool equals(std::shared_ptr<IEnumerator<TElem>> other) const override
 			{
 				auto pother = std::dynamic_pointer_cast<_StlRandomAccessEnumerator<TIterator, TElem>>(other);
@@ -371,6 +506,11 @@ namespace xlinq
 			{
 				return (int)_container.size();
 			}
+
+			const TElem* data() override
+			{
+				return container_data(_container);
+			}
 		};
 
 		template<typename iterator_tag, typename TContainer, typename TElem>
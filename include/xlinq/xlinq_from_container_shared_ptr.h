@@ -225,6 +225,11 @@ namespace xlinq
 			{
 				return (int)_container->size();
 			}
+
+			const TElem* data() override
+			{
+				return container_data(*_container);
+			}
 		};
 
 		template<typename iterator_tag, typename TContainer, typename TElem>
@@ -142,11 +142,17 @@ namespace xlinq
 		{
 		private:
 			std::shared_ptr<_Gatherer<TElem>> _gatherer;
+			int _size;
 
 		public:
-			_LazyGatherEnumerable(std::shared_ptr<IEnumerator<TElem>> enumerator)
-				: _gatherer(std::shared_ptr<_Gatherer<TElem>>(new _Gatherer<TElem>(enumerator))) {}
-			
+			_LazyGatherEnumerable(std::shared_ptr<IEnumerator<TElem>> enumerator, int size)
+				: _gatherer(std::shared_ptr<_Gatherer<TElem>>(new _Gatherer<TElem>(enumerator))), _size(size) {}
+
+			int known_size() override
+			{
+				return _size;
+			}
+
 			std::shared_ptr<IEnumerator<TElem>> createEnumerator() override
 			{
 				return std::shared_ptr<IEnumerator<TElem>>(new _LazyGatherEnumerator<TElem>(_gatherer));
@@ -160,6 +166,9 @@ namespace xlinq
 			std::shared_ptr<IRandomAccessEnumerable<TElem>> build(std::shared_ptr<IEnumerable<TElem>> enumerable)
 			{
 				auto vec = std::shared_ptr<std::vector<TElem>>(new std::vector<TElem>());
+				int size = enumerable->known_size();
+				if (size > 0)
+					vec->reserve(size);
 				for (auto it = enumerable->getEnumerator(); it->next();)
 				{
 					vec->push_back(it->current());
@@ -186,7 +195,7 @@ namespace xlinq
 			template<typename TElem>
 			std::shared_ptr<IEnumerable<TElem>> build(std::shared_ptr<IEnumerable<TElem>> enumerable)
 			{
-				return std::shared_ptr<IEnumerable<TElem>>(new _LazyGatherEnumerable<TElem>(enumerable->getEnumerator()));
+				return std::shared_ptr<IEnumerable<TElem>>(new _LazyGatherEnumerable<TElem>(enumerable->getEnumerator(), enumerable->known_size()));
 			}
 
 			template<typename TElem>
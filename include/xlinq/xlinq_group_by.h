@@ -34,11 +34,17 @@ SOFTWARE.
 #include "xlinq_exception.h"
 #include "xlinq_select.h"
 #include "xlinq_gather.h"
+#include "xlinq_from.h"
+#include "xlinq_spill.h"
+#include <algorithm>
 #include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <memory>
 #include <unordered_map>
 #include <list>
 #include <utility>
+#include <vector>
 
 namespace xlinq
 {
@@ -216,6 +222,437 @@ namespace xlinq
 			}
 		};
 
+		template<typename TKey, typename TElem, typename THasher, typename TEqComp>
+		class FlatGroupingEnumerator : public IEnumerator<TElem>
+		{
+		private:
+			std::shared_ptr<FlatLookup<TKey, TElem, THasher, TEqComp>> _lookup;
+			int _group;
+			int _index;
+			bool _started;
+			bool _finished;
+		public:
+			FlatGroupingEnumerator(std::shared_ptr<FlatLookup<TKey, TElem, THasher, TEqComp>> lookup, int group)
+				: _lookup(lookup), _group(group), _index(lookup->begin(group)), _started(false), _finished(false) {}
+
+			bool next() override
+			{
+				if (_finished) throw IterationFinishedException();
+				if (_started)
+					++_index;
+				_started = true;
+				if (_index >= _lookup->end(_group))
+				{
+					_finished = true;
+					return false;
+				}
+				return true;
+			}
+
+			int next_batch(std::vector<TElem>& buffer, int count) override
+			{
+				if (_finished) throw IterationFinishedException();
+				int first = _started ? _index + 1 : _index;
+				int last = _lookup->end(_group);
+				int fetched = last - first < count ? last - first : count;
+				for (int i = first; i < first + fetched; ++i)
+					buffer.push_back(_lookup->at(i));
+				if (fetched > 0)
+				{
+					_index = first + fetched - 1;
+					_started = true;
+				}
+				if (fetched < count)
+				{
+					_index = last;
+					_started = true;
+					_finished = true;
+				}
+				return fetched;
+			}
+
+			TElem current() override
+			{
+				if (_finished) throw IterationFinishedException();
+				if (!_started) throw IterationNotStartedException();
+				return _lookup->at(_index);
+			}
+
+			bool equals(std::shared_ptr<IEnumerator<TElem>> other) const override
+			{
+				auto pother = std::dynamic_pointer_cast<FlatGroupingEnumerator<TKey, TElem, THasher, TEqComp>>(other);
+				if (!pother)
+					return false;
+				return this->_lookup == pother->_lookup &&
+					this->_group == pother->_group &&
+					this->_index == pother->_index &&
+					this->_started == pother->_started &&
+					this->_finished == pother->_finished;
+			}
+
+			std::shared_ptr<IEnumerator<TElem>> clone() const override
+			{
+				auto ptr = new FlatGroupingEnumerator<TKey, TElem, THasher, TEqComp>(this->_lookup, this->_group);
+				ptr->_index = this->_index;
+				ptr->_started = this->_started;
+				ptr->_finished = this->_finished;
+				return std::shared_ptr<IEnumerator<TElem>>(ptr);
+			}
+		};
+
+		template<typename TKey, typename TElem, typename THasher, typename TEqComp>
+		class FlatGrouping : public IGrouping<TKey, TElem>
+		{
+		private:
+			std::shared_ptr<FlatLookup<TKey, TElem, THasher, TEqComp>> _lookup;
+			int _group;
+		public:
+			FlatGrouping(std::shared_ptr<FlatLookup<TKey, TElem, THasher, TEqComp>> lookup, int group)
+				: _lookup(lookup), _group(group) {}
+
+			virtual TKey getKey() const override { return _lookup->key(_group); }
+
+			std::shared_ptr<IEnumerator<TElem>> createEnumerator() override
+			{
+				return std::shared_ptr<IEnumerator<TElem>>(new FlatGroupingEnumerator<TKey, TElem, THasher, TEqComp>(_lookup, _group));
+			}
+		};
+
+		template<typename TKey, typename TElem, typename THasher, typename TEqComp>
+		class FlatGroupsEnumerator : public IEnumerator<std::shared_ptr<IGrouping<TKey, TElem>>>
+		{
+		private:
+			std::shared_ptr<FlatLookup<TKey, TElem, THasher, TEqComp>> _lookup;
+			int _group;
+			bool _started;
+			bool _finished;
+
+		public:
+			FlatGroupsEnumerator(std::shared_ptr<FlatLookup<TKey, TElem, THasher, TEqComp>> lookup)
+				: _lookup(lookup), _group(-1), _started(false), _finished(false) {}
+
+			bool next() override
+			{
+				if (_finished) throw IterationFinishedException();
+				_started = true;
+				if (++_group >= _lookup->groupCount())
+				{
+					_finished = true;
+					return false;
+				}
+				return true;
+			}
+
+			std::shared_ptr<IGrouping<TKey, TElem>> current() override
+			{
+				if (_finished) throw IterationFinishedException();
+				if (!_started) throw IterationNotStartedException();
+				return std::shared_ptr<IGrouping<TKey, TElem>>(new FlatGrouping<TKey, TElem, THasher, TEqComp>(_lookup, _group));
+			}
+
+			bool equals(std::shared_ptr<IEnumerator<std::shared_ptr<IGrouping<TKey, TElem>>>> other) const override
+			{
+				auto pother = std::dynamic_pointer_cast<FlatGroupsEnumerator<TKey, TElem, THasher, TEqComp>>(other);
+				if (!pother)
+					return false;
+				return this->_lookup == pother->_lookup &&
+					this->_group == pother->_group &&
+					this->_started == pother->_started &&
+					this->_finished == pother->_finished;
+			}
+
+			std::shared_ptr<IEnumerator<std::shared_ptr<IGrouping<TKey, TElem>>>> clone() const override
+			{
+				auto ptr = new FlatGroupsEnumerator<TKey, TElem, THasher, TEqComp>(this->_lookup);
+				ptr->_group = this->_group;
+				ptr->_started = this->_started;
+				ptr->_finished = this->_finished;
+				return std::shared_ptr<IEnumerator<std::shared_ptr<IGrouping<TKey, TElem>>>>(ptr);
+			}
+		};
+
+		template<typename TKeySelector, typename TKey, typename TElem, typename THasher, typename TEqComp>
+		class _FlatGroupByEnumerable : public IEnumerable<std::shared_ptr<IGrouping<TKey, TElem>>>
+		{
+		private:
+			std::shared_ptr<IRandomAccessEnumerable<TElem>> _source;
+			TKeySelector _keySelector;
+			THasher _hasher;
+			TEqComp _eqComp;
+			std::shared_ptr<FlatLookup<TKey, TElem, THasher, TEqComp>> _lookup;
+		public:
+			_FlatGroupByEnumerable(std::shared_ptr<IRandomAccessEnumerable<TElem>> source, TKeySelector keySelector, THasher hasher, TEqComp eqComp)
+				: _source(source), _keySelector(keySelector), _hasher(hasher), _eqComp(eqComp) {}
+
+			std::shared_ptr<IEnumerator<std::shared_ptr<IGrouping<TKey, TElem>>>> createEnumerator() override
+			{
+				if (!_lookup)
+				{
+					_lookup = std::shared_ptr<FlatLookup<TKey, TElem, THasher, TEqComp>>(
+						new FlatLookup<TKey, TElem, THasher, TEqComp>(_source->getEnumerator(), _keySelector, _hasher, _eqComp, _source->size()));
+					_source = nullptr;
+				}
+				return std::shared_ptr<IEnumerator<std::shared_ptr<IGrouping<TKey, TElem>>>>(new FlatGroupsEnumerator<TKey, TElem, THasher, TEqComp>(_lookup));
+			}
+		};
+
+		class _SpillPartition
+		{
+		public:
+			std::shared_ptr<_SpillFile> file;
+			std::shared_ptr<std::vector<std::pair<long long, long long>>> ranges;
+
+			_SpillPartition(std::shared_ptr<_SpillFile> file)
+				: file(file), ranges(std::make_shared<std::vector<std::pair<long long, long long>>>()) {}
+		};
+
+		template<typename TKeySelector, typename TKey, typename TElem, typename THasher, typename TEqComp, typename TSerializer>
+		class SpillGroupsEnumerator : public IEnumerator<std::shared_ptr<IGrouping<TKey, TElem>>>
+		{
+		private:
+			std::shared_ptr<std::vector<_SpillPartition>> _partitions;
+			TKeySelector _keySelector;
+			THasher _hasher;
+			TEqComp _eqComp;
+			TSerializer _serializer;
+			std::shared_ptr<FlatLookup<TKey, TElem, THasher, TEqComp>> _lookup;
+			int _partition;
+			int _group;
+			bool _started;
+			bool _finished;
+
+		public:
+			SpillGroupsEnumerator(std::shared_ptr<std::vector<_SpillPartition>> partitions, TKeySelector keySelector, THasher hasher, TEqComp eqComp, TSerializer serializer)
+				: _partitions(partitions), _keySelector(keySelector), _hasher(hasher), _eqComp(eqComp), _serializer(serializer), _partition(-1), _group(-1), _started(false), _finished(false) {}
+
+			bool next() override
+			{
+				if (_finished) throw IterationFinishedException();
+				_started = true;
+				++_group;
+				while (!_lookup || _group >= _lookup->groupCount())
+				{
+					_lookup = nullptr;
+					if (++_partition >= (int)_partitions->size())
+					{
+						_finished = true;
+						return false;
+					}
+					_lookup = std::shared_ptr<FlatLookup<TKey, TElem, THasher, TEqComp>>(new FlatLookup<TKey, TElem, THasher, TEqComp>(
+						std::shared_ptr<IEnumerator<TElem>>(new _SpillFileEnumerator<TElem, TSerializer>((*_partitions)[_partition].file, (*_partitions)[_partition].ranges, _serializer)), _keySelector, _hasher, _eqComp));
+					_group = 0;
+				}
+				return true;
+			}
+
+			std::shared_ptr<IGrouping<TKey, TElem>> current() override
+			{
+				if (_finished) throw IterationFinishedException();
+				if (!_started) throw IterationNotStartedException();
+				return std::shared_ptr<IGrouping<TKey, TElem>>(new FlatGrouping<TKey, TElem, THasher, TEqComp>(_lookup, _group));
+			}
+
+			bool equals(std::shared_ptr<IEnumerator<std::shared_ptr<IGrouping<TKey, TElem>>>> other) const override
+			{
+				auto pother = std::dynamic_pointer_cast<SpillGroupsEnumerator<TKeySelector, TKey, TElem, THasher, TEqComp, TSerializer>>(other);
+				if (!pother)
+					return false;
+				return this->_partitions == pother->_partitions &&
+					this->_partition == pother->_partition &&
+					this->_group == pother->_group &&
+					this->_started == pother->_started &&
+					this->_finished == pother->_finished;
+			}
+
+			std::shared_ptr<IEnumerator<std::shared_ptr<IGrouping<TKey, TElem>>>> clone() const override
+			{
+				return std::shared_ptr<IEnumerator<std::shared_ptr<IGrouping<TKey, TElem>>>>(new SpillGroupsEnumerator<TKeySelector, TKey, TElem, THasher, TEqComp, TSerializer>(*this));
+			}
+		};
+
+		template<typename TKeySelector, typename TKey, typename TElem, typename THasher, typename TEqComp, typename TSerializer>
+		class _SpillGroupByEnumerable : public IEnumerable<std::shared_ptr<IGrouping<TKey, TElem>>>
+		{
+		private:
+			const int partition_bits = 5;
+			const int max_depth = 8;
+			std::shared_ptr<IEnumerable<TElem>> _source;
+			int _memoryBudget;
+			TKeySelector _keySelector;
+			THasher _hasher;
+			TEqComp _eqComp;
+			TSerializer _serializer;
+
+			std::uint64_t hash_of(const TElem& elem)
+			{
+				return (std::uint64_t)_hasher(_keySelector(elem)) * 0x9E3779B97F4A7C15ull;
+			}
+
+			int partition_of(std::uint64_t hash, int depth)
+			{
+				return (int)(hash >> (64 - partition_bits * (depth + 1))) & ((1 << partition_bits) - 1);
+			}
+
+			void write_chunk(std::vector<TElem>& chunk, _SpillFile& file, _SpillPartition& partition)
+			{
+				if (chunk.empty())
+					return;
+				long long begin = file.end();
+				for (auto& elem : chunk)
+					file.write(elem, _serializer);
+				partition.ranges->push_back(std::make_pair(begin, file.finish()));
+				chunk.clear();
+			}
+
+			void partition(std::shared_ptr<IEnumerator<TElem>> source, std::vector<TElem>& buffer, int depth, std::vector<std::shared_ptr<_SpillFile>>& files, std::vector<_SpillPartition>& partitions)
+			{
+				if (!files[depth])
+					files[depth] = std::make_shared<_SpillFile>();
+				int count = 1 << partition_bits;
+				int chunkSize = std::max(_memoryBudget / count, 1);
+				std::vector<_SpillPartition> children;
+				for (int i = 0; i < count; ++i)
+					children.push_back(_SpillPartition(files[depth]));
+				std::vector<std::vector<TElem>> chunks(count);
+				std::vector<int> counts(count, 0);
+				std::vector<std::uint64_t> firstHashes(count, 0);
+				std::vector<bool> splittable(count, false);
+				bool more = true;
+				while (true)
+				{
+					for (auto& elem : buffer)
+					{
+						std::uint64_t hash = hash_of(elem);
+						int index = partition_of(hash, depth);
+						if (counts[index]++ == 0)
+							firstHashes[index] = hash;
+						else if (hash != firstHashes[index])
+							splittable[index] = true;
+						chunks[index].push_back(std::move(elem));
+						if ((int)chunks[index].size() >= chunkSize)
+							write_chunk(chunks[index], *files[depth], children[index]);
+					}
+					buffer.clear();
+					if (!more)
+						break;
+					more = source->next_batch(buffer, _memoryBudget) == _memoryBudget;
+				}
+				for (int i = 0; i < count; ++i)
+					write_chunk(chunks[i], *files[depth], children[i]);
+				std::vector<std::vector<TElem>>().swap(chunks);
+				for (int i = 0; i < count; ++i)
+				{
+					if (!counts[i])
+						continue;
+					if (counts[i] > _memoryBudget && splittable[i] && depth + 1 < max_depth)
+						partition(std::shared_ptr<IEnumerator<TElem>>(new _SpillFileEnumerator<TElem, TSerializer>(children[i].file, children[i].ranges, _serializer)), buffer, depth + 1, files, partitions);
+					else partitions.push_back(children[i]);
+				}
+			}
+
+		public:
+			_SpillGroupByEnumerable(std::shared_ptr<IEnumerable<TElem>> source, int memoryBudget, TKeySelector keySelector, THasher hasher, TEqComp eqComp, TSerializer serializer)
+				: _source(source), _memoryBudget(memoryBudget < 1 ? 1 : memoryBudget), _keySelector(keySelector), _hasher(hasher), _eqComp(eqComp), _serializer(serializer) {}
+
+			std::shared_ptr<IEnumerator<std::shared_ptr<IGrouping<TKey, TElem>>>> createEnumerator() override
+			{
+				auto source = _source->getEnumerator();
+				auto buffer = std::make_shared<std::vector<TElem>>();
+				if (source->next_batch(*buffer, _memoryBudget + 1) <= _memoryBudget)
+				{
+					auto lookup = std::shared_ptr<FlatLookup<TKey, TElem, THasher, TEqComp>>(new FlatLookup<TKey, TElem, THasher, TEqComp>(
+						from(buffer)->getEnumerator(), _keySelector, _hasher, _eqComp, (int)buffer->size()));
+					return std::shared_ptr<IEnumerator<std::shared_ptr<IGrouping<TKey, TElem>>>>(new FlatGroupsEnumerator<TKey, TElem, THasher, TEqComp>(lookup));
+				}
+				auto partitions = std::make_shared<std::vector<_SpillPartition>>();
+				std::vector<std::shared_ptr<_SpillFile>> files(max_depth);
+				partition(source, *buffer, 0, files, *partitions);
+				return std::shared_ptr<IEnumerator<std::shared_ptr<IGrouping<TKey, TElem>>>>(
+					new SpillGroupsEnumerator<TKeySelector, TKey, TElem, THasher, TEqComp, TSerializer>(partitions, _keySelector, _hasher, _eqComp, _serializer));
+			}
+		};
+
+		class _DefaultHasher
+		{
+		public:
+			template<typename TKey>
+			std::size_t operator()(const TKey& key) const
+			{
+				return std::hash<TKey>()(key);
+			}
+		};
+
+		class _DefaultEqComp
+		{
+		public:
+			template<typename TKey>
+			bool operator()(const TKey& first, const TKey& second) const
+			{
+				return std::equal_to<TKey>()(first, second);
+			}
+		};
+
+		template<typename TKeySelector, typename THasher, typename TEqComp, typename TSerializer>
+		class _SpillGroupByBuilder
+		{
+			int _memoryBudget;
+			TKeySelector _keySelector;
+			THasher _hasher;
+			TEqComp _eqComp;
+			TSerializer _serializer;
+		public:
+			_SpillGroupByBuilder(int memoryBudget, TKeySelector keySelector, THasher hasher, TEqComp eqComp, TSerializer serializer)
+				: _memoryBudget(memoryBudget), _keySelector(keySelector), _hasher(hasher), _eqComp(eqComp), _serializer(serializer) {}
+
+			template<typename TElem>
+			auto build(std::shared_ptr<IEnumerable<TElem>> enumerable) -> std::shared_ptr<IEnumerable<std::shared_ptr<IGrouping<typename unaryreturntype<TKeySelector, TElem>::type, TElem>>>>
+			{
+				typedef typename unaryreturntype<TKeySelector, TElem>::type TKey;
+				return std::shared_ptr<IEnumerable<std::shared_ptr<IGrouping<typename unaryreturntype<TKeySelector, TElem>::type, TElem>>>>(
+					new _SpillGroupByEnumerable<TKeySelector, TKey, TElem, THasher, TEqComp, TSerializer>(enumerable, _memoryBudget, _keySelector, _hasher, _eqComp, _serializer));
+			}
+
+			template<typename TElem>
+			auto build(std::shared_ptr<IBidirectionalEnumerable<TElem>> enumerable) -> std::shared_ptr<IEnumerable<std::shared_ptr<IGrouping<typename unaryreturntype<TKeySelector, TElem>::type, TElem>>>>
+			{
+				return build((std::shared_ptr<IEnumerable<TElem>>)enumerable);
+			}
+
+			template<typename TElem>
+			auto build(std::shared_ptr<IRandomAccessEnumerable<TElem>> enumerable) -> std::shared_ptr<IEnumerable<std::shared_ptr<IGrouping<typename unaryreturntype<TKeySelector, TElem>::type, TElem>>>>
+			{
+				return build((std::shared_ptr<IEnumerable<TElem>>)enumerable);
+			}
+		};
+
+		template<typename TKeySelector, typename TSelector, typename THasher, typename TEqComp, typename TSerializer>
+		class _SpillGroupByResultBuilder
+		{
+			_SpillGroupByBuilder<TKeySelector, THasher, TEqComp, TSerializer> _builder;
+			TSelector _selector;
+		public:
+			_SpillGroupByResultBuilder(int memoryBudget, TKeySelector keySelector, TSelector selector, THasher hasher, TEqComp eqComp, TSerializer serializer)
+				: _builder(memoryBudget, keySelector, hasher, eqComp, serializer), _selector(selector) {}
+
+			template<typename TElem>
+			auto build(std::shared_ptr<IEnumerable<TElem>> enumerable) -> std::shared_ptr<IEnumerable<typename unaryreturntype<TSelector, std::shared_ptr<IGrouping<typename unaryreturntype<TKeySelector, TElem>::type, TElem>>>::type>>
+			{
+				return _builder.build(enumerable) >> select(_selector) >> lazy_gather();
+			}
+
+			template<typename TElem>
+			auto build(std::shared_ptr<IBidirectionalEnumerable<TElem>> enumerable) -> std::shared_ptr<IEnumerable<typename unaryreturntype<TSelector, std::shared_ptr<IGrouping<typename unaryreturntype<TKeySelector, TElem>::type, TElem>>>::type>>
+			{
+				return build((std::shared_ptr<IEnumerable<TElem>>)enumerable);
+			}
+
+			template<typename TElem>
+			auto build(std::shared_ptr<IRandomAccessEnumerable<TElem>> enumerable) -> std::shared_ptr<IEnumerable<typename unaryreturntype<TSelector, std::shared_ptr<IGrouping<typename unaryreturntype<TKeySelector, TElem>::type, TElem>>>::type>>
+			{
+				return build((std::shared_ptr<IEnumerable<TElem>>)enumerable);
+			}
+		};
+
 		template<typename TKeySelector>
 		class _GroupByBuilder
 		{
@@ -224,6 +661,17 @@ namespace xlinq
 			_GroupByBuilder(TKeySelector keySelector)
 				: _keySelector(keySelector) {}
 
+			_SpillGroupByBuilder<TKeySelector, _DefaultHasher, _DefaultEqComp, _BinarySerializer> spill(int memoryBudget) const
+			{
+				return _SpillGroupByBuilder<TKeySelector, _DefaultHasher, _DefaultEqComp, _BinarySerializer>(memoryBudget, _keySelector, _DefaultHasher(), _DefaultEqComp(), _BinarySerializer());
+			}
+
+			template<typename TSerializer>
+			_SpillGroupByBuilder<TKeySelector, _DefaultHasher, _DefaultEqComp, TSerializer> spill(int memoryBudget, TSerializer serializer) const
+			{
+				return _SpillGroupByBuilder<TKeySelector, _DefaultHasher, _DefaultEqComp, TSerializer>(memoryBudget, _keySelector, _DefaultHasher(), _DefaultEqComp(), serializer);
+			}
+
 			template<typename TElem>
 			auto build(std::shared_ptr<IEnumerable<TElem>> enumerable) -> std::shared_ptr<IEnumerable<std::shared_ptr<IGrouping<typename unaryreturntype<TKeySelector, TElem>::type, TElem>>>>
 			{
@@ -241,7 +689,15 @@ namespace xlinq
 			template<typename TElem>
 			auto build(std::shared_ptr<IRandomAccessEnumerable<TElem>> enumerable) -> std::shared_ptr<IEnumerable<std::shared_ptr<IGrouping<typename unaryreturntype<TKeySelector, TElem>::type, TElem>>>>
 			{
-				return build((std::shared_ptr<IEnumerable<TElem>>)enumerable);
+				typedef typename unaryreturntype<TKeySelector, TElem>::type TKey;
+				return std::shared_ptr<IEnumerable<std::shared_ptr<IGrouping<typename unaryreturntype<TKeySelector, TElem>::type, TElem>>>>(
+					new _FlatGroupByEnumerable<TKeySelector, TKey, TElem, std::hash<TKey>, std::equal_to<TKey>>(enumerable, _keySelector, std::hash<TKey>(), std::equal_to<TKey>()));
+			}
+
+			template<typename TQuery>
+			auto build(const ParallelEnumerable<TQuery>& enumerable) -> decltype(enumerable.derived().group_by(_keySelector))
+			{
+				return enumerable.derived().group_by(_keySelector);
 			}
 		};
 
@@ -255,6 +711,17 @@ namespace xlinq
 			_GroupByBuilderWithHashAndEqComp(TKeySelector keySelector, THasher hasher, TEqComp eqComp)
 				: _keySelector(keySelector), _hasher(hasher), _eqComp(eqComp) {}
 
+			_SpillGroupByBuilder<TKeySelector, THasher, TEqComp, _BinarySerializer> spill(int memoryBudget) const
+			{
+				return _SpillGroupByBuilder<TKeySelector, THasher, TEqComp, _BinarySerializer>(memoryBudget, _keySelector, _hasher, _eqComp, _BinarySerializer());
+			}
+
+			template<typename TSerializer>
+			_SpillGroupByBuilder<TKeySelector, THasher, TEqComp, TSerializer> spill(int memoryBudget, TSerializer serializer) const
+			{
+				return _SpillGroupByBuilder<TKeySelector, THasher, TEqComp, TSerializer>(memoryBudget, _keySelector, _hasher, _eqComp, serializer);
+			}
+
 			template<typename TElem>
 			auto build(std::shared_ptr<IEnumerable<TElem>> enumerable) -> std::shared_ptr<IEnumerable<std::shared_ptr<IGrouping<typename unaryreturntype<TKeySelector, TElem>::type, TElem>>>>
 			{
@@ -272,7 +739,15 @@ namespace xlinq
 			template<typename TElem>
 			auto build(std::shared_ptr<IRandomAccessEnumerable<TElem>> enumerable) -> std::shared_ptr<IEnumerable<std::shared_ptr<IGrouping<typename unaryreturntype<TKeySelector, TElem>::type, TElem>>>>
 			{
-				return build((std::shared_ptr<IEnumerable<TElem>>)enumerable);
+				typedef typename unaryreturntype<TKeySelector, TElem>::type TKey;
+				return std::shared_ptr<IEnumerable<std::shared_ptr<IGrouping<typename unaryreturntype<TKeySelector, TElem>::type, TElem>>>>(
+					new _FlatGroupByEnumerable<TKeySelector, TKey, TElem, THasher, TEqComp>(enumerable, _keySelector, _hasher, _eqComp));
+			}
+
+			template<typename TQuery>
+			auto build(const ParallelEnumerable<TQuery>& enumerable) -> decltype(enumerable.derived().group_by(_keySelector, _hasher, _eqComp))
+			{
+				return enumerable.derived().group_by(_keySelector, _hasher, _eqComp);
 			}
 		};
 
@@ -285,6 +760,17 @@ namespace xlinq
 			_GroupByResultBuilder(TKeySelector keySelector, TSelector selector)
 				: _keySelector(keySelector), _selector(selector) {}
 
+			_SpillGroupByResultBuilder<TKeySelector, TSelector, _DefaultHasher, _DefaultEqComp, _BinarySerializer> spill(int memoryBudget) const
+			{
+				return _SpillGroupByResultBuilder<TKeySelector, TSelector, _DefaultHasher, _DefaultEqComp, _BinarySerializer>(memoryBudget, _keySelector, _selector, _DefaultHasher(), _DefaultEqComp(), _BinarySerializer());
+			}
+
+			template<typename TSerializer>
+			_SpillGroupByResultBuilder<TKeySelector, TSelector, _DefaultHasher, _DefaultEqComp, TSerializer> spill(int memoryBudget, TSerializer serializer) const
+			{
+				return _SpillGroupByResultBuilder<TKeySelector, TSelector, _DefaultHasher, _DefaultEqComp, TSerializer>(memoryBudget, _keySelector, _selector, _DefaultHasher(), _DefaultEqComp(), serializer);
+			}
+
 			template<typename TElem>
 			auto build(std::shared_ptr<IEnumerable<TElem>> enumerable) -> std::shared_ptr<IEnumerable<typename unaryreturntype<TSelector, std::shared_ptr<IGrouping<typename unaryreturntype<TKeySelector, TElem>::type, TElem>>>::type>>
 			{
@@ -303,7 +789,16 @@ namespace xlinq
 			template<typename TElem>
 			auto build(std::shared_ptr<IRandomAccessEnumerable<TElem>> enumerable) -> std::shared_ptr<IEnumerable<typename unaryreturntype<TSelector, std::shared_ptr<IGrouping<typename unaryreturntype<TKeySelector, TElem>::type, TElem>>>::type>>
 			{
-				return build((std::shared_ptr<IEnumerable<TElem>>)enumerable);
+				typedef typename unaryreturntype<TKeySelector, TElem>::type TKey;
+				return (std::shared_ptr<IEnumerable<std::shared_ptr<IGrouping<typename unaryreturntype<TKeySelector, TElem>::type, TElem>>>>(
+					new _FlatGroupByEnumerable<TKeySelector, TKey, TElem, std::hash<TKey>, std::equal_to<TKey>>(enumerable, _keySelector, std::hash<TKey>(), std::equal_to<TKey>())))
+					>> select(_selector) >> lazy_gather();
+			}
+
+			template<typename TQuery>
+			auto build(const ParallelEnumerable<TQuery>& enumerable) -> decltype(enumerable.derived().group_by(_keySelector) >> select(_selector) >> gather())
+			{
+				return enumerable.derived().group_by(_keySelector) >> select(_selector) >> gather();
 			}
 		};
 
@@ -318,6 +813,17 @@ namespace xlinq
 			_GroupByResultBuilderWithHashAndEqComp(TKeySelector keySelector, TSelector selector, THasher hasher, TEqComp eqComp)
 				: _keySelector(keySelector), _selector(selector), _hasher(hasher), _eqComp(eqComp) {}
 
+			_SpillGroupByResultBuilder<TKeySelector, TSelector, THasher, TEqComp, _BinarySerializer> spill(int memoryBudget) const
+			{
+				return _SpillGroupByResultBuilder<TKeySelector, TSelector, THasher, TEqComp, _BinarySerializer>(memoryBudget, _keySelector, _selector, _hasher, _eqComp, _BinarySerializer());
+			}
+
+			template<typename TSerializer>
+			_SpillGroupByResultBuilder<TKeySelector, TSelector, THasher, TEqComp, TSerializer> spill(int memoryBudget, TSerializer serializer) const
+			{
+				return _SpillGroupByResultBuilder<TKeySelector, TSelector, THasher, TEqComp, TSerializer>(memoryBudget, _keySelector, _selector, _hasher, _eqComp, serializer);
+			}
+
 			template<typename TElem>
 			auto build(std::shared_ptr<IEnumerable<TElem>> enumerable) -> std::shared_ptr<IEnumerable<typename unaryreturntype<TSelector, std::shared_ptr<IGrouping<typename unaryreturntype<TKeySelector, TElem>::type, TElem>>>::type>>
 			{
@@ -336,7 +842,16 @@ namespace xlinq
 			template<typename TElem>
 			auto build(std::shared_ptr<IRandomAccessEnumerable<TElem>> enumerable) -> std::shared_ptr<IEnumerable<typename unaryreturntype<TSelector, std::shared_ptr<IGrouping<typename unaryreturntype<TKeySelector, TElem>::type, TElem>>>::type>>
 			{
-				return build((std::shared_ptr<IEnumerable<TElem>>)enumerable);
+				typedef typename unaryreturntype<TKeySelector, TElem>::type TKey;
+				return (std::shared_ptr<IEnumerable<std::shared_ptr<IGrouping<typename unaryreturntype<TKeySelector, TElem>::type, TElem>>>>(
+					new _FlatGroupByEnumerable<TKeySelector, TKey, TElem, THasher, TEqComp>(enumerable, _keySelector, _hasher, _eqComp)))
+					>> select(_selector) >> lazy_gather();
+			}
+
+			template<typename TQuery>
+			auto build(const ParallelEnumerable<TQuery>& enumerable) -> decltype(enumerable.derived().group_by(_keySelector, _hasher, _eqComp) >> select(_selector) >> gather())
+			{
+				return enumerable.derived().group_by(_keySelector, _hasher, _eqComp) >> select(_selector) >> gather();
 			}
 		};
 	}
@@ -347,6 +862,20 @@ namespace xlinq
 	*	This function may be used to group elements by common key which
 	*	is extracted from them by keySelector provided by user.
 	*	Key must have defined std::hash and std::equal_to type spetialization.
+	*	Random access sources are grouped on first enumeration into one contiguous
+	*	element array indexed by open addressing key table, other sources are grouped
+	*	lazily while groups are enumerated.
+	*	Parallel queries are grouped immediately using thread local tables which are
+	*	merged afterwards, groups keep order of first key occurrence.
+	*	Calling spill(memoryBudget) or spill(memoryBudget, serializer) on returned
+	*	builder (and on builders returned by other group_by overloads) limits number of
+	*	elements held in memory. Once source exceeds the budget, it is hash partitioned
+	*	into temporary files, which are grouped one at a time during enumeration, so
+	*	groups are no longer ordered by first key occurrence. Partitions exceeding the
+	*	budget are split again by further bits of key hash unless all of their keys
+	*	have equal hash. Partitions of one splitting level share single temporary file,
+	*	so at most eight files are open no matter how many partitions are created. See
+	*	external_sort for serializer requirements.
 	*	@return Builder of group_by expression.
 	*/
 	template<typename TKeySelector>
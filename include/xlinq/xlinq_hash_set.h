@@ -0,0 +1,203 @@
+/*
+MIT License
+
+Copyright (c) 2017 TrolleY
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+*	@file xlinq_hash_set.h
+*	Open addressing hash set used by set operations.
+*	@author TrolleY
+*/
+#ifndef XLINQ_HASH_SET_H_
+#define XLINQ_HASH_SET_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "xlinq_base.h"
+#include "xlinq_defs.h"
+
+#if XLINQ_SIMD && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define XLINQ_HASH_SET_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace xlinq
+{
+	/*@cond XLINQ_INTERNAL*/
+	namespace internal
+	{
+		template<typename TElem, typename THasher, typename TEqComp>
+		class FlatHashSet
+		{
+		private:
+			enum { GROUP_SIZE = 16, EMPTY = 0x80 };
+
+			THasher _hasher;
+			TEqComp _eqComp;
+			std::vector<std::uint8_t> _control;
+			std::vector<int> _indices;
+			std::vector<TElem> _elements;
+			std::size_t _groupMask;
+
+			static int match(const std::uint8_t* group, std::uint8_t tag)
+			{
+#ifdef XLINQ_HASH_SET_SSE2
+				__m128i control = _mm_loadu_si128((const __m128i*)group);
+				return _mm_movemask_epi8(_mm_cmpeq_epi8(control, _mm_set1_epi8((char)tag)));
+#else
+				int mask = 0;
+				for (int i = 0; i < GROUP_SIZE; ++i)
+					if (group[i] == tag)
+						mask |= 1 << i;
+				return mask;
+#endif
+			}
+
+			static int count_trailing_zeros(int mask)
+			{
+				int index = 0;
+				while (!(mask & 1))
+				{
+					mask >>= 1;
+					++index;
+				}
+				return index;
+			}
+
+			template<typename TProbe>
+			std::size_t find_slot(const TProbe& elem, std::uint64_t hash, bool& found) const
+			{
+				std::uint8_t tag = (std::uint8_t)(hash & 0x7F);
+				std::size_t group = (std::size_t)(hash >> 7) & _groupMask;
+				for (std::size_t step = 1;; group = (group + step++) & _groupMask)
+				{
+					const std::uint8_t* control = &_control[group * GROUP_SIZE];
+					for (int mask = match(control, tag); mask; mask &= mask - 1)
+					{
+						std::size_t slot = group * GROUP_SIZE + count_trailing_zeros(mask);
+						if (_eqComp(elem, _elements[_indices[slot]]))
+						{
+							found = true;
+							return slot;
+						}
+					}
+					int empty = match(control, EMPTY);
+					if (empty)
+					{
+						found = false;
+						return group * GROUP_SIZE + count_trailing_zeros(empty);
+					}
+				}
+			}
+
+			void rehash(std::size_t groups)
+			{
+				_control.assign(groups * GROUP_SIZE, (std::uint8_t)EMPTY);
+				_indices.assign(groups * GROUP_SIZE, 0);
+				_groupMask = groups - 1;
+				for (int index = 0; index < (int)_elements.size(); ++index)
+				{
+					bool found;
+					std::uint64_t hash = mix_hash((std::size_t)_hasher(_elements[index]));
+					std::size_t slot = find_slot(_elements[index], hash, found);
+					_control[slot] = (std::uint8_t)(hash & 0x7F);
+					_indices[slot] = index;
+				}
+			}
+
+			static std::size_t groups_for(std::size_t count)
+			{
+				std::size_t groups = 1;
+				while (groups * GROUP_SIZE * 7 < count * 8)
+					groups *= 2;
+				return groups;
+			}
+
+		public:
+			FlatHashSet(THasher hasher, TEqComp eqComp, int sizeHint = 0)
+				: _hasher(hasher), _eqComp(eqComp), _groupMask(0)
+			{
+				_elements.reserve(sizeHint);
+				rehash(groups_for(sizeHint));
+			}
+
+			THasher getHasher() const { return _hasher; }
+
+			TEqComp getComparer() const { return _eqComp; }
+
+			int size() const { return (int)_elements.size(); }
+
+			bool insert(const TElem& elem)
+			{
+				bool found;
+				std::uint64_t hash = mix_hash((std::size_t)_hasher(elem));
+				std::size_t slot = find_slot(elem, hash, found);
+				if (found)
+					return false;
+				_control[slot] = (std::uint8_t)(hash & 0x7F);
+				_indices[slot] = (int)_elements.size();
+				_elements.push_back(elem);
+				if (_elements.size() * 8 > _control.size() * 7)
+					rehash((_groupMask + 1) * 2);
+				return true;
+			}
+
+			template<typename TProbe>
+			bool contains(const TProbe& elem) const
+			{
+				return contains(elem, mix_hash((std::size_t)_hasher(elem)));
+			}
+
+			template<typename TProbe>
+			bool contains(const TProbe& elem, std::uint64_t hash) const
+			{
+				bool found;
+				find_slot(elem, hash, found);
+				return found;
+			}
+		};
+
+		template<typename TElem>
+		int size_hint(const std::shared_ptr<IEnumerable<TElem>>& enumerable)
+		{
+			int size = enumerable->known_size();
+			return size > 0 ? size : 0;
+		}
+
+		template<typename TElem>
+		int size_hint(const std::shared_ptr<IBidirectionalEnumerable<TElem>>& enumerable)
+		{
+			return size_hint((std::shared_ptr<IEnumerable<TElem>>)enumerable);
+		}
+
+		template<typename TElem>
+		int size_hint(const std::shared_ptr<IRandomAccessEnumerable<TElem>>& enumerable)
+		{
+			return enumerable->size();
+		}
+	}
+	/*@endcond*/
+}
+
+#endif
\ No newline at end of file
@@ -30,9 +30,9 @@ SOFTWARE.
 #define XLINQ_INTERSECT_H_
 
 #include <memory>
-#include <unordered_set>
 #include "xlinq_base.h"
 #include "xlinq_from.h"
+#include "xlinq_hash_set.h"
 #include "xlinq_to_container.h"
 
 namespace xlinq
@@ -43,17 +43,21 @@ namespace xlinq
 		template<typename TElem, typename THasher, typename TEqComp>
 		class _IntersectEnumerator : public IEnumerator<TElem>
 		{
-			std::unordered_set<TElem, THasher, TEqComp> _set;
+			std::shared_ptr<const FlatHashSet<TElem, THasher, TEqComp>> _set;
+			FlatHashSet<TElem, THasher, TEqComp> _yielded;
 			std::shared_ptr<IEnumerator<TElem>> _source;
 		public:
-			_IntersectEnumerator(const std::unordered_set<TElem, THasher, TEqComp>& set, std::shared_ptr<IEnumerator<TElem>> source)
-				: _set(set), _source(source) {}
+			_IntersectEnumerator(std::shared_ptr<const FlatHashSet<TElem, THasher, TEqComp>> set, std::shared_ptr<IEnumerator<TElem>> source)
+				: _set(set), _yielded(set->getHasher(), set->getComparer()), _source(source) {}
 
 			bool next() override
 			{
 				while (_source->next())
-					if (_set.erase(_source->current()) > 0)
+				{
+					TElem elem = _source->current();
+					if (_set->contains(elem) && _yielded.insert(elem))
 						return true;
+				}
 				return false;
 			}
 
@@ -67,13 +71,15 @@ namespace xlinq
 				auto pother = std::dynamic_pointer_cast<_IntersectEnumerator<TElem, THasher, TEqComp>>(other);
 				if (!pother)
 					return false;
-				return this->_set.size() == pother->_set.size() &&
+				return this->_yielded.size() == pother->_yielded.size() &&
 					this->_source->equals(pother->_source);
 			}
 
 			std::shared_ptr<IEnumerator<TElem>> clone() const override
 			{
-				return std::shared_ptr<IEnumerator<TElem>>(new _IntersectEnumerator<TElem, THasher, TEqComp>(this->_set, this->_source->clone()));
+				auto ptr = new _IntersectEnumerator<TElem, THasher, TEqComp>(*this);
+				ptr->_source = this->_source->clone();
+				return std::shared_ptr<IEnumerator<TElem>>(ptr);
 			}
 		};
 
@@ -81,11 +87,18 @@ namespace xlinq
 		class _IntersectEnumerable : public IEnumerable<TElem>
 		{
 		private:
-			std::unordered_set<TElem, THasher, TEqComp> _set;
+			std::shared_ptr<const FlatHashSet<TElem, THasher, TEqComp>> _set;
 			std::shared_ptr<IEnumerable<TElem>> _source;
 		public:
 			_IntersectEnumerable(TContainer container, THasher hasher, TEqComp eqComp, std::shared_ptr<IEnumerable<TElem>> source)
-				: _set(from(container) >> to_unordered_set(hasher, eqComp)), _source(source) {}
+				: _source(source)
+			{
+				auto elements = from(container);
+				auto set = std::make_shared<FlatHashSet<TElem, THasher, TEqComp>>(hasher, eqComp, size_hint(elements));
+				for (auto enumerator = elements->getEnumerator(); enumerator->next();)
+					set->insert(enumerator->current());
+				_set = set;
+			}
 
 			std::shared_ptr<IEnumerator<TElem>> createEnumerator() override
 			{
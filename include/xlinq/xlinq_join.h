@@ -29,10 +29,38 @@ SOFTWARE.
 #ifndef XLINQ_JOIN_H_
 #define XLINQ_JOIN_H_
 
+#include "xlinq_base.h"
+#include "xlinq_exception.h"
+#include "xlinq_from.h"
 #include "xlinq_group_by.h"
+#include "xlinq_lookup.h"
+#include "xlinq_parallel.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace xlinq
 {
+	/**
+	*	Execution strategy of join.
+	*	It may be passed to strategy method of builder returned by join.
+	*/
+	enum class JoinStrategy
+	{
+		/**
+		*	Hash table is built from one collection and probed with elements of the other one.
+		*/
+		HASH,
+		/**
+		*	Both collections are radix partitioned by key hash and partitions are joined in parallel.
+		*/
+		PARTITIONED
+	};
+
 	/*@cond XLINQ_INTERNAL*/
 	namespace internal
 	{
@@ -49,172 +77,279 @@ namespace xlinq
 			typedef typename binaryreturntype<TResultSelector, InnerElemType, OuterElemType>::type TResult;
 		};
 
-		template<typename TOuter, typename TOuterKeySelector, typename TInnerKey, typename TOuterKey, typename TInnerElem, typename TOuterElem, typename TResultSelector, typename TResult,
-			typename TKeyEqComp, typename TOuterHasher, typename TOuterEqComp>
-		class JoinLookup
+		template<typename TKeyEqComp>
+		class _SwappedKeyEqComp
 		{
 		private:
-			TOuter _outer;
-			std::shared_ptr<IEnumerator<std::shared_ptr<IGrouping<TInnerKey, TInnerElem>>>> _innerGroupEnumerator;
-			std::shared_ptr<IEnumerator<std::shared_ptr<IGrouping<TOuterKey, TOuterElem>>>> _outerGroupEnumerator;
-			std::unordered_map<TOuterKey, std::shared_ptr<IEnumerable<TOuterElem>>, TOuterHasher, TOuterEqComp> _outerSkipped;
-			TResultSelector _resultSelector;
-			std::list<TResult> _result;
 			TKeyEqComp _keyEqComp;
-
 		public:
-			JoinLookup(std::shared_ptr<IEnumerator<std::shared_ptr<IGrouping<TInnerKey, TInnerElem>>>> innerGroupEnumerator,
-				TOuter outer, TOuterKeySelector outerKeySelector, TResultSelector resultSelector, TKeyEqComp keyEqComp, TOuterHasher outerHasher, TOuterEqComp outerEqComp)
-				: _outer(outer), _innerGroupEnumerator(innerGroupEnumerator), 
-				_outerGroupEnumerator(from(_outer) >> group_by(outerKeySelector, outerHasher, outerEqComp) >> getEnumerator()), _outerSkipped(std::unordered_map<TOuterKey, std::shared_ptr<IEnumerable<TOuterElem>>, TOuterHasher, TOuterEqComp>()), _resultSelector(resultSelector), _result(std::list<TResult>()),
-				_keyEqComp(keyEqComp)
-			{
-			}
+			_SwappedKeyEqComp(TKeyEqComp keyEqComp) : _keyEqComp(keyEqComp) {}
 
-			bool finished()
+			template<typename TFirst, typename TSecond>
+			bool operator()(const TFirst& first, const TSecond& second)
 			{
-				return !_innerGroupEnumerator && !_outerGroupEnumerator;
+				return _keyEqComp(second, first);
 			}
-
-			bool next()
-			{
-				if (finished()) return false;
-				while (_innerGroupEnumerator && _innerGroupEnumerator->next())
-				{
-					auto current = _innerGroupEnumerator->current();
-					auto outerCurrent = _outerSkipped.find(current->getKey());
-					if (outerCurrent != _outerSkipped.end())
-					{
-						for (auto inIt = current->getEnumerator(); inIt->next();)
-						{
-							for (auto it = (*outerCurrent).second->getEnumerator(); it->next();)
-							{
-								_result.push_back(_resultSelector(inIt->current(), it->current()));
-							}
-						}
-						_outerSkipped.erase(current->getKey());
-						return true;
-					}
-					else
-					{
-						while (_outerGroupEnumerator && _outerGroupEnumerator->next())
-						{
-							if (_keyEqComp(current->getKey(), _outerGroupEnumerator->current()->getKey()))
-							{
-								for (auto inIt = current->getEnumerator(); inIt->next();)
-								{
-									for (auto it = _outerGroupEnumerator->current()->getEnumerator(); it->next();)
-									{
-										_result.push_back(_resultSelector(inIt->current(), it->current()));
-									}
-								}
-								return true;
-							}
-							else
-							{
-								_outerSkipped.insert({ _outerGroupEnumerator->current()->getKey(), _outerGroupEnumerator->current() });
-							}
-						}
-						_outerGroupEnumerator = nullptr;
-					}
-				}
-				_innerGroupEnumerator = nullptr;
-				_outerSkipped.clear();
-				return false;
-			}
-
-			typename std::list<TResult>::const_iterator begin() { return _result.begin(); }
-
-			typename std::list<TResult>::const_iterator end() { return _result.end(); }
 		};
 
-		template<typename LookupType, typename TResult>
-		class _JoinEnumerator : public IEnumerator<TResult>
+		template<typename TProbeElem, typename TBuildElem, typename TProbeKeySelector, typename TBuildKeySelector, typename TBuildKey, typename TBuildHasher, typename TBuildEqComp,
+			typename TProbeEqComp, typename TResultSelector, typename TResult, bool BUILD_INNER>
+		class _HashJoinEnumerator : public IEnumerator<TResult>
 		{
 		private:
+			typedef FlatLookup<TBuildKey, TBuildElem, TBuildHasher, TBuildEqComp> LookupType;
+			std::shared_ptr<void> _owner;
+			std::shared_ptr<IEnumerable<TBuildElem>> _build;
+			TBuildKeySelector _buildKeySelector;
+			TBuildHasher _buildHasher;
+			TBuildEqComp _buildEqComp;
 			std::shared_ptr<LookupType> _lookup;
-			typename std::list<TResult>::const_iterator _it;
+			std::shared_ptr<IEnumerator<TProbeElem>> _probe;
+			TProbeKeySelector _probeKeySelector;
+			TProbeEqComp _probeEqComp;
+			TResultSelector _resultSelector;
+			int _index;
+			int _end;
 			bool _started;
 			bool _finished;
 
+			TResult result(const TProbeElem& probe, const TBuildElem& build, std::true_type)
+			{
+				return _resultSelector(build, probe);
+			}
+
+			TResult result(const TProbeElem& probe, const TBuildElem& build, std::false_type)
+			{
+				return _resultSelector(probe, build);
+			}
+
 		public:
-			_JoinEnumerator(std::shared_ptr<LookupType> lookup)
-				: _lookup(lookup), _it(lookup->begin()), _started(false), _finished(false) {}
+			_HashJoinEnumerator(std::shared_ptr<void> owner, std::shared_ptr<IEnumerable<TBuildElem>> build, TBuildKeySelector buildKeySelector, TBuildHasher buildHasher, TBuildEqComp buildEqComp,
+				std::shared_ptr<IEnumerator<TProbeElem>> probe, TProbeKeySelector probeKeySelector, TProbeEqComp probeEqComp, TResultSelector resultSelector)
+				: _owner(owner), _build(build), _buildKeySelector(buildKeySelector), _buildHasher(buildHasher), _buildEqComp(buildEqComp),
+				_probe(probe), _probeKeySelector(probeKeySelector), _probeEqComp(probeEqComp), _resultSelector(resultSelector),
+				_index(0), _end(0), _started(false), _finished(false) {}
 
-			bool next()
+			bool next() override
 			{
 				if (_finished) throw IterationFinishedException();
-				auto itn = _it;
-				auto ite = _lookup->end();
-				if (!_started)
-					_it = _lookup->begin();
-				if ((_it == ite) || (_started && (++itn == ite)))
+				if (!_lookup)
 				{
-					if (!_lookup->finished() && _lookup->next())
-					{
-						if (!_started)
-							_it = _lookup->begin();
-						else ++_it;
-						_started = true;
-						return true;
-					}
-					_finished = true;
-					_started = true;
-					return false;
+					auto random = std::dynamic_pointer_cast<IRandomAccessEnumerable<TBuildElem>>(_build);
+					_lookup = std::shared_ptr<LookupType>(new LookupType(_build->getEnumerator(), _buildKeySelector, _buildHasher, _buildEqComp, random ? random->size() : 0));
 				}
-				else if (_started)
-					++_it;
 				_started = true;
-				return true;
+				if (++_index < _end)
+					return true;
+				while (_probe->next())
+				{
+					int group = _lookup->find(current_key(), _probeEqComp);
+					if (group < 0)
+						continue;
+					_index = _lookup->begin(group);
+					_end = _lookup->end(group);
+					return true;
+				}
+				_finished = true;
+				return false;
 			}
 
-			TResult current()
+			typename std::decay<typename unaryreturntype<TProbeKeySelector, TProbeElem>::type>::type current_key()
+			{
+				const TProbeElem* ptr = _probe->current_ptr();
+				return ptr ? _probeKeySelector(*ptr) : _probeKeySelector(_probe->current());
+			}
+
+			TResult current() override
 			{
 				if (_finished) throw IterationFinishedException();
 				if (!_started) throw IterationNotStartedException();
-				return *_it;
+				const TProbeElem* ptr = _probe->current_ptr();
+				if (ptr)
+					return result(*ptr, _lookup->at(_index), std::integral_constant<bool, BUILD_INNER>());
+				return result(_probe->current(), _lookup->at(_index), std::integral_constant<bool, BUILD_INNER>());
 			}
 
 			bool equals(std::shared_ptr<IEnumerator<TResult>> other) const override
 			{
-				auto pother = std::dynamic_pointer_cast<_JoinEnumerator<LookupType, TResult>>(other);
+				auto pother = std::dynamic_pointer_cast<_HashJoinEnumerator<TProbeElem, TBuildElem, TProbeKeySelector, TBuildKeySelector, TBuildKey, TBuildHasher, TBuildEqComp,
+					TProbeEqComp, TResultSelector, TResult, BUILD_INNER>>(other);
 				if (!pother)
 					return false;
-				return this->_it == pother->_it && // enough to compare iterator
+				return this->_index == pother->_index &&
 					this->_started == pother->_started &&
-					this->_finished == pother->_finished;
+					this->_finished == pother->_finished &&
+					this->_probe->equals(pother->_probe);
 			}
 
 			std::shared_ptr<IEnumerator<TResult>> clone() const override
 			{
-				auto ptr = new _JoinEnumerator<LookupType, TResult>(this->_lookup);
-				ptr->_it = this->_it;
-				ptr->_started = this->_started;
-				ptr->_finished = this->_finished;
+				auto ptr = new _HashJoinEnumerator<TProbeElem, TBuildElem, TProbeKeySelector, TBuildKeySelector, TBuildKey, TBuildHasher, TBuildEqComp,
+					TProbeEqComp, TResultSelector, TResult, BUILD_INNER>(*this);
+				ptr->_probe = this->_probe->clone();
 				return std::shared_ptr<IEnumerator<TResult>>(ptr);
 			}
 		};
 
+		template<typename TElem, typename TKey>
+		class _JoinPartitions
+		{
+		public:
+			std::vector<TElem> elements;
+			std::vector<TKey> keys;
+			std::vector<std::uint64_t> hashes;
+			std::vector<int> offsets;
+
+			template<typename TKeySelector, typename THasher>
+			_JoinPartitions(std::vector<TElem>& source, TKeySelector keySelector, THasher hasher, int bits)
+			{
+				int count = 1 << bits;
+				std::vector<TKey> sourceKeys;
+				std::vector<std::uint64_t> sourceHashes;
+				sourceKeys.reserve(source.size());
+				sourceHashes.reserve(source.size());
+				offsets.assign(count + 1, 0);
+				for (auto& elem : source)
+				{
+					sourceKeys.push_back(keySelector(elem));
+					sourceHashes.push_back(mix_hash((std::size_t)hasher(sourceKeys.back())));
+					++offsets[partition_of(sourceHashes.back(), bits) + 1];
+				}
+				for (int i = 0; i < count; ++i)
+					offsets[i + 1] += offsets[i];
+
+				std::vector<int> order(source.size());
+				std::vector<int> cursors(offsets.begin(), offsets.end() - 1);
+				for (int i = 0; i < (int)source.size(); ++i)
+					order[cursors[partition_of(sourceHashes[i], bits)]++] = i;
+				elements.reserve(source.size());
+				keys.reserve(source.size());
+				hashes.reserve(source.size());
+				for (int index : order)
+				{
+					elements.push_back(std::move(source[index]));
+					keys.push_back(std::move(sourceKeys[index]));
+					hashes.push_back(sourceHashes[index]);
+				}
+			}
+
+			static int partition_of(std::uint64_t hash, int bits)
+			{
+				return bits ? (int)(hash >> (64 - bits)) : 0;
+			}
+		};
+
+		template<typename TProbeElem, typename TProbeKey, typename TBuildElem, typename TBuildKey, typename TProbeEqComp, typename TEmit>
+		void join_partition(const _JoinPartitions<TProbeElem, TProbeKey>& probe, const _JoinPartitions<TBuildElem, TBuildKey>& build, int partition, TProbeEqComp eqComp, TEmit emit)
+		{
+			int buildBegin = build.offsets[partition], buildEnd = build.offsets[partition + 1];
+			int probeBegin = probe.offsets[partition], probeEnd = probe.offsets[partition + 1];
+			if (buildBegin == buildEnd || probeBegin == probeEnd)
+				return;
+			std::size_t size = 16;
+			while (size < 2 * (std::size_t)(buildEnd - buildBegin))
+				size *= 2;
+			std::size_t mask = size - 1;
+			std::vector<int> slots(size, -1);
+			for (int i = buildBegin; i < buildEnd; ++i)
+			{
+				std::size_t slot = (std::size_t)build.hashes[i] & mask;
+				while (slots[slot] >= 0)
+					slot = (slot + 1) & mask;
+				slots[slot] = i;
+			}
+			for (int i = probeBegin; i < probeEnd; ++i)
+			{
+				for (std::size_t slot = (std::size_t)probe.hashes[i] & mask; slots[slot] >= 0; slot = (slot + 1) & mask)
+				{
+					int match = slots[slot];
+					if (build.hashes[match] == probe.hashes[i] && eqComp(probe.keys[i], build.keys[match]))
+						emit(probe.elements[i], build.elements[match]);
+				}
+			}
+		}
+
 		template<typename TOuter, typename TKeySelector, typename TOuterKeySelector, typename TResultSelector, typename TInnerKey, typename TOuterKey, typename TInnerElem, typename TOuterElem, typename TResult, 
 			typename TKeyEqComp, typename TInnerHasher, typename TInnerEqComp, typename TOuterHasher, typename TOuterEqComp>
 		class _JoinEnumerable : public IEnumerable<TResult>
 		{
 		private:
-			typedef JoinLookup<TOuter, TOuterKeySelector, TInnerKey, TOuterKey, TInnerElem, TOuterElem, TResultSelector, TResult, TKeyEqComp, TOuterHasher, TOuterEqComp> LookupType;
-			std::shared_ptr<LookupType> _lookup;
+			std::shared_ptr<IEnumerable<TInnerElem>> _inner;
+			std::shared_ptr<TOuter> _outer;
+			TKeySelector _keySelector;
+			TOuterKeySelector _outerKeySelector;
+			TResultSelector _resultSelector;
+			TKeyEqComp _keyEqComp;
+			TInnerHasher _innerHasher;
+			TInnerEqComp _innerEqComp;
+			TOuterHasher _outerHasher;
+			TOuterEqComp _outerEqComp;
+			JoinStrategy _strategy;
+
+			std::shared_ptr<IEnumerator<TResult>> createPartitionedEnumerator()
+			{
+				typedef typename std::decay<TInnerKey>::type TInnerKeyValue;
+				typedef typename std::decay<TOuterKey>::type TOuterKeyValue;
+				std::vector<TInnerElem> innerElements;
+				std::vector<TOuterElem> outerElements;
+				auto inner = _inner->getEnumerator();
+				while (inner->next_batch(innerElements, XLINQ_BATCH_SIZE) == XLINQ_BATCH_SIZE);
+				auto outer = from(*_outer)->getEnumerator();
+				while (outer->next_batch(outerElements, XLINQ_BATCH_SIZE) == XLINQ_BATCH_SIZE);
+
+				int bits = 0;
+				std::size_t smaller = std::min(innerElements.size(), outerElements.size());
+				while (bits < 16 && ((std::size_t)XLINQ_JOIN_PARTITION_SIZE << bits) < smaller)
+					++bits;
+				_JoinPartitions<TInnerElem, TInnerKeyValue> innerPartitions(innerElements, _keySelector, _innerHasher, bits);
+				_JoinPartitions<TOuterElem, TOuterKeyValue> outerPartitions(outerElements, _outerKeySelector, _outerHasher, bits);
+
+				int count = 1 << bits;
+				std::vector<std::vector<TResult>> results(count);
+				bool buildInner = innerElements.size() < outerElements.size();
+				auto resultSelector = _resultSelector;
+				auto keyEqComp = _keyEqComp;
+				_WorkStealingPool::instance().parallel_for(count, [&](int partition)
+				{
+					auto& result = results[partition];
+					if (buildInner)
+						join_partition(outerPartitions, innerPartitions, partition, _SwappedKeyEqComp<TKeyEqComp>(keyEqComp),
+							[&](const TOuterElem& outer, const TInnerElem& inner) { result.push_back(resultSelector(inner, outer)); });
+					else join_partition(innerPartitions, outerPartitions, partition, keyEqComp,
+							[&](const TInnerElem& inner, const TOuterElem& outer) { result.push_back(resultSelector(inner, outer)); });
+				});
+
+				auto joined = std::make_shared<std::vector<TResult>>();
+				std::size_t size = 0;
+				for (auto& result : results)
+					size += result.size();
+				joined->reserve(size);
+				for (auto& result : results)
+					for (auto&& elem : result)
+						joined->push_back(std::move(elem));
+				return from(joined)->getEnumerator();
+			}
 
 		public:
-			_JoinEnumerable(std::shared_ptr<IEnumerable<TInnerElem>> inner, TOuter outer, TKeySelector keySelector, TOuterKeySelector outerKeySelector, TResultSelector resultSelector, TKeyEqComp keyEqComp, TInnerHasher innerHasher, TInnerEqComp innerEqComp, TOuterHasher outerHasher, TOuterEqComp outerEqComp)
-				: _lookup(new LookupType(
-					(inner >> group_by(keySelector, innerHasher, innerEqComp))->getEnumerator(),
-					outer,
-					outerKeySelector,
-					resultSelector, keyEqComp, outerHasher, outerEqComp))
+			_JoinEnumerable(std::shared_ptr<IEnumerable<TInnerElem>> inner, TOuter outer, TKeySelector keySelector, TOuterKeySelector outerKeySelector, TResultSelector resultSelector, TKeyEqComp keyEqComp, TInnerHasher innerHasher, TInnerEqComp innerEqComp, TOuterHasher outerHasher, TOuterEqComp outerEqComp, JoinStrategy strategy)
+				: _inner(inner), _outer(std::make_shared<TOuter>(outer)), _keySelector(keySelector), _outerKeySelector(outerKeySelector), _resultSelector(resultSelector),
+				_keyEqComp(keyEqComp), _innerHasher(innerHasher), _innerEqComp(innerEqComp), _outerHasher(outerHasher), _outerEqComp(outerEqComp), _strategy(strategy)
 			{}
 
 			std::shared_ptr<IEnumerator<TResult>> createEnumerator() override
 			{
-				return std::shared_ptr<IEnumerator<TResult>>(new _JoinEnumerator<LookupType, TResult>(_lookup));
+				if (_strategy == JoinStrategy::PARTITIONED)
+					return createPartitionedEnumerator();
+				std::shared_ptr<IEnumerable<TOuterElem>> outer = from(*_outer);
+				auto innerRandom = std::dynamic_pointer_cast<IRandomAccessEnumerable<TInnerElem>>(_inner);
+				auto outerRandom = std::dynamic_pointer_cast<IRandomAccessEnumerable<TOuterElem>>(outer);
+				if (innerRandom && outerRandom && innerRandom->size() < outerRandom->size())
+					return std::shared_ptr<IEnumerator<TResult>>(new _HashJoinEnumerator<TOuterElem, TInnerElem, TOuterKeySelector, TKeySelector, TInnerKey, TInnerHasher, TInnerEqComp,
+						_SwappedKeyEqComp<TKeyEqComp>, TResultSelector, TResult, true>(_outer, _inner, _keySelector, _innerHasher, _innerEqComp,
+						outer->getEnumerator(), _outerKeySelector, _SwappedKeyEqComp<TKeyEqComp>(_keyEqComp), _resultSelector));
+				return std::shared_ptr<IEnumerator<TResult>>(new _HashJoinEnumerator<TInnerElem, TOuterElem, TKeySelector, TOuterKeySelector, TOuterKey, TOuterHasher, TOuterEqComp,
+					TKeyEqComp, TResultSelector, TResult, false>(_outer, outer, _outerKeySelector, _outerHasher, _outerEqComp,
+					_inner->getEnumerator(), _keySelector, _keyEqComp, _resultSelector));
 			}
 		};
 
@@ -231,11 +366,19 @@ namespace xlinq
 			TInnerEqComp _innerEqComp;
 			TOuterHasher _outerHasher;
 			TOuterEqComp _outerEqComp;
+			JoinStrategy _strategy;
 		public:
 			_JoinBuilderFull(TOuter outer, TKeySelector keySelector, TOuterKeySelector outerKeySelector, TResultSelector resultSelector, TKeyEqComp keyEqComp, TInnerHasher innerHasher, TInnerEqComp innerEqComp, TOuterHasher outerHasher, TOuterEqComp outerEqComp)
-				: _outer(outer), _keySelector(keySelector), _outerKeySelector(outerKeySelector), _resultSelector(resultSelector), _keyEqComp(keyEqComp), _innerHasher(innerHasher), _innerEqComp(innerEqComp), _outerHasher(outerHasher), _outerEqComp(outerEqComp)
+				: _outer(outer), _keySelector(keySelector), _outerKeySelector(outerKeySelector), _resultSelector(resultSelector), _keyEqComp(keyEqComp), _innerHasher(innerHasher), _innerEqComp(innerEqComp), _outerHasher(outerHasher), _outerEqComp(outerEqComp), _strategy(JoinStrategy::HASH)
 			{}
 
+			_JoinBuilderFull strategy(JoinStrategy strategy) const
+			{
+				auto builder = *this;
+				builder._strategy = strategy;
+				return builder;
+			}
+
 			template<typename TElem>
 			auto build(std::shared_ptr<IEnumerable<TElem>> inner) -> 
 				std::shared_ptr<IEnumerable<typename JoinTypeSelector<decltype(inner), TOuter, TKeySelector, TOuterKeySelector, TResultSelector>::TResult>>
@@ -246,7 +389,7 @@ namespace xlinq
 				typedef typename JoinTypeSelector<decltype(inner), TOuter, TKeySelector, TOuterKeySelector, TResultSelector>::OuterElemType TOuterElem;
 				typedef typename JoinTypeSelector<decltype(inner), TOuter, TKeySelector, TOuterKeySelector, TResultSelector>::TResult TResult;
 				return std::shared_ptr<IEnumerable<typename JoinTypeSelector<std::shared_ptr<IEnumerable<TElem>>, TOuter, TKeySelector, TOuterKeySelector, TResultSelector>::TResult>>
-					(new _JoinEnumerable<TOuter, TKeySelector, TOuterKeySelector, TResultSelector, TInnerKey, TOuterKey, TInnerElem, TOuterElem, TResult, TKeyEqComp, TInnerHasher, TInnerEqComp, TOuterHasher, TOuterEqComp>(inner, _outer, _keySelector, _outerKeySelector, _resultSelector, _keyEqComp, _innerHasher, _innerEqComp, _outerHasher, _outerEqComp));
+					(new _JoinEnumerable<TOuter, TKeySelector, TOuterKeySelector, TResultSelector, TInnerKey, TOuterKey, TInnerElem, TOuterElem, TResult, TKeyEqComp, TInnerHasher, TInnerEqComp, TOuterHasher, TOuterEqComp>(inner, _outer, _keySelector, _outerKeySelector, _resultSelector, _keyEqComp, _innerHasher, _innerEqComp, _outerHasher, _outerEqComp, _strategy));
 			}
 
 			template<typename TElem>
@@ -272,11 +415,19 @@ namespace xlinq
 			TKeySelector _keySelector;
 			TOuterKeySelector _outerKeySelector;
 			TResultSelector _resultSelector;
+			JoinStrategy _strategy;
 		public:
 			_JoinBuilder(TOuter outer, TKeySelector keySelector, TOuterKeySelector outerKeySelector, TResultSelector resultSelector)
-				: _outer(outer), _keySelector(keySelector), _outerKeySelector(outerKeySelector), _resultSelector(resultSelector)
+				: _outer(outer), _keySelector(keySelector), _outerKeySelector(outerKeySelector), _resultSelector(resultSelector), _strategy(JoinStrategy::HASH)
 			{}
 
+			_JoinBuilder strategy(JoinStrategy strategy) const
+			{
+				auto builder = *this;
+				builder._strategy = strategy;
+				return builder;
+			}
+
 			template<typename TElem>
 			auto build(std::shared_ptr<IEnumerable<TElem>> inner) ->
 				std::shared_ptr<IEnumerable<typename JoinTypeSelector<decltype(inner), TOuter, TKeySelector, TOuterKeySelector, TResultSelector>::TResult>>
@@ -293,7 +444,7 @@ namespace xlinq
 				typedef typename std::equal_to<TOuterKey> TOuterEqComp;
 				return std::shared_ptr<IEnumerable<typename JoinTypeSelector<std::shared_ptr<IEnumerable<TElem>>, TOuter, TKeySelector, TOuterKeySelector, TResultSelector>::TResult>>
 					(new _JoinEnumerable<TOuter, TKeySelector, TOuterKeySelector, TResultSelector, TInnerKey, TOuterKey, TInnerElem, TOuterElem, TResult, TKeyEqComp, TInnerHasher, TInnerEqComp, TOuterHasher, TOuterEqComp>
-					(inner, _outer, _keySelector, _outerKeySelector, _resultSelector, TKeyEqComp(), TInnerHasher(), TInnerEqComp(), TOuterHasher(), TOuterEqComp()));
+					(inner, _outer, _keySelector, _outerKeySelector, _resultSelector, TKeyEqComp(), TInnerHasher(), TInnerEqComp(), TOuterHasher(), TOuterEqComp(), _strategy));
 			}
 
 			template<typename TElem>
@@ -320,11 +471,19 @@ namespace xlinq
 			TOuterKeySelector _outerKeySelector;
 			TResultSelector _resultSelector;
 			TKeyEqComp _keyEqComp;
+			JoinStrategy _strategy;
 		public:
 			_JoinBuilderWithKeyComp(TOuter outer, TKeySelector keySelector, TOuterKeySelector outerKeySelector, TResultSelector resultSelector, TKeyEqComp keyEqComp)
-				: _outer(outer), _keySelector(keySelector), _outerKeySelector(outerKeySelector), _resultSelector(resultSelector), _keyEqComp(keyEqComp)
+				: _outer(outer), _keySelector(keySelector), _outerKeySelector(outerKeySelector), _resultSelector(resultSelector), _keyEqComp(keyEqComp), _strategy(JoinStrategy::HASH)
 			{}
 
+			_JoinBuilderWithKeyComp strategy(JoinStrategy strategy) const
+			{
+				auto builder = *this;
+				builder._strategy = strategy;
+				return builder;
+			}
+
 			template<typename TElem>
 			auto build(std::shared_ptr<IEnumerable<TElem>> inner) ->
 				std::shared_ptr<IEnumerable<typename JoinTypeSelector<decltype(inner), TOuter, TKeySelector, TOuterKeySelector, TResultSelector>::TResult>>
@@ -340,7 +499,7 @@ namespace xlinq
 				typedef typename std::equal_to<TOuterKey> TOuterEqComp;
 				return std::shared_ptr<IEnumerable<typename JoinTypeSelector<std::shared_ptr<IEnumerable<TElem>>, TOuter, TKeySelector, TOuterKeySelector, TResultSelector>::TResult>>
 					(new _JoinEnumerable<TOuter, TKeySelector, TOuterKeySelector, TResultSelector, TInnerKey, TOuterKey, TInnerElem, TOuterElem, TResult, TKeyEqComp, TInnerHasher, TInnerEqComp, TOuterHasher, TOuterEqComp>
-					(inner, _outer, _keySelector, _outerKeySelector, _resultSelector, _keyEqComp, TInnerHasher(), TInnerEqComp(), TOuterHasher(), TOuterEqComp()));
+					(inner, _outer, _keySelector, _outerKeySelector, _resultSelector, _keyEqComp, TInnerHasher(), TInnerEqComp(), TOuterHasher(), TOuterEqComp(), _strategy));
 			}
 
 			template<typename TElem>
@@ -365,6 +524,18 @@ namespace xlinq
 	*	This function may be used to correlate elements of two collection
 	*	when theirs' keys match. Specified functions are used to extract
 	*	keys from collection elements.
+	*	Join is evaluated as hash join. On first enumeration the smaller collection
+	*	is read whole into flat hash table, which is then probed with elements of
+	*	the other one streamed one by one. Inner collection is used as the smaller one
+	*	only when both collections are random access and it has fewer elements,
+	*	otherwise hash table is built from outer collection. Results follow order of
+	*	probing collection and, for equal keys, order of elements of the other one,
+	*	so they follow outer collection when hash table is built from inner one.
+	*	Calling strategy(JoinStrategy::PARTITIONED) on returned builder makes join
+	*	read both collections whole, split them by key hash into partitions small
+	*	enough to fit in cache, and join partition pairs in parallel. Results are then
+	*	ordered by partition, and selectors, hashers and comparers have to be safe to
+	*	call concurrently.
 	*	@param outer Outer collection to join.
 	*	@param keySelector Function selecting key from inner collection.
 	*	@param outerKeySelector Function selecting key from outer collection.
@@ -32,10 +32,12 @@ SOFTWARE.
 #include "xlinq_base.h"
 #include "xlinq_exception.h"
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <unordered_map>
 #include <list>
 #include <utility>
+#include <vector>
 
 namespace xlinq
 {
@@ -144,6 +146,115 @@ namespace xlinq
 				return getElementsFor(key)->end();
 			}
 		};
+
+		template<typename TKey, typename TElem, typename THasher, typename TEqComp>
+		class FlatLookup
+		{
+		private:
+			THasher _hasher;
+			TEqComp _eqComp;
+			std::vector<TKey> _keys;
+			std::vector<std::uint64_t> _hashes;
+			std::vector<int> _slots;
+			std::vector<int> _offsets;
+			std::vector<TElem> _elements;
+
+			template<typename TProbe, typename TProbeEqComp>
+			std::size_t probe(const TProbe& key, std::uint64_t hash, TProbeEqComp& eqComp) const
+			{
+				std::size_t mask = _slots.size() - 1;
+				for (std::size_t slot = (std::size_t)hash & mask;; slot = (slot + 1) & mask)
+				{
+					int group = _slots[slot] - 1;
+					if (group < 0 || (_hashes[group] == hash && eqComp(key, _keys[group])))
+						return slot;
+				}
+			}
+
+			void grow()
+			{
+				std::vector<int> slots(_slots.size() * 2, 0);
+				std::size_t mask = slots.size() - 1;
+				for (int group = 0; group < (int)_keys.size(); ++group)
+				{
+					std::size_t slot = (std::size_t)_hashes[group] & mask;
+					while (slots[slot])
+						slot = (slot + 1) & mask;
+					slots[slot] = group + 1;
+				}
+				_slots.swap(slots);
+			}
+
+			int add(const TKey& key)
+			{
+				std::uint64_t hash = mix_hash((std::size_t)_hasher(key));
+				std::size_t slot = probe(key, hash, _eqComp);
+				if (_slots[slot])
+					return _slots[slot] - 1;
+				int group = (int)_keys.size();
+				_keys.push_back(key);
+				_hashes.push_back(hash);
+				_slots[slot] = group + 1;
+				if (_keys.size() * 2 > _slots.size())
+					grow();
+				return group;
+			}
+
+		public:
+			template<typename TKeySelector>
+			FlatLookup(std::shared_ptr<IEnumerator<TElem>> enumerator, TKeySelector keySelector, THasher hasher, TEqComp eqComp, int sizeHint = 0)
+				: _hasher(hasher), _eqComp(eqComp), _slots(16, 0)
+			{
+				std::vector<TElem> source;
+				source.reserve(sizeHint);
+				while (enumerator->next_batch(source, XLINQ_BATCH_SIZE) == XLINQ_BATCH_SIZE);
+
+				std::vector<int> groups;
+				groups.reserve(source.size());
+				for (auto& elem : source)
+					groups.push_back(add(keySelector(elem)));
+
+				_offsets.assign(_keys.size() + 1, 0);
+				for (int group : groups)
+					++_offsets[group + 1];
+				for (std::size_t i = 1; i < _offsets.size(); ++i)
+					_offsets[i] += _offsets[i - 1];
+
+				std::vector<int> order(source.size());
+				std::vector<int> cursors(_offsets.begin(), _offsets.end() - 1);
+				for (std::size_t i = 0; i < groups.size(); ++i)
+					order[cursors[groups[i]]++] = (int)i;
+				_elements.reserve(source.size());
+				for (int index : order)
+					_elements.push_back(std::move(source[index]));
+			}
+
+			THasher getHasher() const { return _hasher; }
+
+			TEqComp getComparer() const { return _eqComp; }
+
+			int groupCount() const { return (int)_keys.size(); }
+
+			typename std::vector<TKey>::const_reference key(int group) const { return _keys[group]; }
+
+			int begin(int group) const { return _offsets[group]; }
+
+			int end(int group) const { return _offsets[group + 1]; }
+
+			typename std::vector<TElem>::const_reference at(int index) const { return _elements[index]; }
+
+			int find(const TKey& key) const
+			{
+				TEqComp eqComp = _eqComp;
+				return find(key, eqComp);
+			}
+
+			template<typename TProbe, typename TProbeEqComp>
+			int find(const TProbe& key, TProbeEqComp eqComp) const
+			{
+				return _slots[probe(key, mix_hash((std::size_t)_hasher(key)), eqComp)] - 1;
+			}
+		};
 	}
 	/*@endcond*/
 }
@@ -0,0 +1,419 @@
+/*
+MIT License
+
+Copyright (c) 2017 TrolleY
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+*	@file xlinq_merge_join.h
+*	Correlating elements of two collections sorted by common key.
+*	@author TrolleY
+*/
+#ifndef XLINQ_MERGE_JOIN_H_
+#define XLINQ_MERGE_JOIN_H_
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "xlinq_base.h"
+#include "xlinq_exception.h"
+#include "xlinq_from.h"
+
+namespace xlinq
+{
+	/*@cond XLINQ_INTERNAL*/
+	namespace internal
+	{
+		class _MergeJoinKeyLess
+		{
+		public:
+			template<typename TFirst, typename TSecond>
+			bool operator()(const TFirst& first, const TSecond& second) const
+			{
+				return first < second;
+			}
+		};
+
+		template<typename TResultSelector, typename TInnerElem, typename TOuterElem, bool OUTER>
+		struct _MergeJoinResult
+		{
+			typedef typename binaryreturntype<TResultSelector, TInnerElem, TOuterElem>::type type;
+		};
+
+		template<typename TResultSelector, typename TInnerElem, typename TOuterElem>
+		struct _MergeJoinResult<TResultSelector, TInnerElem, TOuterElem, true>
+		{
+			typedef typename binaryreturntype<TResultSelector, const TInnerElem*, const TOuterElem*>::type type;
+		};
+
+		template<typename TInnerElem, typename TOuterElem, typename TKeySelector, typename TOuterKeySelector, typename TResultSelector, typename TKeyComparer, typename TResult, bool LEFT_OUTER, bool RIGHT_OUTER>
+		class _MergeJoinEnumerator : public IEnumerator<TResult>
+		{
+		private:
+			enum Kind { PRODUCT, INNER_ONLY, OUTER_ONLY };
+
+			std::shared_ptr<void> _owner;
+			std::shared_ptr<IEnumerator<TInnerElem>> _inner;
+			std::shared_ptr<IEnumerator<TOuterElem>> _outer;
+			TKeySelector _keySelector;
+			TOuterKeySelector _outerKeySelector;
+			TResultSelector _resultSelector;
+			TKeyComparer _keyComparer;
+			std::vector<TOuterElem> _run;
+			int _index;
+			Kind _kind;
+			bool _hasInner;
+			bool _hasOuter;
+			bool _started;
+			bool _finished;
+
+			typename std::decay<typename unaryreturntype<TKeySelector, TInnerElem>::type>::type inner_key()
+			{
+				const TInnerElem* ptr = _inner->current_ptr();
+				return ptr ? _keySelector(*ptr) : _keySelector(_inner->current());
+			}
+
+			typename std::decay<typename unaryreturntype<TOuterKeySelector, TOuterElem>::type>::type outer_key()
+			{
+				const TOuterElem* ptr = _outer->current_ptr();
+				return ptr ? _outerKeySelector(*ptr) : _outerKeySelector(_outer->current());
+			}
+
+			bool inner_matches_run()
+			{
+				auto key = inner_key();
+				auto runKey = _outerKeySelector(_run.front());
+				return !_keyComparer(key, runKey) && !_keyComparer(runKey, key);
+			}
+
+			bool fetch()
+			{
+				while (_hasInner || _hasOuter)
+				{
+					if (_hasInner && (!_hasOuter || _keyComparer(inner_key(), outer_key())))
+					{
+						_kind = INNER_ONLY;
+						if (LEFT_OUTER)
+							return true;
+						_hasInner = _inner->next();
+					}
+					else if (_hasOuter && (!_hasInner || _keyComparer(outer_key(), inner_key())))
+					{
+						_kind = OUTER_ONLY;
+						if (RIGHT_OUTER)
+							return true;
+						_hasOuter = _outer->next();
+					}
+					else
+					{
+						auto runKey = outer_key();
+						_run.clear();
+						do
+						{
+							_run.push_back(_outer->current());
+							_hasOuter = _outer->next();
+						} while (_hasOuter && !_keyComparer(runKey, outer_key()));
+						_index = 0;
+						_kind = PRODUCT;
+						return true;
+					}
+				}
+				return false;
+			}
+
+			TResult product(const TInnerElem& inner, std::false_type)
+			{
+				return _resultSelector(inner, _run[_index]);
+			}
+
+			TResult product(const TInnerElem& inner, std::true_type)
+			{
+				return _resultSelector(&inner, &_run[_index]);
+			}
+
+			TResult current_product()
+			{
+				const TInnerElem* ptr = _inner->current_ptr();
+				if (ptr)
+					return product(*ptr, std::integral_constant<bool, LEFT_OUTER || RIGHT_OUTER>());
+				return product(_inner->current(), std::integral_constant<bool, LEFT_OUTER || RIGHT_OUTER>());
+			}
+
+			TResult current_unmatched(std::false_type)
+			{
+				return current_product();
+			}
+
+			TResult current_unmatched(std::true_type)
+			{
+				if (_kind == INNER_ONLY)
+				{
+					const TInnerElem* ptr = _inner->current_ptr();
+					if (ptr)
+						return _resultSelector(ptr, (const TOuterElem*)nullptr);
+					TInnerElem inner = _inner->current();
+					return _resultSelector(&inner, (const TOuterElem*)nullptr);
+				}
+				const TOuterElem* ptr = _outer->current_ptr();
+				if (ptr)
+					return _resultSelector((const TInnerElem*)nullptr, ptr);
+				TOuterElem outer = _outer->current();
+				return _resultSelector((const TInnerElem*)nullptr, &outer);
+			}
+
+		public:
+			_MergeJoinEnumerator(std::shared_ptr<void> owner, std::shared_ptr<IEnumerator<TInnerElem>> inner, std::shared_ptr<IEnumerator<TOuterElem>> outer,
+				TKeySelector keySelector, TOuterKeySelector outerKeySelector, TResultSelector resultSelector, TKeyComparer keyComparer)
+				: _owner(owner), _inner(inner), _outer(outer), _keySelector(keySelector), _outerKeySelector(outerKeySelector), _resultSelector(resultSelector), _keyComparer(keyComparer),
+				_index(0), _kind(PRODUCT), _hasInner(false), _hasOuter(false), _started(false), _finished(false) {}
+
+			bool next() override
+			{
+				if (_finished) throw IterationFinishedException();
+				if (!_started)
+				{
+					_started = true;
+					_hasInner = _inner->next();
+					_hasOuter = _outer->next();
+				}
+				else if (_kind == INNER_ONLY)
+					_hasInner = _inner->next();
+				else if (_kind == OUTER_ONLY)
+					_hasOuter = _outer->next();
+				else
+				{
+					if (++_index < (int)_run.size())
+						return true;
+					_hasInner = _inner->next();
+					if (_hasInner && inner_matches_run())
+					{
+						_index = 0;
+						return true;
+					}
+				}
+				if (fetch())
+					return true;
+				_finished = true;
+				return false;
+			}
+
+			TResult current() override
+			{
+				if (_finished) throw IterationFinishedException();
+				if (!_started) throw IterationNotStartedException();
+				if (_kind == PRODUCT)
+					return current_product();
+				return current_unmatched(std::integral_constant<bool, LEFT_OUTER || RIGHT_OUTER>());
+			}
+
+			bool equals(std::shared_ptr<IEnumerator<TResult>> other) const override
+			{
+				auto pother = std::dynamic_pointer_cast<_MergeJoinEnumerator<TInnerElem, TOuterElem, TKeySelector, TOuterKeySelector, TResultSelector, TKeyComparer, TResult, LEFT_OUTER, RIGHT_OUTER>>(other);
+				if (!pother)
+					return false;
+				return this->_started == pother->_started &&
+					this->_finished == pother->_finished &&
+					this->_kind == pother->_kind &&
+					this->_index == pother->_index &&
+					this->_inner->equals(pother->_inner) &&
+					this->_outer->equals(pother->_outer);
+			}
+
+			std::shared_ptr<IEnumerator<TResult>> clone() const override
+			{
+				auto ptr = new _MergeJoinEnumerator<TInnerElem, TOuterElem, TKeySelector, TOuterKeySelector, TResultSelector, TKeyComparer, TResult, LEFT_OUTER, RIGHT_OUTER>(*this);
+				ptr->_inner = this->_inner->clone();
+				ptr->_outer = this->_outer->clone();
+				return std::shared_ptr<IEnumerator<TResult>>(ptr);
+			}
+		};
+
+		template<typename TOuter, typename TInnerElem, typename TOuterElem, typename TKeySelector, typename TOuterKeySelector, typename TResultSelector, typename TKeyComparer, typename TResult, bool LEFT_OUTER, bool RIGHT_OUTER>
+		class _MergeJoinEnumerable : public IEnumerable<TResult>
+		{
+		private:
+			std::shared_ptr<IEnumerable<TInnerElem>> _inner;
+			std::shared_ptr<TOuter> _outer;
+			TKeySelector _keySelector;
+			TOuterKeySelector _outerKeySelector;
+			TResultSelector _resultSelector;
+			TKeyComparer _keyComparer;
+
+		public:
+			_MergeJoinEnumerable(std::shared_ptr<IEnumerable<TInnerElem>> inner, TOuter outer, TKeySelector keySelector, TOuterKeySelector outerKeySelector, TResultSelector resultSelector, TKeyComparer keyComparer)
+				: _inner(inner), _outer(std::make_shared<TOuter>(outer)), _keySelector(keySelector), _outerKeySelector(outerKeySelector), _resultSelector(resultSelector), _keyComparer(keyComparer) {}
+
+			std::shared_ptr<IEnumerator<TResult>> createEnumerator() override
+			{
+				return std::shared_ptr<IEnumerator<TResult>>(new _MergeJoinEnumerator<TInnerElem, TOuterElem, TKeySelector, TOuterKeySelector, TResultSelector, TKeyComparer, TResult, LEFT_OUTER, RIGHT_OUTER>(
+					_outer, _inner->getEnumerator(), from(*_outer)->getEnumerator(), _keySelector, _outerKeySelector, _resultSelector, _keyComparer));
+			}
+		};
+
+		template<typename TOuter, typename TKeySelector, typename TOuterKeySelector, typename TResultSelector, typename TKeyComparer, bool LEFT_OUTER, bool RIGHT_OUTER>
+		class _MergeJoinBuilder
+		{
+		private:
+			typedef typename decltype(from(std::declval<typename std::add_lvalue_reference<TOuter>::type>()))::element_type::ElemType TOuterElem;
+			TOuter _outer;
+			TKeySelector _keySelector;
+			TOuterKeySelector _outerKeySelector;
+			TResultSelector _resultSelector;
+			TKeyComparer _keyComparer;
+		public:
+			_MergeJoinBuilder(TOuter outer, TKeySelector keySelector, TOuterKeySelector outerKeySelector, TResultSelector resultSelector, TKeyComparer keyComparer)
+				: _outer(outer), _keySelector(keySelector), _outerKeySelector(outerKeySelector), _resultSelector(resultSelector), _keyComparer(keyComparer)
+			{}
+
+			template<typename TElem>
+			auto build(std::shared_ptr<IEnumerable<TElem>> inner) ->
+				std::shared_ptr<IEnumerable<typename _MergeJoinResult<TResultSelector, TElem, TOuterElem, LEFT_OUTER || RIGHT_OUTER>::type>>
+			{
+				typedef typename _MergeJoinResult<TResultSelector, TElem, TOuterElem, LEFT_OUTER || RIGHT_OUTER>::type TResult;
+				return std::shared_ptr<IEnumerable<TResult>>(new _MergeJoinEnumerable<TOuter, TElem, TOuterElem, TKeySelector, TOuterKeySelector, TResultSelector, TKeyComparer, TResult, LEFT_OUTER, RIGHT_OUTER>(
+					inner, _outer, _keySelector, _outerKeySelector, _resultSelector, _keyComparer));
+			}
+
+			template<typename TElem>
+			auto build(std::shared_ptr<IBidirectionalEnumerable<TElem>> enumerable) ->
+				std::shared_ptr<IEnumerable<typename _MergeJoinResult<TResultSelector, TElem, TOuterElem, LEFT_OUTER || RIGHT_OUTER>::type>>
+			{
+				return build((std::shared_ptr<IEnumerable<TElem>>)enumerable);
+			}
+
+			template<typename TElem>
+			auto build(std::shared_ptr<IRandomAccessEnumerable<TElem>> enumerable) ->
+				std::shared_ptr<IEnumerable<typename _MergeJoinResult<TResultSelector, TElem, TOuterElem, LEFT_OUTER || RIGHT_OUTER>::type>>
+			{
+				return build((std::shared_ptr<IEnumerable<TElem>>)enumerable);
+			}
+		};
+	}
+	/*@endcond*/
+
+	/**
+	*	Correlates elements of two collections sorted by common key.
+	*	This function works as join, but both collections have to be sorted
+	*	ascending by selected keys. Collections are merged while they are
+	*	enumerated, so apart from elements of outer collection sharing current key
+	*	no elements are stored. Results follow order of keys, elements with equal
+	*	keys are paired in order of inner and then outer collection.
+	*	Keys are compared with operator<.
+	*	@param outer Outer collection to join.
+	*	@param keySelector Function selecting key from inner collection.
+	*	@param outerKeySelector Function selecting key from outer collection.
+	*	@param resultSelector Funcion selecting result from inner and outer element.
+	*	@return Builder of merge_join expression.
+	*/
+	template<typename TOuter, typename TKeySelector, typename TOuterKeySelector, typename TResultSelector>
+	XLINQ_INLINE internal::_MergeJoinBuilder<TOuter, TKeySelector, TOuterKeySelector, TResultSelector, internal::_MergeJoinKeyLess, false, false> merge_join(TOuter outer, TKeySelector keySelector, TOuterKeySelector outerKeySelector, TResultSelector resultSelector)
+	{
+		return internal::_MergeJoinBuilder<TOuter, TKeySelector, TOuterKeySelector, TResultSelector, internal::_MergeJoinKeyLess, false, false>(outer, keySelector, outerKeySelector, resultSelector, internal::_MergeJoinKeyLess());
+	}
+
+	/**
+	*	Correlates elements of two collections sorted by common key.
+	*	This function works as merge_join, but compares keys with specified comparer.
+	*	@param outer Outer collection to join.
+	*	@param keySelector Function selecting key from inner collection.
+	*	@param outerKeySelector Function selecting key from outer collection.
+	*	@param resultSelector Funcion selecting result from inner and outer element.
+	*	@param keyComparer Functor returning true if first key goes before second one,
+	*	it has to accept keys of both collections in any order.
+	*	@return Builder of merge_join expression.
+	*/
+	template<typename TOuter, typename TKeySelector, typename TOuterKeySelector, typename TResultSelector, typename TKeyComparer>
+	XLINQ_INLINE internal::_MergeJoinBuilder<TOuter, TKeySelector, TOuterKeySelector, TResultSelector, TKeyComparer, false, false> merge_join(TOuter outer, TKeySelector keySelector, TOuterKeySelector outerKeySelector, TResultSelector resultSelector, TKeyComparer keyComparer)
+	{
+		return internal::_MergeJoinBuilder<TOuter, TKeySelector, TOuterKeySelector, TResultSelector, TKeyComparer, false, false>(outer, keySelector, outerKeySelector, resultSelector, keyComparer);
+	}
+
+	/**
+	*	Correlates elements of two collections sorted by common key keeping unmatched inner elements.
+	*	This function works as merge_join, but resultSelector receives pointers
+	*	to inner and outer elements. Inner elements without matching outer element
+	*	are passed with null pointer to outer element.
+	*	@param outer Outer collection to join.
+	*	@param keySelector Function selecting key from inner collection.
+	*	@param outerKeySelector Function selecting key from outer collection.
+	*	@param resultSelector Funcion selecting result from pointers to inner and outer element.
+	*	@return Builder of left_merge_join expression.
+	*/
+	template<typename TOuter, typename TKeySelector, typename TOuterKeySelector, typename TResultSelector>
+	XLINQ_INLINE internal::_MergeJoinBuilder<TOuter, TKeySelector, TOuterKeySelector, TResultSelector, internal::_MergeJoinKeyLess, true, false> left_merge_join(TOuter outer, TKeySelector keySelector, TOuterKeySelector outerKeySelector, TResultSelector resultSelector)
+	{
+		return internal::_MergeJoinBuilder<TOuter, TKeySelector, TOuterKeySelector, TResultSelector, internal::_MergeJoinKeyLess, true, false>(outer, keySelector, outerKeySelector, resultSelector, internal::_MergeJoinKeyLess());
+	}
+
+	/**
+	*	Correlates elements of two collections sorted by common key keeping unmatched inner elements.
+	*	This function works as left_merge_join, but compares keys with specified comparer.
+	*	@param outer Outer collection to join.
+	*	@param keySelector Function selecting key from inner collection.
+	*	@param outerKeySelector Function selecting key from outer collection.
+	*	@param resultSelector Funcion selecting result from pointers to inner and outer element.
+	*	@param keyComparer Functor returning true if first key goes before second one,
+	*	it has to accept keys of both collections in any order.
+	*	@return Builder of left_merge_join expression.
+	*/
+	template<typename TOuter, typename TKeySelector, typename TOuterKeySelector, typename TResultSelector, typename TKeyComparer>
+	XLINQ_INLINE internal::_MergeJoinBuilder<TOuter, TKeySelector, TOuterKeySelector, TResultSelector, TKeyComparer, true, false> left_merge_join(TOuter outer, TKeySelector keySelector, TOuterKeySelector outerKeySelector, TResultSelector resultSelector, TKeyComparer keyComparer)
+	{
+		return internal::_MergeJoinBuilder<TOuter, TKeySelector, TOuterKeySelector, TResultSelector, TKeyComparer, true, false>(outer, keySelector, outerKeySelector, resultSelector, keyComparer);
+	}
+
+	/**
+	*	Correlates elements of two collections sorted by common key keeping all unmatched elements.
+	*	This function works as left_merge_join, but outer elements without
+	*	matching inner element are passed to resultSelector too, with null pointer
+	*	to inner element.
+	*	@param outer Outer collection to join.
+	*	@param keySelector Function selecting key from inner collection.
+	*	@param outerKeySelector Function selecting key from outer collection.
+	*	@param resultSelector Funcion selecting result from pointers to inner and outer element.
+	*	@return Builder of full_merge_join expression.
+	*/
+	template<typename TOuter, typename TKeySelector, typename TOuterKeySelector, typename TResultSelector>
+	XLINQ_INLINE internal::_MergeJoinBuilder<TOuter, TKeySelector, TOuterKeySelector, TResultSelector, internal::_MergeJoinKeyLess, true, true> full_merge_join(TOuter outer, TKeySelector keySelector, TOuterKeySelector outerKeySelector, TResultSelector resultSelector)
+	{
+		return internal::_MergeJoinBuilder<TOuter, TKeySelector, TOuterKeySelector, TResultSelector, internal::_MergeJoinKeyLess, true, true>(outer, keySelector, outerKeySelector, resultSelector, internal::_MergeJoinKeyLess());
+	}
+
+	/**
+	*	Correlates elements of two collections sorted by common key keeping all unmatched elements.
+	*	This function works as full_merge_join, but compares keys with specified comparer.
+	*	@param outer Outer collection to join.
+	*	@param keySelector Function selecting key from inner collection.
+	*	@param outerKeySelector Function selecting key from outer collection.
+	*	@param resultSelector Funcion selecting result from pointers to inner and outer element.
+	*	@param keyComparer Functor returning true if first key goes before second one,
+	*	it has to accept keys of both collections in any order.
+	*	@return Builder of full_merge_join expression.
+	*/
+	template<typename TOuter, typename TKeySelector, typename TOuterKeySelector, typename TResultSelector, typename TKeyComparer>
+	XLINQ_INLINE internal::_MergeJoinBuilder<TOuter, TKeySelector, TOuterKeySelector, TResultSelector, TKeyComparer, true, true> full_merge_join(TOuter outer, TKeySelector keySelector, TOuterKeySelector outerKeySelector, TResultSelector resultSelector, TKeyComparer keyComparer)
+	{
+		return internal::_MergeJoinBuilder<TOuter, TKeySelector, TOuterKeySelector, TResultSelector, TKeyComparer, true, true>(outer, keySelector, outerKeySelector, resultSelector, keyComparer);
+	}
+}
+
+#endif
\ No newline at end of file
@@ -30,6 +30,8 @@ SOFTWARE.
 #define XLINQ_MIN_H_
 
 #include "xlinq_base.h"
+#include "xlinq_reduce.h"
+#include "xlinq_static.h"
 
 namespace xlinq
 {
@@ -41,16 +43,26 @@ namespace xlinq
 			template<typename TElem>
 			TElem int_min(std::shared_ptr<IEnumerable<TElem>> enumerable)
 			{
-				auto en = enumerable->getEnumerator();
-				en->next();
-				auto minVal = en->current();
-				while (en->next())
+				_BatchReader<TElem> reader(enumerable->getEnumerator());
+				if (!reader.read())
+					throw IterationFinishedException();
+				auto minVal = reduce_batch<TElem, REDUCE_MIN>(reader.batch());
+				while (reader.read())
 				{
-					if (minVal > en->current())
-						minVal = en->current();
+					auto batchMin = reduce_batch<TElem, REDUCE_MIN>(reader.batch());
+					if (minVal > batchMin)
+						minVal = batchMin;
 				}
 				return minVal;
 			}
+
+			template<typename TElem>
+			TElem span_min(const TElem* data, int size)
+			{
+				if (!size)
+					throw IterationFinishedException();
+				return reduce_span<TElem, REDUCE_MIN>(data, size);
+			}
 		public:
 			template<typename TElem>
 			TElem build(std::shared_ptr<IEnumerable<TElem>> enumerable)
@@ -67,8 +79,33 @@ namespace xlinq
 			template<typename TElem>
 			TElem build(std::shared_ptr<IRandomAccessEnumerable<TElem>> enumerable)
 			{
+				auto data = enumerable->data();
+				if (data)
+					return span_min(data, enumerable->size());
 				return int_min((std::shared_ptr<IEnumerable<TElem>>)enumerable);
 			}
+
+			template<typename TSource>
+			typename TSource::ElemType build(const StaticEnumerable<TSource>& enumerable)
+			{
+				auto en = enumerable.derived().getEnumerator();
+				if (!en.next())
+					throw IterationFinishedException();
+				auto result = en.current();
+				while (en.next())
+				{
+					auto value = en.current();
+					if (result > value)
+						result = value;
+				}
+				return result;
+			}
+
+			template<typename TQuery>
+			auto build(const ParallelEnumerable<TQuery>& enumerable) -> decltype(enumerable.derived().min())
+			{
+				return enumerable.derived().min();
+			}
 		};
 	}
 	/*@endcond*/
@@ -0,0 +1,825 @@
+/*
+MIT License
+
+Copyright (c) 2017 TrolleY
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+*	@file xlinq_parallel.h
+*	Parallel execution of queries over random access collections.
+*	@author TrolleY
+*/
+#ifndef XLINQ_PARALLEL_H_
+#define XLINQ_PARALLEL_H_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "xlinq_base.h"
+#include "xlinq_exception.h"
+#include "xlinq_from_container_shared_ptr.h"
+
+namespace xlinq
+{
+	/*@cond XLINQ_INTERNAL*/
+	namespace internal
+	{
+		class _WorkStealingPool
+		{
+		private:
+			struct _TaskQueue
+			{
+				std::mutex mutex;
+				std::deque<std::function<void()>> tasks;
+			};
+
+			struct _ParallelForState
+			{
+				std::mutex mutex;
+				std::condition_variable finished;
+				int remaining;
+				std::exception_ptr error;
+
+				_ParallelForState(int count) : remaining(count) {}
+
+				void run(const std::function<void(int)>& function, int index)
+				{
+					std::exception_ptr error;
+					try
+					{
+						function(index);
+					}
+					catch (...)
+					{
+						error = std::current_exception();
+					}
+					std::lock_guard<std::mutex> lock(mutex);
+					if (error && !this->error)
+						this->error = error;
+					if (--remaining == 0)
+						finished.notify_all();
+				}
+
+				void wait()
+				{
+					std::unique_lock<std::mutex> lock(mutex);
+					finished.wait(lock, [this] { return remaining == 0; });
+				}
+			};
+
+			std::vector<std::unique_ptr<_TaskQueue>> _queues;
+			std::vector<std::thread> _threads;
+			std::mutex _mutex;
+			std::condition_variable _wakeUp;
+			std::atomic<int> _pending;
+			std::atomic<unsigned> _nextQueue;
+			bool _stopped;
+
+			bool pop(int queue, std::function<void()>& task)
+			{
+				auto& owned = *_queues[queue];
+				std::lock_guard<std::mutex> lock(owned.mutex);
+				if (owned.tasks.empty())
+					return false;
+				task = std::move(owned.tasks.back());
+				owned.tasks.pop_back();
+				--_pending;
+				return true;
+			}
+
+			bool steal(int thief, std::function<void()>& task)
+			{
+				int queues = (int)_queues.size();
+				for (int i = 1; i <= queues; ++i)
+				{
+					int victim = (thief + i) % queues;
+					if (victim == thief)
+						continue;
+					auto& stolen = *_queues[victim];
+					std::lock_guard<std::mutex> lock(stolen.mutex);
+					if (stolen.tasks.empty())
+						continue;
+					task = std::move(stolen.tasks.front());
+					stolen.tasks.pop_front();
+					--_pending;
+					return true;
+				}
+				return false;
+			}
+
+			bool take(int queue, std::function<void()>& task)
+			{
+				return (queue >= 0 && pop(queue, task)) || steal(queue, task);
+			}
+
+			void work(int queue)
+			{
+				std::function<void()> task;
+				while (true)
+				{
+					if (take(queue, task))
+					{
+						task();
+						task = nullptr;
+						continue;
+					}
+					std::unique_lock<std::mutex> lock(_mutex);
+					_wakeUp.wait(lock, [this] { return _stopped || _pending > 0; });
+					if (_stopped)
+						return;
+				}
+			}
+
+		public:
+			_WorkStealingPool(int threads) : _pending(0), _nextQueue(0), _stopped(false)
+			{
+				for (int i = 0; i < threads; ++i)
+					_queues.emplace_back(new _TaskQueue());
+				for (int i = 0; i < threads; ++i)
+					_threads.emplace_back(&_WorkStealingPool::work, this, i);
+			}
+
+			~_WorkStealingPool()
+			{
+				{
+					std::lock_guard<std::mutex> lock(_mutex);
+					_stopped = true;
+				}
+				_wakeUp.notify_all();
+				for (auto& thread : _threads)
+					thread.join();
+			}
+
+			_WorkStealingPool(const _WorkStealingPool&) = delete;
+			_WorkStealingPool& operator=(const _WorkStealingPool&) = delete;
+
+			int size() const
+			{
+				return (int)_threads.size();
+			}
+
+			void parallel_for(int count, const std::function<void(int)>& function)
+			{
+				if (count <= 1 || _threads.empty())
+				{
+					for (int i = 0; i < count; ++i)
+						function(i);
+					return;
+				}
+
+				auto state = std::make_shared<_ParallelForState>(count);
+				{
+					std::lock_guard<std::mutex> lock(_mutex);
+					_pending += count;
+				}
+				for (int i = 0; i < count; ++i)
+				{
+					auto& queue = *_queues[_nextQueue++ % _queues.size()];
+					std::lock_guard<std::mutex> lock(queue.mutex);
+					queue.tasks.emplace_back([state, &function, i] { state->run(function, i); });
+				}
+				_wakeUp.notify_all();
+
+				// calling thread helps until there is nothing left to steal
+				std::function<void()> task;
+				while (take(-1, task))
+				{
+					task();
+					task = nullptr;
+				}
+				state->wait();
+				if (state->error)
+					std::rethrow_exception(state->error);
+			}
+
+			static _WorkStealingPool& instance()
+			{
+				static _WorkStealingPool pool((XLINQ_PARALLEL_THREADS > 0 ? XLINQ_PARALLEL_THREADS : (int)std::max(1u, std::thread::hardware_concurrency())) - 1);
+				return pool;
+			}
+		};
+
+		struct _ParallelIdentityStage
+		{
+			template<typename TElem, typename TSink>
+			bool operator()(const TElem& elem, TSink& sink) const
+			{
+				return sink(elem);
+			}
+		};
+
+		template<typename TPrevious, typename TPredicate>
+		class _ParallelWhereStage
+		{
+		private:
+			template<typename TSink>
+			struct _Sink
+			{
+				const TPredicate& predicate;
+				TSink& sink;
+
+				template<typename TElem>
+				bool operator()(const TElem& elem)
+				{
+					return predicate(elem) ? sink(elem) : true;
+				}
+			};
+
+			TPrevious _previous;
+			TPredicate _predicate;
+
+		public:
+			_ParallelWhereStage(TPrevious previous, TPredicate predicate) : _previous(previous), _predicate(predicate) {}
+
+			template<typename TElem, typename TSink>
+			bool operator()(const TElem& elem, TSink& sink) const
+			{
+				_Sink<TSink> filter = { _predicate, sink };
+				return _previous(elem, filter);
+			}
+		};
+
+		template<typename TPrevious, typename TSelector>
+		class _ParallelSelectStage
+		{
+		private:
+			template<typename TSink>
+			struct _Sink
+			{
+				const TSelector& selector;
+				TSink& sink;
+
+				template<typename TElem>
+				bool operator()(const TElem& elem)
+				{
+					return sink(selector(elem));
+				}
+			};
+
+			TPrevious _previous;
+			TSelector _selector;
+
+		public:
+			_ParallelSelectStage(TPrevious previous, TSelector selector) : _previous(previous), _selector(selector) {}
+
+			template<typename TElem, typename TSink>
+			bool operator()(const TElem& elem, TSink& sink) const
+			{
+				_Sink<TSink> converter = { _selector, sink };
+				return _previous(elem, converter);
+			}
+		};
+
+		template<typename TElem, typename TAggregator>
+		class _ParallelAggregateSink
+		{
+		private:
+			TAggregator _aggregator;
+
+		public:
+			std::vector<TElem> value;
+
+			_ParallelAggregateSink(TAggregator aggregator) : _aggregator(aggregator) {}
+
+			bool cancelled() const { return false; }
+
+			bool operator()(const TElem& elem)
+			{
+				if (value.empty())
+					value.push_back(elem);
+				else value[0] = _aggregator(value[0], elem);
+				return true;
+			}
+		};
+
+		template<typename TResult, typename TAggregator>
+		class _ParallelSeedAggregateSink
+		{
+		private:
+			TAggregator _aggregator;
+
+		public:
+			TResult value;
+
+			_ParallelSeedAggregateSink(TResult seed, TAggregator aggregator) : _aggregator(aggregator), value(seed) {}
+
+			bool cancelled() const { return false; }
+
+			template<typename TElem>
+			bool operator()(const TElem& elem)
+			{
+				value = _aggregator(value, elem);
+				return true;
+			}
+		};
+
+		struct _ParallelCountSink
+		{
+			int value;
+
+			_ParallelCountSink() : value(0) {}
+
+			bool cancelled() const { return false; }
+
+			template<typename TElem>
+			bool operator()(const TElem&)
+			{
+				++value;
+				return true;
+			}
+		};
+
+		class _ParallelAnySink
+		{
+		private:
+			std::shared_ptr<std::atomic<bool>> _found;
+
+		public:
+			_ParallelAnySink(std::shared_ptr<std::atomic<bool>> found) : _found(found) {}
+
+			bool cancelled() const { return _found->load(std::memory_order_relaxed); }
+
+			template<typename TElem>
+			bool operator()(const TElem&)
+			{
+				_found->store(true, std::memory_order_relaxed);
+				return false;
+			}
+		};
+
+		template<typename TPredicate>
+		class _ParallelAllSink
+		{
+		private:
+			std::shared_ptr<std::atomic<bool>> _failed;
+			TPredicate _predicate;
+
+		public:
+			_ParallelAllSink(std::shared_ptr<std::atomic<bool>> failed, TPredicate predicate) : _failed(failed), _predicate(predicate) {}
+
+			bool cancelled() const { return _failed->load(std::memory_order_relaxed); }
+
+			template<typename TElem>
+			bool operator()(const TElem& elem)
+			{
+				if (_predicate(elem))
+					return true;
+				_failed->store(true, std::memory_order_relaxed);
+				return false;
+			}
+		};
+
+		template<typename TElem>
+		struct _ParallelVectorSink
+		{
+			std::vector<TElem> value;
+
+			bool cancelled() const { return false; }
+
+			bool operator()(const TElem& elem)
+			{
+				value.push_back(elem);
+				return true;
+			}
+		};
+
+		template<typename TElem>
+		struct _ParallelSum
+		{
+			TElem operator()(TElem lhs, const TElem& rhs) const
+			{
+				lhs += rhs;
+				return lhs;
+			}
+		};
+
+		template<typename TElem>
+		struct _ParallelMin
+		{
+			TElem operator()(const TElem& lhs, const TElem& rhs) const
+			{
+				return lhs > rhs ? rhs : lhs;
+			}
+		};
+
+		template<typename TElem>
+		struct _ParallelMax
+		{
+			TElem operator()(const TElem& lhs, const TElem& rhs) const
+			{
+				return lhs < rhs ? rhs : lhs;
+			}
+		};
+
+		template<typename TKey, typename TElem>
+		class _VectorGrouping : public IGrouping<TKey, TElem>
+		{
+		private:
+			TKey _key;
+			std::shared_ptr<std::vector<TElem>> _elements;
+		public:
+			_VectorGrouping(TKey key, std::shared_ptr<std::vector<TElem>> elements)
+				: _key(key), _elements(elements) {}
+
+			TKey getKey() const override { return _key; }
+
+			std::shared_ptr<IEnumerator<TElem>> createEnumerator() override
+			{
+				return from(_elements)->getEnumerator();
+			}
+		};
+
+		template<typename TElem>
+		struct _ParallelGroupFolder
+		{
+			typedef std::vector<TElem> TState;
+
+			TState init() const
+			{
+				return TState();
+			}
+
+			void accumulate(TState& state, const TElem& elem)
+			{
+				state.push_back(elem);
+			}
+
+			void merge(TState& state, TState& other)
+			{
+				state.insert(state.end(), std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+			}
+		};
+
+		template<typename TResult, typename TAggregator, typename TCombiner>
+		struct _ParallelAggregateFolder
+		{
+			typedef TResult TState;
+
+			TResult seed;
+			TAggregator aggregator;
+			TCombiner combiner;
+
+			_ParallelAggregateFolder(TResult seed, TAggregator aggregator, TCombiner combiner)
+				: seed(seed), aggregator(aggregator), combiner(combiner) {}
+
+			TState init() const
+			{
+				return seed;
+			}
+
+			template<typename TElem>
+			void accumulate(TState& state, const TElem& elem)
+			{
+				state = aggregator(state, elem);
+			}
+
+			void merge(TState& state, TState& other)
+			{
+				state = combiner(state, other);
+			}
+		};
+
+		template<typename TKey, typename TState, typename THasher, typename TEqComp>
+		struct _ParallelPartition
+		{
+			struct Entry
+			{
+				TKey key;
+				TState state;
+				long long order;
+
+				Entry(TKey key, TState state, long long order) : key(key), state(std::move(state)), order(order) {}
+			};
+
+			std::unordered_map<TKey, int, THasher, TEqComp> index;
+			std::vector<Entry> entries;
+
+			_ParallelPartition(THasher hasher, TEqComp eqComp) : index(0, hasher, eqComp) {}
+
+			template<typename TFolder>
+			TState& find(const TKey& key, long long order, const TFolder& folder)
+			{
+				auto it = index.find(key);
+				if (it != index.end())
+					return entries[it->second].state;
+				index.insert(std::make_pair(key, (int)entries.size()));
+				entries.push_back(Entry(key, folder.init(), order));
+				return entries.back().state;
+			}
+		};
+
+		template<typename TElem, typename TKey, typename TKeySelector, typename THasher, typename TEqComp, typename TFolder>
+		class _ParallelPartitionSink
+		{
+		public:
+			typedef _ParallelPartition<TKey, typename TFolder::TState, THasher, TEqComp> TPartition;
+
+		private:
+			TKeySelector _keySelector;
+			THasher _hasher;
+			TFolder _folder;
+			int _position;
+
+		public:
+			std::vector<TPartition> partitions;
+
+			_ParallelPartitionSink(TKeySelector keySelector, THasher hasher, TEqComp eqComp, TFolder folder, int partitionsCount)
+				: _keySelector(keySelector), _hasher(hasher), _folder(folder), _position(0),
+				partitions(partitionsCount, TPartition(hasher, eqComp)) {}
+
+			bool cancelled() const { return false; }
+
+			bool operator()(const TElem& elem)
+			{
+				TKey key = _keySelector(elem);
+				auto& partition = partitions[_hasher(key) % partitions.size()];
+				_folder.accumulate(partition.find(key, _position++, _folder), elem);
+				return true;
+			}
+		};
+
+		template<typename TSource, typename TElem, typename TStage>
+		class _ParallelQuery : public ParallelEnumerable<_ParallelQuery<TSource, TElem, TStage>>
+		{
+		private:
+			std::shared_ptr<IRandomAccessEnumerable<TSource>> _source;
+			TStage _stage;
+
+			static int chunk_begin(int size, int chunks, int chunk)
+			{
+				return (int)((long long)size * chunk / chunks);
+			}
+
+			template<typename TSink>
+			std::vector<TSink> run(const TSink& prototype) const
+			{
+				auto& pool = _WorkStealingPool::instance();
+				int size = _source->size();
+				int chunks = std::max(1, std::min(size / XLINQ_PARALLEL_CHUNK_SIZE, 4 * (pool.size() + 1)));
+				std::vector<TSink> sinks(chunks, prototype);
+
+				// enumerators are created by calling thread, because sources may initialize lazily
+				auto data = _source->data();
+				std::vector<std::shared_ptr<IRandomAccessEnumerator<TSource>>> enumerators;
+				if (!data)
+				{
+					for (int chunk = 0; chunk < chunks; ++chunk)
+					{
+						int begin = chunk_begin(size, chunks, chunk);
+						enumerators.push_back(begin < size ? _source->getEnumeratorAt(begin) : nullptr);
+					}
+				}
+
+				pool.parallel_for(chunks, [&](int chunk)
+				{
+					int begin = chunk_begin(size, chunks, chunk);
+					int end = chunk_begin(size, chunks, chunk + 1);
+					auto& sink = sinks[chunk];
+					if (data)
+					{
+						for (int i = begin; i < end && !sink.cancelled(); ++i)
+							if (!_stage(data[i], sink))
+								break;
+					}
+					else if (begin < end)
+					{
+						auto& enumerator = enumerators[chunk];
+						for (int i = begin; !sink.cancelled(); enumerator->next())
+						{
+							if (!_stage(enumerator->current(), sink) || ++i == end)
+								break;
+						}
+					}
+				});
+				return sinks;
+			}
+
+			template<typename TKey, typename TKeySelector, typename THasher, typename TEqComp, typename TFolder>
+			std::vector<typename _ParallelPartition<TKey, typename TFolder::TState, THasher, TEqComp>::Entry> fold_by(TKeySelector keySelector, THasher hasher, TEqComp eqComp, TFolder folder) const
+			{
+				typedef _ParallelPartitionSink<TElem, TKey, TKeySelector, THasher, TEqComp, TFolder> TSink;
+				typedef typename TSink::TPartition TPartition;
+				typedef typename TPartition::Entry TEntry;
+
+				// each chunk splits its groups by key hash, so partitions may be merged independently
+				int partitionsCount = _WorkStealingPool::instance().size() + 1;
+				auto sinks = run(TSink(keySelector, hasher, eqComp, folder, partitionsCount));
+				std::vector<TPartition> merged;
+				for (int partition = 0; partition < partitionsCount; ++partition)
+					merged.push_back(std::move(sinks[0].partitions[partition]));
+				_WorkStealingPool::instance().parallel_for(partitionsCount, [&](int partition)
+				{
+					auto& target = merged[partition];
+					auto partitionFolder = folder;
+					for (int chunk = 1; chunk < (int)sinks.size(); ++chunk)
+					{
+						for (auto& entry : sinks[chunk].partitions[partition].entries)
+						{
+							long long order = ((long long)chunk << 32) | entry.order;
+							auto& state = target.find(entry.key, order, partitionFolder);
+							partitionFolder.merge(state, entry.state);
+						}
+						auto& consumed = sinks[chunk].partitions[partition];
+						consumed.index.clear();
+						std::vector<TEntry>().swap(consumed.entries);
+					}
+				});
+
+				std::vector<TEntry> result;
+				for (auto& partition : merged)
+					for (auto& entry : partition.entries)
+						result.push_back(std::move(entry));
+				std::sort(result.begin(), result.end(), [](const TEntry& lhs, const TEntry& rhs) { return lhs.order < rhs.order; });
+				return result;
+			}
+
+		public:
+			typedef TElem ElemType;
+
+			_ParallelQuery(std::shared_ptr<IRandomAccessEnumerable<TSource>> source, TStage stage)
+				: _source(source), _stage(stage) {}
+
+			template<typename TPredicate>
+			_ParallelQuery<TSource, TElem, _ParallelWhereStage<TStage, TPredicate>> where(TPredicate predicate) const
+			{
+				return _ParallelQuery<TSource, TElem, _ParallelWhereStage<TStage, TPredicate>>(_source, _ParallelWhereStage<TStage, TPredicate>(_stage, predicate));
+			}
+
+			template<typename TSelector>
+			_ParallelQuery<TSource, typename unaryreturntype<TSelector, TElem>::type, _ParallelSelectStage<TStage, TSelector>> select(TSelector selector) const
+			{
+				return _ParallelQuery<TSource, typename unaryreturntype<TSelector, TElem>::type, _ParallelSelectStage<TStage, TSelector>>(_source, _ParallelSelectStage<TStage, TSelector>(_stage, selector));
+			}
+
+			template<typename TAggregator>
+			TElem aggregate(TAggregator aggregator) const
+			{
+				auto sinks = run(_ParallelAggregateSink<TElem, TAggregator>(aggregator));
+				std::vector<TElem> result;
+				for (auto& sink : sinks)
+				{
+					if (sink.value.empty())
+						continue;
+					if (result.empty())
+						result.push_back(sink.value[0]);
+					else result[0] = aggregator(result[0], sink.value[0]);
+				}
+				if (result.empty())
+					throw IterationFinishedException();
+				return result[0];
+			}
+
+			template<typename TResult, typename TAggregator, typename TCombiner>
+			TResult aggregate(TResult seed, TAggregator aggregator, TCombiner combiner) const
+			{
+				auto sinks = run(_ParallelSeedAggregateSink<TResult, TAggregator>(seed, aggregator));
+				TResult result = sinks[0].value;
+				for (int i = 1; i < (int)sinks.size(); ++i)
+					result = combiner(result, sinks[i].value);
+				return result;
+			}
+
+			TElem sum() const
+			{
+				return aggregate(_ParallelSum<TElem>());
+			}
+
+			TElem min() const
+			{
+				return aggregate(_ParallelMin<TElem>());
+			}
+
+			TElem max() const
+			{
+				return aggregate(_ParallelMax<TElem>());
+			}
+
+			int count() const
+			{
+				int count = 0;
+				for (auto& sink : run(_ParallelCountSink()))
+					count += sink.value;
+				return count;
+			}
+
+			bool any() const
+			{
+				auto found = std::make_shared<std::atomic<bool>>(false);
+				run(_ParallelAnySink(found));
+				return found->load();
+			}
+
+			template<typename TPredicate>
+			bool any(TPredicate predicate) const
+			{
+				return where(predicate).any();
+			}
+
+			template<typename TPredicate>
+			bool all(TPredicate predicate) const
+			{
+				auto failed = std::make_shared<std::atomic<bool>>(false);
+				run(_ParallelAllSink<TPredicate>(failed, predicate));
+				return !failed->load();
+			}
+
+			template<typename TKeySelector, typename THasher, typename TEqComp>
+			std::shared_ptr<IRandomAccessEnumerable<std::shared_ptr<IGrouping<typename std::decay<typename unaryreturntype<TKeySelector, TElem>::type>::type, TElem>>>> group_by(TKeySelector keySelector, THasher hasher, TEqComp eqComp) const
+			{
+				typedef typename std::decay<typename unaryreturntype<TKeySelector, TElem>::type>::type TKey;
+				auto entries = fold_by<TKey>(keySelector, hasher, eqComp, _ParallelGroupFolder<TElem>());
+				auto groups = std::make_shared<std::vector<std::shared_ptr<IGrouping<TKey, TElem>>>>();
+				groups->reserve(entries.size());
+				for (auto& entry : entries)
+					groups->push_back(std::shared_ptr<IGrouping<TKey, TElem>>(new _VectorGrouping<TKey, TElem>(entry.key, std::make_shared<std::vector<TElem>>(std::move(entry.state)))));
+				return from(groups);
+			}
+
+			template<typename TKeySelector>
+			auto group_by(TKeySelector keySelector) const -> decltype(this->group_by(keySelector, std::hash<typename std::decay<typename unaryreturntype<TKeySelector, TElem>::type>::type>(), std::equal_to<typename std::decay<typename unaryreturntype<TKeySelector, TElem>::type>::type>()))
+			{
+				typedef typename std::decay<typename unaryreturntype<TKeySelector, TElem>::type>::type TKey;
+				return group_by(keySelector, std::hash<TKey>(), std::equal_to<TKey>());
+			}
+
+			template<typename TKeySelector, typename TResult, typename TAggregator, typename TCombiner>
+			std::shared_ptr<IRandomAccessEnumerable<std::pair<typename std::decay<typename unaryreturntype<TKeySelector, TElem>::type>::type, TResult>>> aggregate_by(TKeySelector keySelector, TResult seed, TAggregator aggregator, TCombiner combiner) const
+			{
+				typedef typename std::decay<typename unaryreturntype<TKeySelector, TElem>::type>::type TKey;
+				auto entries = fold_by<TKey>(keySelector, std::hash<TKey>(), std::equal_to<TKey>(), _ParallelAggregateFolder<TResult, TAggregator, TCombiner>(seed, aggregator, combiner));
+				auto results = std::make_shared<std::vector<std::pair<TKey, TResult>>>();
+				results->reserve(entries.size());
+				for (auto& entry : entries)
+					results->push_back(std::make_pair(entry.key, std::move(entry.state)));
+				return from(results);
+			}
+
+			std::vector<TElem> to_vector() const
+			{
+				auto sinks = run(_ParallelVectorSink<TElem>());
+				std::size_t size = 0;
+				for (auto& sink : sinks)
+					size += sink.value.size();
+				std::vector<TElem> result;
+				result.reserve(size);
+				for (auto& sink : sinks)
+					result.insert(result.end(), sink.value.begin(), sink.value.end());
+				return result;
+			}
+		};
+
+		class _ParallelBuilder
+		{
+		public:
+			template<typename TElem>
+			_ParallelQuery<TElem, TElem, _ParallelIdentityStage> build(std::shared_ptr<IRandomAccessEnumerable<TElem>> enumerable)
+			{
+				return _ParallelQuery<TElem, TElem, _ParallelIdentityStage>(enumerable, _ParallelIdentityStage());
+			}
+		};
+	}
+	/*@endcond*/
+
+	/**
+	*	Executes following query operations in parallel.
+	*	This function may be used only with random access collections. Collection
+	*	is split into chunks of at least XLINQ_PARALLEL_CHUNK_SIZE elements which are
+	*	processed by shared work stealing thread pool. Following where, select, sum, count,
+	*	min, max, aggregate, any, all and to_vector operations are executed in parallel,
+	*	so their functors have to be safe to call concurrently. Order of elements
+	*	returned by to_vector and order of combining partial aggregates is preserved.
+	*	@return Builder of parallel expression.
+	*/
+	XLINQ_INLINE internal::_ParallelBuilder parallel()
+	{
+		return internal::_ParallelBuilder();
+	}
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,623 @@
+/*
+MIT License
+
+Copyright (c) 2017 TrolleY
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+*	@file xlinq_predicate.h
+*	Comparison predicates of collection elements which may be evaluated with vector instructions.
+*	@author TrolleY
+*/
+#ifndef XLINQ_PREDICATE_H_
+#define XLINQ_PREDICATE_H_
+
+#include <cstdint>
+#include <type_traits>
+#include "xlinq_defs.h"
+#include "xlinq_reduce.h"
+
+namespace xlinq
+{
+	/*@cond XLINQ_INTERNAL*/
+	namespace internal
+	{
+		enum { PREDICATE_BLOCK = 64 };
+
+		enum _CompareOperation
+		{
+			COMPARE_LESS,
+			COMPARE_LESS_EQUAL,
+			COMPARE_GREATER,
+			COMPARE_GREATER_EQUAL,
+			COMPARE_EQUAL,
+			COMPARE_NOT_EQUAL
+		};
+
+		template<int OPERATION>
+		struct _Compare;
+
+		template<>
+		struct _Compare<COMPARE_LESS>
+		{
+			template<typename TLeft, typename TRight>
+			static bool apply(const TLeft& left, const TRight& right) { return left < right; }
+		};
+
+		template<>
+		struct _Compare<COMPARE_LESS_EQUAL>
+		{
+			template<typename TLeft, typename TRight>
+			static bool apply(const TLeft& left, const TRight& right) { return left <= right; }
+		};
+
+		template<>
+		struct _Compare<COMPARE_GREATER>
+		{
+			template<typename TLeft, typename TRight>
+			static bool apply(const TLeft& left, const TRight& right) { return left > right; }
+		};
+
+		template<>
+		struct _Compare<COMPARE_GREATER_EQUAL>
+		{
+			template<typename TLeft, typename TRight>
+			static bool apply(const TLeft& left, const TRight& right) { return left >= right; }
+		};
+
+		template<>
+		struct _Compare<COMPARE_EQUAL>
+		{
+			template<typename TLeft, typename TRight>
+			static bool apply(const TLeft& left, const TRight& right) { return left == right; }
+		};
+
+		template<>
+		struct _Compare<COMPARE_NOT_EQUAL>
+		{
+			template<typename TLeft, typename TRight>
+			static bool apply(const TLeft& left, const TRight& right) { return left != right; }
+		};
+
+		template<int OPERATION, typename TElem>
+		std::uint64_t compare_scalar(const TElem* data, int size, TElem value)
+		{
+			std::uint64_t result = 0;
+			for (int i = 0; i < size; ++i)
+				if (_Compare<OPERATION>::apply(data[i], value))
+					result |= (std::uint64_t)1 << i;
+			return result;
+		}
+
+#define XLINQ_COMPARE_KERNEL(NAME, TARGET) \
+		template<typename TTraits, int OPERATION> \
+		TARGET std::uint64_t NAME(const typename TTraits::Elem* data, int size, typename TTraits::Elem value) \
+		{ \
+			typename TTraits::Vector constant = TTraits::broadcast(value); \
+			std::uint64_t result = 0; \
+			int i = 0; \
+			for (; i + TTraits::LANES <= size; i += TTraits::LANES) \
+				result |= (std::uint64_t)TTraits::compare(OPERATION, TTraits::load(data + i), constant) << i; \
+			if (i < size) \
+				result |= compare_scalar<OPERATION>(data + i, size - i, value) << i; \
+			return result; \
+		}
+
+#define XLINQ_NEGATED_COMPARE(OPERATION) \
+		((OPERATION) == COMPARE_LESS_EQUAL || (OPERATION) == COMPARE_GREATER_EQUAL || (OPERATION) == COMPARE_NOT_EQUAL)
+
+#ifdef XLINQ_REDUCE_SSE2
+		struct _Sse2Int32Compare
+		{
+			typedef std::int32_t Elem;
+			typedef __m128i Vector;
+			enum { LANES = 4 };
+
+			static Vector load(const Elem* data) { return _mm_loadu_si128((const __m128i*)data); }
+			static Vector broadcast(Elem value) { return _mm_set1_epi32(value); }
+
+			static unsigned compare(int operation, Vector elems, Vector constant)
+			{
+				__m128i result;
+				if (operation == COMPARE_LESS || operation == COMPARE_GREATER_EQUAL)
+					result = _mm_cmplt_epi32(elems, constant);
+				else if (operation == COMPARE_GREATER || operation == COMPARE_LESS_EQUAL)
+					result = _mm_cmpgt_epi32(elems, constant);
+				else
+					result = _mm_cmpeq_epi32(elems, constant);
+				unsigned bits = (unsigned)_mm_movemask_ps(_mm_castsi128_ps(result));
+				return XLINQ_NEGATED_COMPARE(operation) ? bits ^ 0xF : bits;
+			}
+		};
+
+		struct _Sse2FloatCompare
+		{
+			typedef float Elem;
+			typedef __m128 Vector;
+			enum { LANES = 4 };
+
+			static Vector load(const Elem* data) { return _mm_loadu_ps(data); }
+			static Vector broadcast(Elem value) { return _mm_set1_ps(value); }
+
+			static unsigned compare(int operation, Vector elems, Vector constant)
+			{
+				__m128 result;
+				switch (operation)
+				{
+				case COMPARE_LESS: result = _mm_cmplt_ps(elems, constant); break;
+				case COMPARE_LESS_EQUAL: result = _mm_cmple_ps(elems, constant); break;
+				case COMPARE_GREATER: result = _mm_cmpgt_ps(elems, constant); break;
+				case COMPARE_GREATER_EQUAL: result = _mm_cmpge_ps(elems, constant); break;
+				case COMPARE_EQUAL: result = _mm_cmpeq_ps(elems, constant); break;
+				default: result = _mm_cmpneq_ps(elems, constant); break;
+				}
+				return (unsigned)_mm_movemask_ps(result);
+			}
+		};
+
+		struct _Sse2DoubleCompare
+		{
+			typedef double Elem;
+			typedef __m128d Vector;
+			enum { LANES = 2 };
+
+			static Vector load(const Elem* data) { return _mm_loadu_pd(data); }
+			static Vector broadcast(Elem value) { return _mm_set1_pd(value); }
+
+			static unsigned compare(int operation, Vector elems, Vector constant)
+			{
+				__m128d result;
+				switch (operation)
+				{
+				case COMPARE_LESS: result = _mm_cmplt_pd(elems, constant); break;
+				case COMPARE_LESS_EQUAL: result = _mm_cmple_pd(elems, constant); break;
+				case COMPARE_GREATER: result = _mm_cmpgt_pd(elems, constant); break;
+				case COMPARE_GREATER_EQUAL: result = _mm_cmpge_pd(elems, constant); break;
+				case COMPARE_EQUAL: result = _mm_cmpeq_pd(elems, constant); break;
+				default: result = _mm_cmpneq_pd(elems, constant); break;
+				}
+				return (unsigned)_mm_movemask_pd(result);
+			}
+		};
+
+		XLINQ_COMPARE_KERNEL(compare_sse2, )
+#endif
+
+#ifdef XLINQ_REDUCE_AVX2
+		struct _Avx2Int32Compare
+		{
+			typedef std::int32_t Elem;
+			typedef __m256i Vector;
+			enum { LANES = 8 };
+
+			XLINQ_AVX2_TARGET static Vector load(const Elem* data) { return _mm256_loadu_si256((const __m256i*)data); }
+			XLINQ_AVX2_TARGET static Vector broadcast(Elem value) { return _mm256_set1_epi32(value); }
+
+			XLINQ_AVX2_TARGET static unsigned compare(int operation, Vector elems, Vector constant)
+			{
+				__m256i result;
+				if (operation == COMPARE_LESS || operation == COMPARE_GREATER_EQUAL)
+					result = _mm256_cmpgt_epi32(constant, elems);
+				else if (operation == COMPARE_GREATER || operation == COMPARE_LESS_EQUAL)
+					result = _mm256_cmpgt_epi32(elems, constant);
+				else
+					result = _mm256_cmpeq_epi32(elems, constant);
+				unsigned bits = (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(result));
+				return XLINQ_NEGATED_COMPARE(operation) ? bits ^ 0xFF : bits;
+			}
+		};
+
+		struct _Avx2Int64Compare
+		{
+			typedef std::int64_t Elem;
+			typedef __m256i Vector;
+			enum { LANES = 4 };
+
+			XLINQ_AVX2_TARGET static Vector load(const Elem* data) { return _mm256_loadu_si256((const __m256i*)data); }
+			XLINQ_AVX2_TARGET static Vector broadcast(Elem value) { return _mm256_set1_epi64x(value); }
+
+			XLINQ_AVX2_TARGET static unsigned compare(int operation, Vector elems, Vector constant)
+			{
+				__m256i result;
+				if (operation == COMPARE_LESS || operation == COMPARE_GREATER_EQUAL)
+					result = _mm256_cmpgt_epi64(constant, elems);
+				else if (operation == COMPARE_GREATER || operation == COMPARE_LESS_EQUAL)
+					result = _mm256_cmpgt_epi64(elems, constant);
+				else
+					result = _mm256_cmpeq_epi64(elems, constant);
+				unsigned bits = (unsigned)_mm256_movemask_pd(_mm256_castsi256_pd(result));
+				return XLINQ_NEGATED_COMPARE(operation) ? bits ^ 0xF : bits;
+			}
+		};
+
+		struct _Avx2FloatCompare
+		{
+			typedef float Elem;
+			typedef __m256 Vector;
+			enum { LANES = 8 };
+
+			XLINQ_AVX2_TARGET static Vector load(const Elem* data) { return _mm256_loadu_ps(data); }
+			XLINQ_AVX2_TARGET static Vector broadcast(Elem value) { return _mm256_set1_ps(value); }
+
+			XLINQ_AVX2_TARGET static unsigned compare(int operation, Vector elems, Vector constant)
+			{
+				__m256 result;
+				switch (operation)
+				{
+				case COMPARE_LESS: result = _mm256_cmp_ps(elems, constant, _CMP_LT_OQ); break;
+				case COMPARE_LESS_EQUAL: result = _mm256_cmp_ps(elems, constant, _CMP_LE_OQ); break;
+				case COMPARE_GREATER: result = _mm256_cmp_ps(elems, constant, _CMP_GT_OQ); break;
+				case COMPARE_GREATER_EQUAL: result = _mm256_cmp_ps(elems, constant, _CMP_GE_OQ); break;
+				case COMPARE_EQUAL: result = _mm256_cmp_ps(elems, constant, _CMP_EQ_OQ); break;
+				default: result = _mm256_cmp_ps(elems, constant, _CMP_NEQ_UQ); break;
+				}
+				return (unsigned)_mm256_movemask_ps(result);
+			}
+		};
+
+		struct _Avx2DoubleCompare
+		{
+			typedef double Elem;
+			typedef __m256d Vector;
+			enum { LANES = 4 };
+
+			XLINQ_AVX2_TARGET static Vector load(const Elem* data) { return _mm256_loadu_pd(data); }
+			XLINQ_AVX2_TARGET static Vector broadcast(Elem value) { return _mm256_set1_pd(value); }
+
+			XLINQ_AVX2_TARGET static unsigned compare(int operation, Vector elems, Vector constant)
+			{
+				__m256d result;
+				switch (operation)
+				{
+				case COMPARE_LESS: result = _mm256_cmp_pd(elems, constant, _CMP_LT_OQ); break;
+				case COMPARE_LESS_EQUAL: result = _mm256_cmp_pd(elems, constant, _CMP_LE_OQ); break;
+				case COMPARE_GREATER: result = _mm256_cmp_pd(elems, constant, _CMP_GT_OQ); break;
+				case COMPARE_GREATER_EQUAL: result = _mm256_cmp_pd(elems, constant, _CMP_GE_OQ); break;
+				case COMPARE_EQUAL: result = _mm256_cmp_pd(elems, constant, _CMP_EQ_OQ); break;
+				default: result = _mm256_cmp_pd(elems, constant, _CMP_NEQ_UQ); break;
+				}
+				return (unsigned)_mm256_movemask_pd(result);
+			}
+		};
+
+		XLINQ_COMPARE_KERNEL(compare_avx2, XLINQ_AVX2_TARGET)
+#define XLINQ_COMPARE_AVX2(TRAITS) TRAITS
+#else
+#define XLINQ_COMPARE_AVX2(TRAITS) void
+#endif
+
+#undef XLINQ_COMPARE_KERNEL
+#undef XLINQ_NEGATED_COMPARE
+
+		template<typename TElem, typename TEnable = void>
+		struct _CompareKernels
+		{
+			typedef void Sse2;
+			typedef void Avx2;
+		};
+
+#ifdef XLINQ_REDUCE_SSE2
+#define XLINQ_COMPARE_INT(TYPE, SIZE) (std::is_integral<TYPE>::value && std::is_signed<TYPE>::value && sizeof(TYPE) == SIZE)
+		template<typename TElem>
+		struct _CompareKernels<TElem, typename std::enable_if<XLINQ_COMPARE_INT(TElem, 4)>::type>
+		{
+			typedef _Sse2Int32Compare Sse2;
+			typedef XLINQ_COMPARE_AVX2(_Avx2Int32Compare) Avx2;
+		};
+
+		template<typename TElem>
+		struct _CompareKernels<TElem, typename std::enable_if<XLINQ_COMPARE_INT(TElem, 8)>::type>
+		{
+			typedef void Sse2;
+			typedef XLINQ_COMPARE_AVX2(_Avx2Int64Compare) Avx2;
+		};
+
+		template<>
+		struct _CompareKernels<float>
+		{
+			typedef _Sse2FloatCompare Sse2;
+			typedef XLINQ_COMPARE_AVX2(_Avx2FloatCompare) Avx2;
+		};
+
+		template<>
+		struct _CompareKernels<double>
+		{
+			typedef _Sse2DoubleCompare Sse2;
+			typedef XLINQ_COMPARE_AVX2(_Avx2DoubleCompare) Avx2;
+		};
+#undef XLINQ_COMPARE_INT
+#endif
+
+#undef XLINQ_COMPARE_AVX2
+
+		template<int OPERATION, typename TElem, typename TSse2>
+		std::uint64_t compare_with_sse2(const TElem* data, int size, TElem value, const TSse2*)
+		{
+#ifdef XLINQ_REDUCE_SSE2
+			return compare_sse2<TSse2, OPERATION>((const typename TSse2::Elem*)data, size, (typename TSse2::Elem)value);
+#else
+			return compare_scalar<OPERATION>(data, size, value);
+#endif
+		}
+
+		template<int OPERATION, typename TElem>
+		std::uint64_t compare_with_sse2(const TElem* data, int size, TElem value, const void*)
+		{
+			return compare_scalar<OPERATION>(data, size, value);
+		}
+
+		template<int OPERATION, typename TElem, typename TAvx2>
+		std::uint64_t compare_simd(const TElem* data, int size, TElem value, const TAvx2*)
+		{
+#ifdef XLINQ_REDUCE_AVX2
+			if (has_avx2())
+				return compare_avx2<TAvx2, OPERATION>((const typename TAvx2::Elem*)data, size, (typename TAvx2::Elem)value);
+#endif
+			return compare_with_sse2<OPERATION>(data, size, value, (const typename _CompareKernels<TElem>::Sse2*)nullptr);
+		}
+
+		template<int OPERATION, typename TElem>
+		std::uint64_t compare_simd(const TElem* data, int size, TElem value, const void*)
+		{
+			return compare_with_sse2<OPERATION>(data, size, value, (const typename _CompareKernels<TElem>::Sse2*)nullptr);
+		}
+
+		template<int OPERATION, typename TElem>
+		std::uint64_t compare_block(const TElem* data, int size, TElem value)
+		{
+			return compare_simd<OPERATION>(data, size, value, (const typename _CompareKernels<TElem>::Avx2*)nullptr);
+		}
+
+		template<typename TElem, typename TValue>
+		struct _IsVectorComparison
+		{
+			static const bool value =
+				(!std::is_void<typename _CompareKernels<TElem>::Sse2>::value || !std::is_void<typename _CompareKernels<TElem>::Avx2>::value) &&
+				(std::is_same<TElem, TValue>::value || (std::is_integral<TValue>::value && std::is_signed<TValue>::value && std::is_signed<TElem>::value));
+		};
+
+		template<typename TDerived>
+		class _PredicateExpression
+		{
+		public:
+			const TDerived& derived() const
+			{
+				return static_cast<const TDerived&>(*this);
+			}
+		};
+
+		template<typename TPredicate>
+		struct _IsPredicateExpression
+		{
+			static const bool value = std::is_base_of<_PredicateExpression<TPredicate>, TPredicate>::value;
+		};
+
+		class _ElementField
+		{
+		public:
+			template<typename TElem>
+			const TElem& operator()(const TElem& elem) const
+			{
+				return elem;
+			}
+		};
+
+		template<typename TClass, typename TMember>
+		class _MemberField
+		{
+		private:
+			TMember TClass::* _member;
+		public:
+			_MemberField(TMember TClass::* member) : _member(member) {}
+
+			const TMember& operator()(const TClass& elem) const
+			{
+				return elem.*_member;
+			}
+		};
+
+		template<typename TField, typename TValue, int OPERATION>
+		class _ComparisonPredicate : public _PredicateExpression<_ComparisonPredicate<TField, TValue, OPERATION>>
+		{
+		private:
+			TField _field;
+			TValue _value;
+
+			template<typename TElem>
+			std::uint64_t match(const TElem* data, int size, std::false_type) const
+			{
+				std::uint64_t result = 0;
+				for (int i = 0; i < size; ++i)
+					if ((*this)(data[i]))
+						result |= (std::uint64_t)1 << i;
+				return result;
+			}
+
+			template<typename TElem>
+			std::uint64_t match(const TElem* data, int size, std::true_type) const
+			{
+				TElem value = (TElem)_value;
+				if ((TValue)value != _value)
+					return match(data, size, std::false_type());
+				return compare_block<OPERATION>(data, size, value);
+			}
+		public:
+			_ComparisonPredicate(TField field, TValue value) : _field(field), _value(value) {}
+
+			template<typename TElem>
+			bool operator()(const TElem& elem) const
+			{
+				return _Compare<OPERATION>::apply(_field(elem), _value);
+			}
+
+			template<typename TElem>
+			std::uint64_t match(const TElem* data, int size) const
+			{
+				return match(data, size, std::integral_constant<bool,
+					std::is_same<TField, _ElementField>::value && _IsVectorComparison<TElem, TValue>::value>());
+			}
+		};
+
+		template<typename TLeft, typename TRight, bool CONJUNCTION>
+		class _LogicalPredicate : public _PredicateExpression<_LogicalPredicate<TLeft, TRight, CONJUNCTION>>
+		{
+		private:
+			TLeft _left;
+			TRight _right;
+		public:
+			_LogicalPredicate(const TLeft& left, const TRight& right) : _left(left), _right(right) {}
+
+			template<typename TElem>
+			bool operator()(const TElem& elem) const
+			{
+				return CONJUNCTION ? _left(elem) && _right(elem) : _left(elem) || _right(elem);
+			}
+
+			template<typename TElem>
+			std::uint64_t match(const TElem* data, int size) const
+			{
+				std::uint64_t left = _left.match(data, size);
+				if (CONJUNCTION)
+					return left ? left & _right.match(data, size) : 0;
+				return left | _right.match(data, size);
+			}
+		};
+
+		template<typename TOperand>
+		class _NegatedPredicate : public _PredicateExpression<_NegatedPredicate<TOperand>>
+		{
+		private:
+			TOperand _operand;
+		public:
+			_NegatedPredicate(const TOperand& operand) : _operand(operand) {}
+
+			template<typename TElem>
+			bool operator()(const TElem& elem) const
+			{
+				return !_operand(elem);
+			}
+
+			template<typename TElem>
+			std::uint64_t match(const TElem* data, int size) const
+			{
+				std::uint64_t valid = size == PREDICATE_BLOCK ? ~(std::uint64_t)0 : ((std::uint64_t)1 << size) - 1;
+				return ~_operand.match(data, size) & valid;
+			}
+		};
+
+		template<typename TField>
+		class _FieldExpression
+		{
+		private:
+			TField _field;
+		public:
+			_FieldExpression(TField field) : _field(field) {}
+
+			template<typename TValue>
+			_ComparisonPredicate<TField, TValue, COMPARE_LESS> operator<(const TValue& value) const
+			{
+				return _ComparisonPredicate<TField, TValue, COMPARE_LESS>(_field, value);
+			}
+
+			template<typename TValue>
+			_ComparisonPredicate<TField, TValue, COMPARE_LESS_EQUAL> operator<=(const TValue& value) const
+			{
+				return _ComparisonPredicate<TField, TValue, COMPARE_LESS_EQUAL>(_field, value);
+			}
+
+			template<typename TValue>
+			_ComparisonPredicate<TField, TValue, COMPARE_GREATER> operator>(const TValue& value) const
+			{
+				return _ComparisonPredicate<TField, TValue, COMPARE_GREATER>(_field, value);
+			}
+
+			template<typename TValue>
+			_ComparisonPredicate<TField, TValue, COMPARE_GREATER_EQUAL> operator>=(const TValue& value) const
+			{
+				return _ComparisonPredicate<TField, TValue, COMPARE_GREATER_EQUAL>(_field, value);
+			}
+
+			template<typename TValue>
+			_ComparisonPredicate<TField, TValue, COMPARE_EQUAL> operator==(const TValue& value) const
+			{
+				return _ComparisonPredicate<TField, TValue, COMPARE_EQUAL>(_field, value);
+			}
+
+			template<typename TValue>
+			_ComparisonPredicate<TField, TValue, COMPARE_NOT_EQUAL> operator!=(const TValue& value) const
+			{
+				return _ComparisonPredicate<TField, TValue, COMPARE_NOT_EQUAL>(_field, value);
+			}
+		};
+
+		template<typename TLeft, typename TRight>
+		_LogicalPredicate<TLeft, TRight, true> operator&&(const _PredicateExpression<TLeft>& left, const _PredicateExpression<TRight>& right)
+		{
+			return _LogicalPredicate<TLeft, TRight, true>(left.derived(), right.derived());
+		}
+
+		template<typename TLeft, typename TRight>
+		_LogicalPredicate<TLeft, TRight, false> operator||(const _PredicateExpression<TLeft>& left, const _PredicateExpression<TRight>& right)
+		{
+			return _LogicalPredicate<TLeft, TRight, false>(left.derived(), right.derived());
+		}
+
+		template<typename TOperand>
+		_NegatedPredicate<TOperand> operator!(const _PredicateExpression<TOperand>& operand)
+		{
+			return _NegatedPredicate<TOperand>(operand.derived());
+		}
+	}
+	/*@endcond*/
+
+	/**
+	*	Creates field of collection element used to build predicates.
+	*	Comparing the field with constant using <, <=, >, >=, == or != operator creates
+	*	predicate which may be passed to where or other functions accepting predicates.
+	*	Predicates may be combined using &&, || and ! operators. As with built-in
+	*	operators, right operand of && and || is not evaluated for an element when
+	*	left one decides the result. Blocks of elements skip right operand of &&
+	*	when left one matches none of them.
+	*	When elements are signed integers or floating point numbers stored contiguously
+	*	or read in batches, where evaluates such predicates for blocks of elements with
+	*	SSE2 or AVX2 instructions. Constants which can not be represented exactly as
+	*	element type are compared one element at a time.
+	*	@return Field representing whole collection element.
+	*/
+	XLINQ_INLINE internal::_FieldExpression<internal::_ElementField> field()
+	{
+		return internal::_FieldExpression<internal::_ElementField>(internal::_ElementField());
+	}
+
+	/**
+	*	Creates field of collection element used to build predicates.
+	*	Predicates built from member field are evaluated one element at a time.
+	*	@param member Pointer to member of collection element compared by predicate.
+	*	@return Field representing member of collection element.
+	*/
+	template<typename TClass, typename TMember>
+	internal::_FieldExpression<internal::_MemberField<TClass, TMember>> field(TMember TClass::* member)
+	{
+		return internal::_FieldExpression<internal::_MemberField<TClass, TMember>>(internal::_MemberField<TClass, TMember>(member));
+	}
+}
+
+#endif
\ No newline at end of file
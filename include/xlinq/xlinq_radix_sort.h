@@ -0,0 +1,172 @@
+/*
+MIT License
+
+Copyright (c) 2017 TrolleY
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+*	@file xlinq_radix_sort.h
+*	Stable radix sort of integral and floating point keys.
+*	@author TrolleY
+*/
+#ifndef XLINQ_RADIX_SORT_H_
+#define XLINQ_RADIX_SORT_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "xlinq_defs.h"
+
+namespace xlinq
+{
+	/*@cond XLINQ_INTERNAL*/
+	namespace internal
+	{
+		template<typename TKey, typename Enable = void>
+		struct _RadixTraits
+		{
+			static const bool value = false;
+			static const int bytes = 0;
+		};
+
+		template<typename TKey>
+		struct _RadixTraits<TKey, typename std::enable_if<std::is_integral<TKey>::value && !std::is_same<TKey, bool>::value>::type>
+		{
+			typedef typename std::make_unsigned<TKey>::type TBits;
+
+			static const bool value = true;
+			static const int bytes = sizeof(TKey);
+
+			static unsigned byte(TKey key, int index)
+			{
+				TBits bits = (TBits)key;
+				if (std::is_signed<TKey>::value)
+					bits ^= (TBits)((TBits)1 << (sizeof(TKey) * 8 - 1));
+				return (unsigned)(bits >> (index * 8)) & 0xFF;
+			}
+		};
+
+		template<typename TKey>
+		struct _RadixTraits<TKey, typename std::enable_if<std::is_floating_point<TKey>::value && (sizeof(TKey) == 4 || sizeof(TKey) == 8)>::type>
+		{
+			typedef typename std::conditional<sizeof(TKey) == 4, std::uint32_t, std::uint64_t>::type TBits;
+
+			static const bool value = true;
+			static const int bytes = sizeof(TKey);
+
+			static unsigned byte(TKey key, int index)
+			{
+				if (key == 0)
+					key = 0;
+				TBits bits;
+				std::memcpy(&bits, &key, sizeof(TKey));
+				TBits sign = (TBits)1 << (sizeof(TKey) * 8 - 1);
+				bits = (bits & sign) ? ~bits : (bits | sign);
+				return (unsigned)(bits >> (index * 8)) & 0xFF;
+			}
+		};
+
+		template<typename TTuple, std::size_t COUNT>
+		struct _RadixTupleTraits
+		{
+			typedef typename std::tuple_element<COUNT - 1, TTuple>::type TLast;
+			typedef _RadixTupleTraits<TTuple, COUNT - 1> TInit;
+
+			static const bool value = _RadixTraits<TLast>::value && TInit::value;
+			static const int bytes = _RadixTraits<TLast>::bytes + TInit::bytes;
+
+			static unsigned byte(const TTuple& key, int index)
+			{
+				return index < _RadixTraits<TLast>::bytes ?
+					_RadixTraits<TLast>::byte(std::get<COUNT - 1>(key), index) :
+					TInit::byte(key, index - _RadixTraits<TLast>::bytes);
+			}
+		};
+
+		template<typename TTuple>
+		struct _RadixTupleTraits<TTuple, 0>
+		{
+			static const bool value = true;
+			static const int bytes = 0;
+
+			static unsigned byte(const TTuple&, int)
+			{
+				return 0;
+			}
+		};
+
+		template<typename... TElems>
+		struct _RadixTraits<std::tuple<TElems...>, void> : public _RadixTupleTraits<std::tuple<TElems...>, sizeof...(TElems)> {};
+
+		template<typename TFirst, typename TSecond>
+		struct _RadixTraits<std::pair<TFirst, TSecond>, void> : public _RadixTupleTraits<std::pair<TFirst, TSecond>, 2> {};
+
+		struct _RadixIdentity
+		{
+			template<typename TItem>
+			const TItem& operator()(const TItem& item) const
+			{
+				return item;
+			}
+		};
+
+		struct _RadixFirst
+		{
+			template<typename TItem>
+			const typename TItem::first_type& operator()(const TItem& item) const
+			{
+				return item.first;
+			}
+		};
+
+		template<typename TKey, typename TItem, typename TKeyOf>
+		void radix_sort(std::vector<TItem>& items, TKeyOf keyOf)
+		{
+			std::vector<TItem> buffer(items.size());
+			std::vector<std::size_t> offsets(256);
+			for (int index = 0; index < _RadixTraits<TKey>::bytes; ++index)
+			{
+				std::fill(offsets.begin(), offsets.end(), 0);
+				for (auto& item : items)
+					++offsets[_RadixTraits<TKey>::byte(keyOf(item), index)];
+				if (std::find(offsets.begin(), offsets.end(), items.size()) != offsets.end())
+					continue;
+				std::size_t offset = 0;
+				for (auto& count : offsets)
+				{
+					auto current = count;
+					count = offset;
+					offset += current;
+				}
+				for (auto& item : items)
+					buffer[offsets[_RadixTraits<TKey>::byte(keyOf(item), index)]++] = std::move(item);
+				items.swap(buffer);
+			}
+		}
+	}
+	/*@endcond*/
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,867 @@
+/*
+MIT License
+
+Copyright (c) 2017 TrolleY
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+*	@file xlinq_reduce.h
+*	Vectorized reductions and summation modes of arithmetic elements.
+*	@author TrolleY
+*/
+#ifndef XLINQ_REDUCE_H_
+#define XLINQ_REDUCE_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+#include "xlinq_defs.h"
+#include "xlinq_base.h"
+
+#if XLINQ_SIMD && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define XLINQ_REDUCE_SSE2
+#include <emmintrin.h>
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define XLINQ_REDUCE_AVX2
+#define XLINQ_AVX2_TARGET __attribute__((target("avx2")))
+#include <immintrin.h>
+#endif
+#endif
+
+namespace xlinq
+{
+	/**
+	*	Summation algorithm used by sum and avg.
+	*	It may be passed to mode method of builders returned by sum and avg.
+	*	It changes results only when elements are accumulated as floating point numbers.
+	*/
+	enum class SumMode
+	{
+		/**
+		*	Elements are added in several independent vector lanes.
+		*/
+		FAST,
+		/**
+		*	Sums of small blocks of elements are added in pairs, so rounding error grows
+		*	with logarithm of number of elements.
+		*/
+		PAIRWISE,
+		/**
+		*	Rounding error of every addition is accumulated separately with
+		*	Kahan-Neumaier algorithm, so it does not grow with number of elements.
+		*/
+		KAHAN
+	};
+
+	/*@cond XLINQ_INTERNAL*/
+	namespace internal
+	{
+		enum _ReduceOperation { REDUCE_SUM, REDUCE_MIN, REDUCE_MAX };
+
+		template<typename TResult, typename TElem, int OPERATION>
+		struct _ScalarReduce
+		{
+			static TResult apply(TResult result, const TElem& elem)
+			{
+				result += (TResult)elem;
+				return result;
+			}
+
+			static TResult reduce(TResult result, const TElem* data, int size)
+			{
+				for (int i = 0; i < size; ++i)
+					result = apply(result, data[i]);
+				return result;
+			}
+		};
+
+		template<typename TResult, typename TElem>
+		struct _ScalarReduce<TResult, TElem, REDUCE_MIN>
+		{
+			static TResult apply(TResult result, const TElem& elem)
+			{
+				return result > (TResult)elem ? (TResult)elem : result;
+			}
+
+			static TResult reduce(TResult result, const TElem* data, int size)
+			{
+				for (int i = 0; i < size; ++i)
+					result = apply(result, data[i]);
+				return result;
+			}
+		};
+
+		template<typename TResult, typename TElem>
+		struct _ScalarReduce<TResult, TElem, REDUCE_MAX>
+		{
+			static TResult apply(TResult result, const TElem& elem)
+			{
+				return result < (TResult)elem ? (TResult)elem : result;
+			}
+
+			static TResult reduce(TResult result, const TElem* data, int size)
+			{
+				for (int i = 0; i < size; ++i)
+					result = apply(result, data[i]);
+				return result;
+			}
+		};
+
+		template<typename TAcc>
+		class _NeumaierSum
+		{
+		private:
+			TAcc _sum;
+			TAcc _compensation;
+		public:
+			_NeumaierSum() : _sum(0), _compensation(0) {}
+
+			void add(TAcc value)
+			{
+				TAcc total = _sum + value;
+				if ((_sum < 0 ? -_sum : _sum) >= (value < 0 ? -value : value))
+					_compensation += (_sum - total) + value;
+				else
+					_compensation += (value - total) + _sum;
+				_sum = total;
+			}
+
+			void compensate(TAcc value)
+			{
+				_compensation += value;
+			}
+
+			TAcc result() const
+			{
+				return _sum + _compensation;
+			}
+		};
+
+#define XLINQ_REDUCE_KERNEL(NAME, TARGET) \
+		template<typename TTraits, int OPERATION> \
+		TARGET typename TTraits::Result NAME(const typename TTraits::Elem* data, int size) \
+		{ \
+			typedef typename TTraits::Result TResult; \
+			typedef typename TTraits::Vector TVector; \
+			const int step = 4 * TTraits::LANES; \
+			TVector first = TTraits::load(data), second = TTraits::load(data + TTraits::LANES); \
+			TVector third = TTraits::load(data + 2 * TTraits::LANES), fourth = TTraits::load(data + 3 * TTraits::LANES); \
+			int i = step; \
+			for (; i + step <= size; i += step) \
+			{ \
+				first = TTraits::apply(OPERATION, first, TTraits::load(data + i)); \
+				second = TTraits::apply(OPERATION, second, TTraits::load(data + i + TTraits::LANES)); \
+				third = TTraits::apply(OPERATION, third, TTraits::load(data + i + 2 * TTraits::LANES)); \
+				fourth = TTraits::apply(OPERATION, fourth, TTraits::load(data + i + 3 * TTraits::LANES)); \
+			} \
+			first = TTraits::apply(OPERATION, TTraits::apply(OPERATION, first, second), TTraits::apply(OPERATION, third, fourth)); \
+			TResult lanes[TTraits::LANES]; \
+			TTraits::store(lanes, first); \
+			TResult result = lanes[0]; \
+			for (int lane = 1; lane < TTraits::LANES; ++lane) \
+				result = _ScalarReduce<TResult, TResult, OPERATION>::apply(result, lanes[lane]); \
+			return _ScalarReduce<TResult, typename TTraits::Elem, OPERATION>::reduce(result, data + i, size - i); \
+		}
+
+#define XLINQ_DEVIATION_KERNEL(NAME, TARGET) \
+		template<typename TTraits> \
+		TARGET double NAME(const typename TTraits::Elem* data, int size, double mean) \
+		{ \
+			typedef typename TTraits::Vector TVector; \
+			TVector center = TTraits::broadcast(mean); \
+			TVector first = TTraits::zero(), second = TTraits::zero(); \
+			int i = 0; \
+			for (; i + 2 * TTraits::LANES <= size; i += 2 * TTraits::LANES) \
+			{ \
+				first = TTraits::squared_deviation(first, TTraits::load(data + i), center); \
+				second = TTraits::squared_deviation(second, TTraits::load(data + i + TTraits::LANES), center); \
+			} \
+			double lanes[2][TTraits::LANES]; \
+			TTraits::store(lanes[0], first); \
+			TTraits::store(lanes[1], second); \
+			double result = 0; \
+			for (int lane = 0; lane < TTraits::LANES; ++lane) \
+				result += lanes[0][lane] + lanes[1][lane]; \
+			for (; i < size; ++i) \
+				result += ((double)data[i] - mean) * ((double)data[i] - mean); \
+			return result; \
+		}
+
+#define XLINQ_COMPENSATED_KERNEL(NAME, TARGET) \
+		template<typename TTraits> \
+		TARGET void NAME(const typename TTraits::Elem* data, int size, _NeumaierSum<typename TTraits::Result>& total) \
+		{ \
+			typedef typename TTraits::Result TResult; \
+			typedef typename TTraits::Vector TVector; \
+			const int step = 2 * TTraits::LANES; \
+			TVector firstSum = TTraits::load(data), secondSum = TTraits::load(data + TTraits::LANES); \
+			TVector firstCompensation = TTraits::zero(), secondCompensation = TTraits::zero(); \
+			int i = step; \
+			for (; i + step <= size; i += step) \
+			{ \
+				TTraits::neumaier(firstSum, firstCompensation, TTraits::load(data + i)); \
+				TTraits::neumaier(secondSum, secondCompensation, TTraits::load(data + i + TTraits::LANES)); \
+			} \
+			TResult lanes[4][TTraits::LANES]; \
+			TTraits::store(lanes[0], firstSum); \
+			TTraits::store(lanes[1], secondSum); \
+			TTraits::store(lanes[2], firstCompensation); \
+			TTraits::store(lanes[3], secondCompensation); \
+			for (int lane = 0; lane < TTraits::LANES; ++lane) \
+			{ \
+				total.add(lanes[0][lane]); \
+				total.add(lanes[1][lane]); \
+				total.compensate(lanes[2][lane] + lanes[3][lane]); \
+			} \
+			for (; i < size; ++i) \
+				total.add((TResult)data[i]); \
+		}
+
+#ifdef XLINQ_REDUCE_SSE2
+		struct _Sse2Int32
+		{
+			typedef std::int32_t Elem;
+			typedef std::int32_t Result;
+			typedef __m128i Vector;
+			enum { LANES = 4, MIN_MAX = 1 };
+
+			static Vector load(const Elem* data) { return _mm_loadu_si128((const __m128i*)data); }
+			static void store(Result* data, Vector value) { _mm_storeu_si128((__m128i*)data, value); }
+
+			static Vector apply(int operation, Vector result, Vector value)
+			{
+				if (operation == REDUCE_SUM)
+					return _mm_add_epi32(result, value);
+				__m128i replace = operation == REDUCE_MIN ? _mm_cmpgt_epi32(result, value) : _mm_cmplt_epi32(result, value);
+				return _mm_or_si128(_mm_and_si128(replace, value), _mm_andnot_si128(replace, result));
+			}
+		};
+
+		struct _Sse2Int64
+		{
+			typedef std::int64_t Elem;
+			typedef std::int64_t Result;
+			typedef __m128i Vector;
+			enum { LANES = 2, MIN_MAX = 0 };
+
+			static Vector load(const Elem* data) { return _mm_loadu_si128((const __m128i*)data); }
+			static void store(Result* data, Vector value) { _mm_storeu_si128((__m128i*)data, value); }
+			static Vector apply(int, Vector result, Vector value) { return _mm_add_epi64(result, value); }
+		};
+
+		struct _Sse2FloatOps
+		{
+			typedef __m128 Vector;
+
+			static Vector zero() { return _mm_setzero_ps(); }
+
+			static void neumaier(Vector& sum, Vector& compensation, Vector value)
+			{
+				__m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+				__m128 total = _mm_add_ps(sum, value);
+				__m128 larger = _mm_cmpge_ps(_mm_and_ps(sum, absMask), _mm_and_ps(value, absMask));
+				__m128 big = _mm_or_ps(_mm_and_ps(larger, sum), _mm_andnot_ps(larger, value));
+				__m128 small = _mm_or_ps(_mm_and_ps(larger, value), _mm_andnot_ps(larger, sum));
+				compensation = _mm_add_ps(compensation, _mm_add_ps(_mm_sub_ps(big, total), small));
+				sum = total;
+			}
+		};
+
+		struct _Sse2DoubleOps
+		{
+			typedef __m128d Vector;
+
+			static Vector zero() { return _mm_setzero_pd(); }
+			static Vector broadcast(double value) { return _mm_set1_pd(value); }
+
+			static Vector squared_deviation(Vector result, Vector value, Vector mean)
+			{
+				__m128d deviation = _mm_sub_pd(value, mean);
+				return _mm_add_pd(result, _mm_mul_pd(deviation, deviation));
+			}
+
+			static void neumaier(Vector& sum, Vector& compensation, Vector value)
+			{
+				__m128d absMask = _mm_castsi128_pd(_mm_set_epi32(0x7FFFFFFF, -1, 0x7FFFFFFF, -1));
+				__m128d total = _mm_add_pd(sum, value);
+				__m128d larger = _mm_cmpge_pd(_mm_and_pd(sum, absMask), _mm_and_pd(value, absMask));
+				__m128d big = _mm_or_pd(_mm_and_pd(larger, sum), _mm_andnot_pd(larger, value));
+				__m128d small = _mm_or_pd(_mm_and_pd(larger, value), _mm_andnot_pd(larger, sum));
+				compensation = _mm_add_pd(compensation, _mm_add_pd(_mm_sub_pd(big, total), small));
+				sum = total;
+			}
+		};
+
+		struct _Sse2Int32ToInt64
+		{
+			typedef std::int32_t Elem;
+			typedef std::int64_t Result;
+			typedef __m128i Vector;
+			enum { LANES = 2, MIN_MAX = 0 };
+
+			static Vector load(const Elem* data)
+			{
+				__m128i value = _mm_loadl_epi64((const __m128i*)data);
+				return _mm_unpacklo_epi32(value, _mm_cmpgt_epi32(_mm_setzero_si128(), value));
+			}
+
+			static void store(Result* data, Vector value) { _mm_storeu_si128((__m128i*)data, value); }
+			static Vector apply(int, Vector result, Vector value) { return _mm_add_epi64(result, value); }
+		};
+
+		struct _Sse2Float : _Sse2FloatOps
+		{
+			typedef float Elem;
+			typedef float Result;
+			enum { LANES = 4, MIN_MAX = 1 };
+
+			static Vector load(const Elem* data) { return _mm_loadu_ps(data); }
+			static void store(Result* data, Vector value) { _mm_storeu_ps(data, value); }
+
+			static Vector apply(int operation, Vector result, Vector value)
+			{
+				if (operation == REDUCE_SUM)
+					return _mm_add_ps(result, value);
+				return operation == REDUCE_MIN ? _mm_min_ps(value, result) : _mm_max_ps(value, result);
+			}
+		};
+
+		struct _Sse2Double : _Sse2DoubleOps
+		{
+			typedef double Elem;
+			typedef double Result;
+			enum { LANES = 2, MIN_MAX = 1 };
+
+			static Vector load(const Elem* data) { return _mm_loadu_pd(data); }
+			static void store(Result* data, Vector value) { _mm_storeu_pd(data, value); }
+
+			static Vector apply(int operation, Vector result, Vector value)
+			{
+				if (operation == REDUCE_SUM)
+					return _mm_add_pd(result, value);
+				return operation == REDUCE_MIN ? _mm_min_pd(value, result) : _mm_max_pd(value, result);
+			}
+		};
+
+		struct _Sse2Int32ToDouble : _Sse2DoubleOps
+		{
+			typedef std::int32_t Elem;
+			typedef double Result;
+			enum { LANES = 2, MIN_MAX = 0 };
+
+			static Vector load(const Elem* data) { return _mm_cvtepi32_pd(_mm_loadl_epi64((const __m128i*)data)); }
+			static void store(Result* data, Vector value) { _mm_storeu_pd(data, value); }
+			static Vector apply(int, Vector result, Vector value) { return _mm_add_pd(result, value); }
+		};
+
+		struct _Sse2FloatToDouble : _Sse2DoubleOps
+		{
+			typedef float Elem;
+			typedef double Result;
+			enum { LANES = 2, MIN_MAX = 0 };
+
+			static Vector load(const Elem* data) { return _mm_cvtps_pd(_mm_castpd_ps(_mm_load_sd((const double*)data))); }
+			static void store(Result* data, Vector value) { _mm_storeu_pd(data, value); }
+			static Vector apply(int, Vector result, Vector value) { return _mm_add_pd(result, value); }
+		};
+
+		XLINQ_REDUCE_KERNEL(reduce_sse2, )
+		XLINQ_COMPENSATED_KERNEL(compensated_sse2, )
+		XLINQ_DEVIATION_KERNEL(deviation_sse2, )
+#endif
+
+#ifdef XLINQ_REDUCE_AVX2
+		inline bool has_avx2()
+		{
+			static const bool supported = (__builtin_cpu_init(), __builtin_cpu_supports("avx2") != 0);
+			return supported;
+		}
+
+		struct _Avx2Int32
+		{
+			typedef std::int32_t Elem;
+			typedef std::int32_t Result;
+			typedef __m256i Vector;
+			enum { LANES = 8, MIN_MAX = 1 };
+
+			XLINQ_AVX2_TARGET static Vector load(const Elem* data) { return _mm256_loadu_si256((const __m256i*)data); }
+			XLINQ_AVX2_TARGET static void store(Result* data, Vector value) { _mm256_storeu_si256((__m256i*)data, value); }
+
+			XLINQ_AVX2_TARGET static Vector apply(int operation, Vector result, Vector value)
+			{
+				if (operation == REDUCE_SUM)
+					return _mm256_add_epi32(result, value);
+				return operation == REDUCE_MIN ? _mm256_min_epi32(result, value) : _mm256_max_epi32(result, value);
+			}
+		};
+
+		struct _Avx2Int64
+		{
+			typedef std::int64_t Elem;
+			typedef std::int64_t Result;
+			typedef __m256i Vector;
+			enum { LANES = 4, MIN_MAX = 1 };
+
+			XLINQ_AVX2_TARGET static Vector load(const Elem* data) { return _mm256_loadu_si256((const __m256i*)data); }
+			XLINQ_AVX2_TARGET static void store(Result* data, Vector value) { _mm256_storeu_si256((__m256i*)data, value); }
+
+			XLINQ_AVX2_TARGET static Vector apply(int operation, Vector result, Vector value)
+			{
+				if (operation == REDUCE_SUM)
+					return _mm256_add_epi64(result, value);
+				__m256i replace = operation == REDUCE_MIN ? _mm256_cmpgt_epi64(result, value) : _mm256_cmpgt_epi64(value, result);
+				return _mm256_blendv_epi8(result, value, replace);
+			}
+		};
+
+		struct _Avx2FloatOps
+		{
+			typedef __m256 Vector;
+
+			XLINQ_AVX2_TARGET static Vector zero() { return _mm256_setzero_ps(); }
+
+			XLINQ_AVX2_TARGET static void neumaier(Vector& sum, Vector& compensation, Vector value)
+			{
+				__m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+				__m256 total = _mm256_add_ps(sum, value);
+				__m256 larger = _mm256_cmp_ps(_mm256_and_ps(sum, absMask), _mm256_and_ps(value, absMask), _CMP_GE_OQ);
+				__m256 big = _mm256_blendv_ps(value, sum, larger);
+				__m256 small = _mm256_blendv_ps(sum, value, larger);
+				compensation = _mm256_add_ps(compensation, _mm256_add_ps(_mm256_sub_ps(big, total), small));
+				sum = total;
+			}
+		};
+
+		struct _Avx2DoubleOps
+		{
+			typedef __m256d Vector;
+
+			XLINQ_AVX2_TARGET static Vector zero() { return _mm256_setzero_pd(); }
+			XLINQ_AVX2_TARGET static Vector broadcast(double value) { return _mm256_set1_pd(value); }
+
+			XLINQ_AVX2_TARGET static Vector squared_deviation(Vector result, Vector value, Vector mean)
+			{
+				__m256d deviation = _mm256_sub_pd(value, mean);
+				return _mm256_add_pd(result, _mm256_mul_pd(deviation, deviation));
+			}
+
+			XLINQ_AVX2_TARGET static void neumaier(Vector& sum, Vector& compensation, Vector value)
+			{
+				__m256d absMask = _mm256_castsi256_pd(_mm256_set1_epi64x(0x7FFFFFFFFFFFFFFFLL));
+				__m256d total = _mm256_add_pd(sum, value);
+				__m256d larger = _mm256_cmp_pd(_mm256_and_pd(sum, absMask), _mm256_and_pd(value, absMask), _CMP_GE_OQ);
+				__m256d big = _mm256_blendv_pd(value, sum, larger);
+				__m256d small = _mm256_blendv_pd(sum, value, larger);
+				compensation = _mm256_add_pd(compensation, _mm256_add_pd(_mm256_sub_pd(big, total), small));
+				sum = total;
+			}
+		};
+
+		struct _Avx2Int32ToInt64
+		{
+			typedef std::int32_t Elem;
+			typedef std::int64_t Result;
+			typedef __m256i Vector;
+			enum { LANES = 4, MIN_MAX = 0 };
+
+			XLINQ_AVX2_TARGET static Vector load(const Elem* data) { return _mm256_cvtepi32_epi64(_mm_loadu_si128((const __m128i*)data)); }
+			XLINQ_AVX2_TARGET static void store(Result* data, Vector value) { _mm256_storeu_si256((__m256i*)data, value); }
+			XLINQ_AVX2_TARGET static Vector apply(int, Vector result, Vector value) { return _mm256_add_epi64(result, value); }
+		};
+
+		struct _Avx2Float : _Avx2FloatOps
+		{
+			typedef float Elem;
+			typedef float Result;
+			enum { LANES = 8, MIN_MAX = 1 };
+
+			XLINQ_AVX2_TARGET static Vector load(const Elem* data) { return _mm256_loadu_ps(data); }
+			XLINQ_AVX2_TARGET static void store(Result* data, Vector value) { _mm256_storeu_ps(data, value); }
+
+			XLINQ_AVX2_TARGET static Vector apply(int operation, Vector result, Vector value)
+			{
+				if (operation == REDUCE_SUM)
+					return _mm256_add_ps(result, value);
+				return operation == REDUCE_MIN ? _mm256_min_ps(value, result) : _mm256_max_ps(value, result);
+			}
+		};
+
+		struct _Avx2Double : _Avx2DoubleOps
+		{
+			typedef double Elem;
+			typedef double Result;
+			enum { LANES = 4, MIN_MAX = 1 };
+
+			XLINQ_AVX2_TARGET static Vector load(const Elem* data) { return _mm256_loadu_pd(data); }
+			XLINQ_AVX2_TARGET static void store(Result* data, Vector value) { _mm256_storeu_pd(data, value); }
+
+			XLINQ_AVX2_TARGET static Vector apply(int operation, Vector result, Vector value)
+			{
+				if (operation == REDUCE_SUM)
+					return _mm256_add_pd(result, value);
+				return operation == REDUCE_MIN ? _mm256_min_pd(value, result) : _mm256_max_pd(value, result);
+			}
+		};
+
+		struct _Avx2Int32ToDouble : _Avx2DoubleOps
+		{
+			typedef std::int32_t Elem;
+			typedef double Result;
+			enum { LANES = 4, MIN_MAX = 0 };
+
+			XLINQ_AVX2_TARGET static Vector load(const Elem* data) { return _mm256_cvtepi32_pd(_mm_loadu_si128((const __m128i*)data)); }
+			XLINQ_AVX2_TARGET static void store(Result* data, Vector value) { _mm256_storeu_pd(data, value); }
+			XLINQ_AVX2_TARGET static Vector apply(int, Vector result, Vector value) { return _mm256_add_pd(result, value); }
+		};
+
+		struct _Avx2FloatToDouble : _Avx2DoubleOps
+		{
+			typedef float Elem;
+			typedef double Result;
+			enum { LANES = 4, MIN_MAX = 0 };
+
+			XLINQ_AVX2_TARGET static Vector load(const Elem* data) { return _mm256_cvtps_pd(_mm_loadu_ps(data)); }
+			XLINQ_AVX2_TARGET static void store(Result* data, Vector value) { _mm256_storeu_pd(data, value); }
+			XLINQ_AVX2_TARGET static Vector apply(int, Vector result, Vector value) { return _mm256_add_pd(result, value); }
+		};
+
+		XLINQ_REDUCE_KERNEL(reduce_avx2, XLINQ_AVX2_TARGET)
+		XLINQ_COMPENSATED_KERNEL(compensated_avx2, XLINQ_AVX2_TARGET)
+		XLINQ_DEVIATION_KERNEL(deviation_avx2, XLINQ_AVX2_TARGET)
+#endif
+
+#undef XLINQ_REDUCE_KERNEL
+#undef XLINQ_COMPENSATED_KERNEL
+#undef XLINQ_DEVIATION_KERNEL
+
+		template<typename TResult, typename TElem, typename TEnable = void>
+		struct _ReduceKernels
+		{
+			typedef void Sse2;
+			typedef void Avx2;
+		};
+
+#ifdef XLINQ_REDUCE_SSE2
+#ifdef XLINQ_REDUCE_AVX2
+#define XLINQ_REDUCE_KERNELS(RESULT, ELEM, SSE2, AVX2) \
+		template<typename TResult, typename TElem> \
+		struct _ReduceKernels<TResult, TElem, typename std::enable_if<RESULT && ELEM>::type> \
+		{ \
+			typedef SSE2 Sse2; \
+			typedef AVX2 Avx2; \
+		};
+#else
+#define XLINQ_REDUCE_KERNELS(RESULT, ELEM, SSE2, AVX2) \
+		template<typename TResult, typename TElem> \
+		struct _ReduceKernels<TResult, TElem, typename std::enable_if<RESULT && ELEM>::type> \
+		{ \
+			typedef SSE2 Sse2; \
+			typedef void Avx2; \
+		};
+#endif
+#define XLINQ_REDUCE_INT(T, SIZE) (std::is_integral<T>::value && std::is_signed<T>::value && sizeof(T) == SIZE)
+
+		XLINQ_REDUCE_KERNELS(XLINQ_REDUCE_INT(TResult, 4), (std::is_same<TResult, TElem>::value), _Sse2Int32, _Avx2Int32)
+		XLINQ_REDUCE_KERNELS(XLINQ_REDUCE_INT(TResult, 8), (std::is_same<TResult, TElem>::value), _Sse2Int64, _Avx2Int64)
+		XLINQ_REDUCE_KERNELS(XLINQ_REDUCE_INT(TResult, 8), XLINQ_REDUCE_INT(TElem, 4), _Sse2Int32ToInt64, _Avx2Int32ToInt64)
+		XLINQ_REDUCE_KERNELS((std::is_same<TResult, float>::value), (std::is_same<TElem, float>::value), _Sse2Float, _Avx2Float)
+		XLINQ_REDUCE_KERNELS((std::is_same<TResult, double>::value), (std::is_same<TElem, double>::value), _Sse2Double, _Avx2Double)
+		XLINQ_REDUCE_KERNELS((std::is_same<TResult, double>::value), XLINQ_REDUCE_INT(TElem, 4), _Sse2Int32ToDouble, _Avx2Int32ToDouble)
+		XLINQ_REDUCE_KERNELS((std::is_same<TResult, double>::value), (std::is_same<TElem, float>::value), _Sse2FloatToDouble, _Avx2FloatToDouble)
+
+#undef XLINQ_REDUCE_INT
+#undef XLINQ_REDUCE_KERNELS
+#endif
+
+		template<typename TResult, int OPERATION, typename TElem>
+		TResult reduce_scalar(const TElem* data, int size)
+		{
+			return _ScalarReduce<TResult, TElem, OPERATION>::reduce((TResult)data[0], data + 1, size - 1);
+		}
+
+		template<typename TResult, int OPERATION, typename TElem, typename TAvx2>
+		TResult reduce_with_avx2(const TElem* data, int size, const TAvx2*)
+		{
+#ifdef XLINQ_REDUCE_AVX2
+			if ((OPERATION == REDUCE_SUM || TAvx2::MIN_MAX) && size >= 4 * TAvx2::LANES)
+				return (TResult)reduce_avx2<TAvx2, OPERATION>((const typename TAvx2::Elem*)data, size);
+#endif
+			return reduce_scalar<TResult, OPERATION>(data, size);
+		}
+
+		template<typename TResult, int OPERATION, typename TElem>
+		TResult reduce_with_avx2(const TElem* data, int size, const void*)
+		{
+			return reduce_scalar<TResult, OPERATION>(data, size);
+		}
+
+		template<typename TResult, int OPERATION, typename TElem, typename TSse2>
+		TResult reduce_simd(const TElem* data, int size, const TSse2*)
+		{
+#ifdef XLINQ_REDUCE_AVX2
+			typedef typename _ReduceKernels<TResult, TElem>::Avx2 TAvx2;
+			if (has_avx2())
+				return reduce_with_avx2<TResult, OPERATION>(data, size, (const TAvx2*)nullptr);
+#endif
+#ifdef XLINQ_REDUCE_SSE2
+			if ((OPERATION == REDUCE_SUM || TSse2::MIN_MAX) && size >= 4 * TSse2::LANES)
+				return (TResult)reduce_sse2<TSse2, OPERATION>((const typename TSse2::Elem*)data, size);
+#endif
+			return reduce_scalar<TResult, OPERATION>(data, size);
+		}
+
+		template<typename TResult, int OPERATION, typename TElem>
+		TResult reduce_simd(const TElem* data, int size, const void*)
+		{
+			return reduce_scalar<TResult, OPERATION>(data, size);
+		}
+
+		template<typename TResult, int OPERATION, typename TElem>
+		TResult reduce_span(const TElem* data, int size)
+		{
+			return reduce_simd<TResult, OPERATION>(data, size, (const typename _ReduceKernels<TResult, TElem>::Sse2*)nullptr);
+		}
+
+		template<typename TResult, int OPERATION, typename TElem>
+		TResult reduce_batch(const std::vector<TElem>& batch)
+		{
+			return reduce_span<TResult, OPERATION>(batch.data(), (int)batch.size());
+		}
+
+		template<typename TResult, int OPERATION>
+		TResult reduce_batch(const std::vector<bool>& batch)
+		{
+			TResult result = (TResult)batch[0];
+			for (std::size_t i = 1; i < batch.size(); ++i)
+				result = _ScalarReduce<TResult, bool, OPERATION>::apply(result, batch[i]);
+			return result;
+		}
+
+		template<typename TAcc, typename TElem>
+		void compensated_scalar(const TElem* data, int size, _NeumaierSum<TAcc>& total)
+		{
+			for (int i = 0; i < size; ++i)
+				total.add((TAcc)data[i]);
+		}
+
+		template<typename TAcc, typename TElem, typename TSse2>
+		void compensated_simd(const TElem* data, int size, _NeumaierSum<TAcc>& total, const TSse2*)
+		{
+#ifdef XLINQ_REDUCE_AVX2
+			typedef typename _ReduceKernels<TAcc, TElem>::Avx2 TAvx2;
+			if (has_avx2())
+			{
+				if (size >= 2 * TAvx2::LANES)
+					compensated_avx2<TAvx2>((const typename TAvx2::Elem*)data, size, total);
+				else
+					compensated_scalar(data, size, total);
+				return;
+			}
+#endif
+#ifdef XLINQ_REDUCE_SSE2
+			if (size >= 2 * TSse2::LANES)
+			{
+				compensated_sse2<TSse2>((const typename TSse2::Elem*)data, size, total);
+				return;
+			}
+#endif
+			compensated_scalar(data, size, total);
+		}
+
+		template<typename TAcc, typename TElem>
+		void compensated_simd(const TElem* data, int size, _NeumaierSum<TAcc>& total, const void*)
+		{
+			compensated_scalar(data, size, total);
+		}
+
+		template<typename TElem>
+		double deviation_scalar(const TElem* data, int size, double mean)
+		{
+			double result = 0;
+			for (int i = 0; i < size; ++i)
+				result += ((double)data[i] - mean) * ((double)data[i] - mean);
+			return result;
+		}
+
+		template<typename TElem, typename TSse2>
+		double deviation_simd(const TElem* data, int size, double mean, const TSse2*)
+		{
+#ifdef XLINQ_REDUCE_AVX2
+			typedef typename _ReduceKernels<double, TElem>::Avx2 TAvx2;
+			if (has_avx2())
+				return deviation_avx2<TAvx2>((const typename TAvx2::Elem*)data, size, mean);
+#endif
+#ifdef XLINQ_REDUCE_SSE2
+			return deviation_sse2<TSse2>((const typename TSse2::Elem*)data, size, mean);
+#else
+			return deviation_scalar(data, size, mean);
+#endif
+		}
+
+		template<typename TElem>
+		double deviation_simd(const TElem* data, int size, double mean, const void*)
+		{
+			return deviation_scalar(data, size, mean);
+		}
+
+		template<typename TElem>
+		double deviation_span(const TElem* data, int size, double mean)
+		{
+			return deviation_simd(data, size, mean, (const typename _ReduceKernels<double, TElem>::Sse2*)nullptr);
+		}
+
+		template<typename TAcc>
+		class _PairwiseSum
+		{
+		private:
+			std::vector<TAcc> _partials;
+			std::vector<int> _levels;
+
+		public:
+			void add(TAcc value)
+			{
+				int level = 0;
+				while (!_levels.empty() && _levels.back() == level)
+				{
+					value = _partials.back() + value;
+					_partials.pop_back();
+					_levels.pop_back();
+					++level;
+				}
+				_partials.push_back(value);
+				_levels.push_back(level);
+			}
+
+			TAcc result() const
+			{
+				TAcc result = 0;
+				for (std::size_t i = _partials.size(); i-- > 0;)
+					result = _partials[i] + result;
+				return result;
+			}
+		};
+
+		template<typename TAcc>
+		class _FloatSum
+		{
+		private:
+			enum { PAIRWISE_BLOCK = 128 };
+
+			SumMode _mode;
+			TAcc _sum;
+			_PairwiseSum<TAcc> _pairwise;
+			_NeumaierSum<TAcc> _compensated;
+
+		public:
+			_FloatSum(SumMode mode) : _mode(mode), _sum(0) {}
+
+			template<typename TElem>
+			void add(const TElem* data, int size)
+			{
+				if (_mode == SumMode::KAHAN)
+					compensated_simd(data, size, _compensated, (const typename _ReduceKernels<TAcc, TElem>::Sse2*)nullptr);
+				else if (_mode == SumMode::PAIRWISE)
+					for (int i = 0; i < size; i += PAIRWISE_BLOCK)
+						_pairwise.add(reduce_span<TAcc, REDUCE_SUM>(data + i, std::min((int)PAIRWISE_BLOCK, size - i)));
+				else
+					_sum += reduce_span<TAcc, REDUCE_SUM>(data, size);
+			}
+
+			template<typename TElem>
+			void add(const std::vector<TElem>& batch)
+			{
+				add(batch.data(), (int)batch.size());
+			}
+
+			void add(const std::vector<bool>& batch)
+			{
+				std::vector<TAcc> converted(batch.begin(), batch.end());
+				add(converted.data(), (int)converted.size());
+			}
+
+			TAcc result() const
+			{
+				if (_mode == SumMode::KAHAN)
+					return _compensated.result();
+				else if (_mode == SumMode::PAIRWISE)
+					return _pairwise.result();
+				return _sum;
+			}
+		};
+
+		template<typename TAcc, typename TElem>
+		TAcc sum_span(const TElem* data, int size, SumMode, std::false_type)
+		{
+			return reduce_span<TAcc, REDUCE_SUM>(data, size);
+		}
+
+		template<typename TAcc, typename TElem>
+		TAcc sum_span(const TElem* data, int size, SumMode mode, std::true_type)
+		{
+			_FloatSum<TAcc> total(mode);
+			total.add(data, size);
+			return total.result();
+		}
+
+		template<typename TAcc, typename TElem>
+		TAcc sum_span(const TElem* data, int size, SumMode mode)
+		{
+			return sum_span<TAcc>(data, size, mode, std::is_floating_point<TAcc>());
+		}
+
+		template<typename TAcc, typename TElem>
+		TAcc sum_batches(_BatchReader<TElem>& reader, SumMode, long long& count, std::false_type)
+		{
+			TAcc result = reduce_batch<TAcc, REDUCE_SUM>(reader.batch());
+			count = reader.batch().size();
+			while (reader.read())
+			{
+				result += reduce_batch<TAcc, REDUCE_SUM>(reader.batch());
+				count += reader.batch().size();
+			}
+			return result;
+		}
+
+		template<typename TAcc, typename TElem>
+		TAcc sum_batches(_BatchReader<TElem>& reader, SumMode mode, long long& count, std::true_type)
+		{
+			_FloatSum<TAcc> total(mode);
+			count = 0;
+			do
+			{
+				total.add(reader.batch());
+				count += reader.batch().size();
+			} while (reader.read());
+			return total.result();
+		}
+
+		template<typename TAcc, typename TElem>
+		TAcc sum_batches(_BatchReader<TElem>& reader, SumMode mode, long long& count)
+		{
+			return sum_batches<TAcc>(reader, mode, count, std::is_floating_point<TAcc>());
+		}
+	}
+	/*@endcond*/
+}
+
+#endif
\ No newline at end of file
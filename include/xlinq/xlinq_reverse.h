@@ -66,6 +66,11 @@ namespace xlinq
 				return _source->current();
 			}
 
+			const TElem* current_ptr() override
+			{
+				return _source->current_ptr();
+			}
+
 			bool equals(std::shared_ptr<IEnumerator<TElem>> other) const override
 			{
 				auto pother = std::dynamic_pointer_cast<_ReverseBidirectionalEnumerator<TElem>>(other);
@@ -91,6 +96,11 @@ namespace xlinq
 			{
 			}
 
+			int known_size() override
+			{
+				return _source->known_size();
+			}
+
 			std::shared_ptr<IEnumerator<TElem>> createEnumerator() override
 			{
 				return std::shared_ptr<IEnumerator<TElem>>(new _ReverseBidirectionalEnumerator<TElem>(_source->getEndEnumerator()));
@@ -134,6 +144,11 @@ namespace xlinq
 				return _source->current();
 			}
 
+			const TElem* current_ptr() override
+			{
+				return _source->current_ptr();
+			}
+
 			bool equals(std::shared_ptr<IEnumerator<TElem>> other) const override
 			{
 				auto pother = std::dynamic_pointer_cast<_ReverseRandomAccessEnumerator<TElem>>(other);
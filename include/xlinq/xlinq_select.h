@@ -31,7 +31,9 @@ SOFTWARE.
 
 #include <memory>
 #include <cassert>
+#include <vector>
 #include "xlinq_base.h"
+#include "xlinq_static.h"
 
 namespace xlinq
 {
@@ -44,6 +46,7 @@ namespace xlinq
 		private:
 			TSelector _selector;
 			std::shared_ptr<IEnumerator<TElem>> _source;
+			std::vector<TElem> _batch;
 
 		public:
 			_SelectEnumerator(TSelector selector, std::shared_ptr<IEnumerator<TElem>> source)
@@ -59,6 +62,15 @@ namespace xlinq
 				return _selector(_source->current());
 			}
 
+			int next_batch(std::vector<TSelect>& buffer, int count) override
+			{
+				_batch.clear();
+				auto fetched = _source->next_batch(_batch, count);
+				for (auto& elem : _batch)
+					buffer.push_back(_selector(std::move(elem)));
+				return fetched;
+			}
+
 			bool equals(std::shared_ptr<IEnumerator<TSelect>> other) const override
 			{
 				auto pother = std::dynamic_pointer_cast<_SelectEnumerator<TSelector, TElem, TSelect>>(other);
@@ -79,6 +91,7 @@ namespace xlinq
 		private:
 			TSelector _selector;
 			std::shared_ptr<IBidirectionalEnumerator<TElem>> _source;
+			std::vector<TElem> _batch;
 
 		public:
 			_SelectBidirectionalEnumerator(TSelector selector, std::shared_ptr<IBidirectionalEnumerator<TElem>> source)
@@ -99,6 +112,15 @@ namespace xlinq
 				return _selector(_source->current());
 			}
 
+			int next_batch(std::vector<TSelect>& buffer, int count) override
+			{
+				_batch.clear();
+				auto fetched = _source->next_batch(_batch, count);
+				for (auto& elem : _batch)
+					buffer.push_back(_selector(std::move(elem)));
+				return fetched;
+			}
+
 			bool equals(std::shared_ptr<IEnumerator<TSelect>> other) const override
 			{
 				auto pother = std::dynamic_pointer_cast<_SelectBidirectionalEnumerator<TSelector, TElem, TSelect>>(other);
@@ -121,6 +143,7 @@ namespace xlinq
 		private:
 			TSelector _selector;
 			std::shared_ptr<IRandomAccessEnumerator<TElem>> _source;
+			std::vector<TElem> _batch;
 
 		public:
 			_SelectRandomAccessEnumerator(TSelector selector, std::shared_ptr<IRandomAccessEnumerator<TElem>> source)
@@ -146,6 +169,15 @@ namespace xlinq
 				return _selector(_source->current());
 			}
 
+			int next_batch(std::vector<TSelect>& buffer, int count) override
+			{
+				_batch.clear();
+				auto fetched = _source->next_batch(_batch, count);
+				for (auto& elem : _batch)
+					buffer.push_back(_selector(std::move(elem)));
+				return fetched;
+			}
+
 			bool equals(std::shared_ptr<IEnumerator<TSelect>> other) const override
 			{
 				auto pother = std::dynamic_pointer_cast<_SelectRandomAccessEnumerator<TSelector, TElem, TSelect>>(other);
@@ -194,6 +226,11 @@ namespace xlinq
 			_SelectEnumerable(TSelector selector, std::shared_ptr<IEnumerable<TElem>> source)
 				: _selector(selector), _source(source) {}
 
+			int known_size() override
+			{
+				return _source->known_size();
+			}
+
 			std::shared_ptr<IEnumerator<TSelect>> createEnumerator() override
 			{
 				return std::shared_ptr<IEnumerator<TSelect>>(new _SelectEnumerator<TSelector, TElem, TSelect>(_selector, _source->getEnumerator()));
@@ -211,6 +248,11 @@ namespace xlinq
 			_SelectBidirectionalEnumerable(TSelector selector, std::shared_ptr<IBidirectionalEnumerable<TElem>> source)
 				: _selector(selector), _source(source) {}
 
+			int known_size() override
+			{
+				return _source->known_size();
+			}
+
 			std::shared_ptr<IEnumerator<TSelect>> createEnumerator() override
 			{
 				return std::shared_ptr<IEnumerator<TSelect>>(new _SelectBidirectionalEnumerator<TSelector, TElem, TSelect>(_selector, _source->getEnumerator()));
@@ -254,6 +296,48 @@ namespace xlinq
 			}
 		};
 
+		template<typename TSelector, typename TSourceEnumerator, typename TSelect>
+		class _StaticSelectEnumerator
+		{
+		private:
+			TSelector _selector;
+			TSourceEnumerator _source;
+
+		public:
+			_StaticSelectEnumerator(TSelector selector, TSourceEnumerator source)
+				: _selector(selector), _source(source) {}
+
+			bool next()
+			{
+				return _source.next();
+			}
+
+			TSelect current()
+			{
+				return _selector(_source.current());
+			}
+		};
+
+		template<typename TSelector, typename TSource>
+		class _StaticSelectEnumerable : public StaticEnumerable<_StaticSelectEnumerable<TSelector, TSource>>
+		{
+		private:
+			TSelector _selector;
+			TSource _source;
+
+		public:
+			typedef typename unaryreturntype<TSelector, typename TSource::ElemType>::type ElemType;
+			typedef _StaticSelectEnumerator<TSelector, typename TSource::Enumerator, ElemType> Enumerator;
+
+			_StaticSelectEnumerable(TSelector selector, const TSource& source)
+				: _selector(selector), _source(source) {}
+
+			Enumerator getEnumerator() const
+			{
+				return Enumerator(_selector, _source.getEnumerator());
+			}
+		};
+
 		template<typename TSelector>
 		class _SelectBuilder
 		{
@@ -283,6 +367,18 @@ namespace xlinq
 				typedef typename unaryreturntype<TSelector, TElem>::type TSelect;
 				return std::shared_ptr<IRandomAccessEnumerable<TSelect>>(new _SelectRandomAccessEnumerable<TSelector, TElem, TSelect>(_selector, enumerable));
 			}
+
+			template<typename TSource>
+			_StaticSelectEnumerable<TSelector, TSource> build(const StaticEnumerable<TSource>& enumerable)
+			{
+				return _StaticSelectEnumerable<TSelector, TSource>(_selector, enumerable.derived());
+			}
+
+			template<typename TQuery>
+			auto build(const ParallelEnumerable<TQuery>& enumerable) -> decltype(enumerable.derived().select(_selector))
+			{
+				return enumerable.derived().select(_selector);
+			}
 		};
 	}
 	/*@endcond*/
@@ -30,8 +30,10 @@ SOFTWARE.
 #define XLINQ_SELECT_MANY_H_
 
 #include <memory>
+#include <iterator>
 #include "xlinq_base.h"
 #include "xlinq_from.h"
+#include "xlinq_static.h"
 
 namespace xlinq
 {
@@ -122,6 +124,81 @@ namespace xlinq
 			typedef _SelectManyEnumerable<TSelector, TElem, TSelectCollection, TSelect> TEnumerable;
 		};
 
+		template<typename TSelector, typename TSourceEnumerator, typename TSelectCollection>
+		class _StaticSelectManyEnumerator
+		{
+		public:
+			typedef decltype(std::begin(std::declval<const TSelectCollection&>())) TIterator;
+			typedef typename std::decay<decltype(*std::declval<TIterator>())>::type TSelect;
+
+		private:
+			TSelector _selector;
+			TSourceEnumerator _source;
+			TSelectCollection _collection;
+			TIterator _current;
+			bool _started;
+
+		public:
+			_StaticSelectManyEnumerator(TSelector selector, TSourceEnumerator source)
+				: _selector(selector), _source(source), _collection(), _current(), _started(false) {}
+
+			_StaticSelectManyEnumerator(const _StaticSelectManyEnumerator& other)
+				: _selector(other._selector), _source(other._source), _collection(other._collection), _current(), _started(other._started)
+			{
+				// iterator of copied collection has to point into this instance
+				if (_started)
+					_current = std::next(std::begin(_collection), std::distance(std::begin(other._collection), other._current));
+			}
+
+			_StaticSelectManyEnumerator& operator=(const _StaticSelectManyEnumerator&) = delete;
+
+			bool next()
+			{
+				if (_started)
+					++_current;
+				else
+				{
+					_started = true;
+					_current = std::end(_collection);
+				}
+				while (_current == std::end(_collection))
+				{
+					if (!_source.next())
+						return false;
+					_collection = _selector(_source.current());
+					_current = std::begin(_collection);
+				}
+				return true;
+			}
+
+			TSelect current()
+			{
+				return *_current;
+			}
+		};
+
+		template<typename TSelector, typename TSource>
+		class _StaticSelectManyEnumerable : public StaticEnumerable<_StaticSelectManyEnumerable<TSelector, TSource>>
+		{
+		private:
+			typedef typename std::decay<typename unaryreturntype<TSelector, typename TSource::ElemType>::type>::type TSelectCollection;
+
+			TSelector _selector;
+			TSource _source;
+
+		public:
+			typedef _StaticSelectManyEnumerator<TSelector, typename TSource::Enumerator, TSelectCollection> Enumerator;
+			typedef typename Enumerator::TSelect ElemType;
+
+			_StaticSelectManyEnumerable(TSelector selector, const TSource& source)
+				: _selector(selector), _source(source) {}
+
+			Enumerator getEnumerator() const
+			{
+				return Enumerator(_selector, _source.getEnumerator());
+			}
+		};
+
 		template<typename TSelector>
 		class _SelectManyBuilder
 		{
@@ -148,6 +225,12 @@ namespace xlinq
 			{
 				return std::shared_ptr<IEnumerable<typename selectmanytypeinfo<TSelector, TElem>::TSelect>>(new typename selectmanytypeinfo<TSelector, TElem>::TEnumerable(_selector, enumerable));
 			}
+
+			template<typename TSource>
+			_StaticSelectManyEnumerable<TSelector, TSource> build(const StaticEnumerable<TSource>& enumerable)
+			{
+				return _StaticSelectManyEnumerable<TSelector, TSource>(_selector, enumerable.derived());
+			}
 		};
 	}
 	/*@endcond*/
@@ -0,0 +1,259 @@
+/*
+MIT License
+
+Copyright (c) 2017 TrolleY
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+*	@file xlinq_semi_join.h
+*	Selecting elements of collection by presence of their keys in other collection.
+*	@author TrolleY
+*/
+#ifndef XLINQ_SEMI_JOIN_H_
+#define XLINQ_SEMI_JOIN_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <vector>
+#include "xlinq_base.h"
+#include "xlinq_defs.h"
+#include "xlinq_from.h"
+#include "xlinq_hash_set.h"
+#include "xlinq_where.h"
+
+namespace xlinq
+{
+	/*@cond XLINQ_INTERNAL*/
+	namespace internal
+	{
+		template<typename TKey, typename THasher, typename TEqComp>
+		class _SemiJoinKeySet
+		{
+		private:
+			THasher _hasher;
+			FlatHashSet<TKey, THasher, TEqComp> _keys;
+			std::vector<std::uint64_t> _bloom;
+			int _bloomBits;
+
+			static std::uint64_t bloom_mask(std::uint64_t mixed)
+			{
+				return (1ull << (mixed & 63)) | (1ull << ((mixed >> 6) & 63)) | (1ull << ((mixed >> 12) & 63));
+			}
+
+			void build_bloom(const std::vector<std::uint64_t>& hashes)
+			{
+				_bloomBits = 1;
+				while ((std::size_t(4) << _bloomBits) < hashes.size())
+					++_bloomBits;
+				_bloom.assign(std::size_t(1) << _bloomBits, 0);
+				for (std::uint64_t mixed : hashes)
+					_bloom[mixed >> (64 - _bloomBits)] |= bloom_mask(mixed);
+			}
+
+		public:
+			template<typename TOther, typename TOtherKeySelector>
+			_SemiJoinKeySet(TOther& other, TOtherKeySelector otherKeySelector, THasher hasher, TEqComp eqComp)
+				: _hasher(hasher), _keys(hasher, eqComp), _bloomBits(0)
+			{
+				auto enumerator = from(other)->getEnumerator();
+				std::vector<typename decltype(enumerator)::element_type::ElemType> batch;
+				std::vector<std::uint64_t> hashes;
+				int fetched;
+				do
+				{
+					batch.clear();
+					fetched = enumerator->next_batch(batch, XLINQ_BATCH_SIZE);
+					for (auto& elem : batch)
+					{
+						TKey key = otherKeySelector(elem);
+						if (_keys.insert(key))
+							hashes.push_back(mix_hash((std::size_t)_hasher(key)));
+					}
+				} while (fetched == XLINQ_BATCH_SIZE);
+				if (hashes.size() >= (std::size_t)XLINQ_SEMI_JOIN_BLOOM_MIN_SIZE)
+					build_bloom(hashes);
+			}
+
+			template<typename TProbe>
+			bool contains(const TProbe& key) const
+			{
+				std::uint64_t mixed = mix_hash((std::size_t)_hasher(key));
+				if (!_bloom.empty())
+				{
+					std::uint64_t mask = bloom_mask(mixed);
+					if ((_bloom[mixed >> (64 - _bloomBits)] & mask) != mask)
+						return false;
+				}
+				return _keys.contains(key, mixed);
+			}
+		};
+
+		template<typename TKeySelector, typename TKeySet, bool ANTI>
+		class _SemiJoinPredicate
+		{
+		private:
+			TKeySelector _keySelector;
+			std::shared_ptr<const TKeySet> _keys;
+		public:
+			_SemiJoinPredicate(TKeySelector keySelector, std::shared_ptr<const TKeySet> keys)
+				: _keySelector(keySelector), _keys(keys) {}
+
+			template<typename TElem>
+			bool operator()(const TElem& elem) const
+			{
+				return _keys->contains(_keySelector(elem)) != ANTI;
+			}
+		};
+
+		template<typename TOther, typename TOtherKeySelector>
+		struct _SemiJoinKeyType
+		{
+			typedef typename decltype(from(std::declval<typename std::add_lvalue_reference<TOther>::type>()))::element_type::ElemType TOtherElem;
+			typedef typename std::decay<typename unaryreturntype<TOtherKeySelector, TOtherElem>::type>::type type;
+		};
+
+		template<typename TOther, typename TKeySelector, typename TOtherKeySelector, typename THasher, typename TEqComp, bool ANTI>
+		class _SemiJoinBuilder
+		{
+		private:
+			typedef _SemiJoinKeySet<typename _SemiJoinKeyType<TOther, TOtherKeySelector>::type, THasher, TEqComp> TKeySet;
+			typedef _SemiJoinPredicate<TKeySelector, TKeySet, ANTI> TPredicate;
+			TOther _other;
+			TKeySelector _keySelector;
+			TOtherKeySelector _otherKeySelector;
+			THasher _hasher;
+			TEqComp _eqComp;
+
+			_WhereBuilder<TPredicate> where_builder()
+			{
+				return _WhereBuilder<TPredicate>(TPredicate(_keySelector, std::make_shared<const TKeySet>(_other, _otherKeySelector, _hasher, _eqComp)));
+			}
+
+		public:
+			_SemiJoinBuilder(TOther other, TKeySelector keySelector, TOtherKeySelector otherKeySelector, THasher hasher, TEqComp eqComp)
+				: _other(other), _keySelector(keySelector), _otherKeySelector(otherKeySelector), _hasher(hasher), _eqComp(eqComp)
+			{}
+
+			template<typename TElem>
+			std::shared_ptr<IEnumerable<TElem>> build(std::shared_ptr<IEnumerable<TElem>> enumerable)
+			{
+				return where_builder().build(enumerable);
+			}
+
+			template<typename TElem>
+			std::shared_ptr<IBidirectionalEnumerable<TElem>> build(std::shared_ptr<IBidirectionalEnumerable<TElem>> enumerable)
+			{
+				return where_builder().build(enumerable);
+			}
+
+			template<typename TElem>
+			std::shared_ptr<IBidirectionalEnumerable<TElem>> build(std::shared_ptr<IRandomAccessEnumerable<TElem>> enumerable)
+			{
+				return where_builder().build(enumerable);
+			}
+
+			template<typename TQuery>
+			auto build(const ParallelEnumerable<TQuery>& enumerable) -> decltype(enumerable.derived().where(std::declval<TPredicate>()))
+			{
+				return where_builder().build(enumerable);
+			}
+		};
+	}
+	/*@endcond*/
+
+	/**
+	*	Filters elements leaving those whose keys are present in other collection.
+	*	Keys of other collection are gathered into hash set when expression is
+	*	built, and then elements of source collection are streamed without being
+	*	stored. Each element is returned at most once, no matter how many elements of
+	*	other collection share its key, and order of elements is preserved. When
+	*	other collection has at least XLINQ_SEMI_JOIN_BLOOM_MIN_SIZE distinct keys,
+	*	Bloom filter is put in front of hash set, so most of elements without matching
+	*	key are rejected with single memory read. Keys are hashed and compared as
+	*	keys of other collection.
+	*	@param other Collection which keys are looked for.
+	*	@param keySelector Function selecting key from source collection.
+	*	@param otherKeySelector Function selecting key from other collection.
+	*	@return Builder of semi_join expression.
+	*/
+	template<typename TOther, typename TKeySelector, typename TOtherKeySelector>
+	XLINQ_INLINE internal::_SemiJoinBuilder<TOther, TKeySelector, TOtherKeySelector, std::hash<typename internal::_SemiJoinKeyType<TOther, TOtherKeySelector>::type>, std::equal_to<typename internal::_SemiJoinKeyType<TOther, TOtherKeySelector>::type>, false> semi_join(TOther other, TKeySelector keySelector, TOtherKeySelector otherKeySelector)
+	{
+		typedef typename internal::_SemiJoinKeyType<TOther, TOtherKeySelector>::type TKey;
+		return internal::_SemiJoinBuilder<TOther, TKeySelector, TOtherKeySelector, std::hash<TKey>, std::equal_to<TKey>, false>(other, keySelector, otherKeySelector, std::hash<TKey>(), std::equal_to<TKey>());
+	}
+
+	/**
+	*	Filters elements leaving those whose keys are present in other collection.
+	*	This function works as semi_join, but uses specified hasher and comparer of keys.
+	*	@param other Collection which keys are looked for.
+	*	@param keySelector Function selecting key from source collection.
+	*	@param otherKeySelector Function selecting key from other collection.
+	*	@param hasher Functor hashing keys, it has to accept keys of both collections
+	*	and return equal hashes for equal keys.
+	*	@param keyEqComp Functor comparing keys, it has to accept keys of both
+	*	collections in any order.
+	*	@return Builder of semi_join expression.
+	*/
+	template<typename TOther, typename TKeySelector, typename TOtherKeySelector, typename THasher, typename TKeyEqComp>
+	XLINQ_INLINE internal::_SemiJoinBuilder<TOther, TKeySelector, TOtherKeySelector, THasher, TKeyEqComp, false> semi_join(TOther other, TKeySelector keySelector, TOtherKeySelector otherKeySelector, THasher hasher, TKeyEqComp keyEqComp)
+	{
+		return internal::_SemiJoinBuilder<TOther, TKeySelector, TOtherKeySelector, THasher, TKeyEqComp, false>(other, keySelector, otherKeySelector, hasher, keyEqComp);
+	}
+
+	/**
+	*	Filters elements leaving those whose keys are not present in other collection.
+	*	This function works as semi_join, but returns elements without matching key.
+	*	@param other Collection which keys are looked for.
+	*	@param keySelector Function selecting key from source collection.
+	*	@param otherKeySelector Function selecting key from other collection.
+	*	@return Builder of anti_join expression.
+	*/
+	template<typename TOther, typename TKeySelector, typename TOtherKeySelector>
+	XLINQ_INLINE internal::_SemiJoinBuilder<TOther, TKeySelector, TOtherKeySelector, std::hash<typename internal::_SemiJoinKeyType<TOther, TOtherKeySelector>::type>, std::equal_to<typename internal::_SemiJoinKeyType<TOther, TOtherKeySelector>::type>, true> anti_join(TOther other, TKeySelector keySelector, TOtherKeySelector otherKeySelector)
+	{
+		typedef typename internal::_SemiJoinKeyType<TOther, TOtherKeySelector>::type TKey;
+		return internal::_SemiJoinBuilder<TOther, TKeySelector, TOtherKeySelector, std::hash<TKey>, std::equal_to<TKey>, true>(other, keySelector, otherKeySelector, std::hash<TKey>(), std::equal_to<TKey>());
+	}
+
+	/**
+	*	Filters elements leaving those whose keys are not present in other collection.
+	*	This function works as anti_join, but uses specified hasher and comparer of keys.
+	*	@param other Collection which keys are looked for.
+	*	@param keySelector Function selecting key from source collection.
+	*	@param otherKeySelector Function selecting key from other collection.
+	*	@param hasher Functor hashing keys, it has to accept keys of both collections
+	*	and return equal hashes for equal keys.
+	*	@param keyEqComp Functor comparing keys, it has to accept keys of both
+	*	collections in any order.
+	*	@return Builder of anti_join expression.
+	*/
+	template<typename TOther, typename TKeySelector, typename TOtherKeySelector, typename THasher, typename TKeyEqComp>
+	XLINQ_INLINE internal::_SemiJoinBuilder<TOther, TKeySelector, TOtherKeySelector, THasher, TKeyEqComp, true> anti_join(TOther other, TKeySelector keySelector, TOtherKeySelector otherKeySelector, THasher hasher, TKeyEqComp keyEqComp)
+	{
+		return internal::_SemiJoinBuilder<TOther, TKeySelector, TOtherKeySelector, THasher, TKeyEqComp, true>(other, keySelector, otherKeySelector, hasher, keyEqComp);
+	}
+}
+
+#endif
\ No newline at end of file
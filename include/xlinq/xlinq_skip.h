@@ -29,9 +29,11 @@ SOFTWARE.
 #ifndef XLINQ_SKIP_H_
 #define XLINQ_SKIP_H_
 
+#include <algorithm>
 #include <memory>
 #include <cassert>
 #include "xlinq_base.h"
+#include "xlinq_static.h"
 
 namespace xlinq
 {
@@ -59,7 +61,7 @@ namespace xlinq
 						_source = nullptr;
 						return false;
 					}
-				} while (!_omitPredicate && _predicate(_source->current()));
+				} while (!_omitPredicate && current_matches(_source, _predicate));
 				_omitPredicate = true;
 				return true;
 			}
@@ -70,6 +72,12 @@ namespace xlinq
 				return _source->current();
 			}
 
+			const TElem* current_ptr() override
+			{
+				if (!_source) throw IterationFinishedException();
+				return _source->current_ptr();
+			}
+
 			bool equals(std::shared_ptr<IEnumerator<TElem>> other) const override
 			{
 				auto pother = std::dynamic_pointer_cast<_SkipWhileEnumerator<TElem, TPredicate>>(other);
@@ -162,6 +170,11 @@ namespace xlinq
 				return _source->current();
 			}
 
+			const TElem* current_ptr() override
+			{
+				return _source->current_ptr();
+			}
+
 			bool equals(std::shared_ptr<IEnumerator<TElem>> other) const override
 			{
 				auto pother = std::dynamic_pointer_cast<_SkipEnumerator<TElem>>(other);
@@ -188,6 +201,14 @@ namespace xlinq
 				: _source(source), _items(items)
 			{}
 
+			int known_size() override
+			{
+				int size = _source->known_size();
+				if (size < 0)
+					return -1;
+				return std::max(0, size - std::max(0, _items));
+			}
+
 			std::shared_ptr<IEnumerator<TElem>> createEnumerator() override
 			{
 				return std::shared_ptr<IEnumerator<TElem>>(new _SkipEnumerator<TElem>(_source->getEnumerator(), _items));
@@ -251,6 +272,13 @@ namespace xlinq
 				return _source->current();
 			}
 
+			const TElem* current_ptr() override
+			{
+				if (_index < _items) throw IterationNotStartedException();
+				if (_index == _size) throw IterationFinishedException();
+				return _source->current_ptr();
+			}
+
 			bool equals(std::shared_ptr<IEnumerator<TElem>> other) const override
 			{
 				auto pother = std::dynamic_pointer_cast<_SkipRandomAccessEnumerator<TElem>>(other);
@@ -324,7 +352,60 @@ namespace xlinq
 
 			int size() override
 			{
-				return _source->size() - _items;
+				auto size = _source->size() - _items;
+				return size > 0 ? size : 0;
+			}
+
+			const TElem* data() override
+			{
+				auto data = _source->data();
+				return data && _items >= 0 && size() ? data + _items : nullptr;
+			}
+		};
+
+		template<typename TSourceEnumerator, typename TElem>
+		class _StaticSkipEnumerator
+		{
+		private:
+			TSourceEnumerator _source;
+			int _items;
+		public:
+			_StaticSkipEnumerator(TSourceEnumerator source, int items) : _source(source), _items(items) {}
+
+			bool next()
+			{
+				for (; _items > 0; --_items)
+				{
+					if (!_source.next())
+					{
+						_items = 0;
+						return false;
+					}
+				}
+				return _source.next();
+			}
+
+			TElem current()
+			{
+				return _source.current();
+			}
+		};
+
+		template<typename TSource>
+		class _StaticSkipEnumerable : public StaticEnumerable<_StaticSkipEnumerable<TSource>>
+		{
+		private:
+			TSource _source;
+			int _items;
+		public:
+			typedef typename TSource::ElemType ElemType;
+			typedef _StaticSkipEnumerator<typename TSource::Enumerator, ElemType> Enumerator;
+
+			_StaticSkipEnumerable(const TSource& source, int items) : _source(source), _items(items) {}
+
+			Enumerator getEnumerator() const
+			{
+				return Enumerator(_source.getEnumerator(), _items);
 			}
 		};
 
@@ -352,6 +433,12 @@ namespace xlinq
 			{
 				return std::shared_ptr<IRandomAccessEnumerable<TElem>>(new internal::_SkipRandomAccessEnumerable<TElem>(enumerable, _items));
 			}
+
+			template<typename TSource>
+			_StaticSkipEnumerable<TSource> build(const StaticEnumerable<TSource>& enumerable)
+			{
+				return _StaticSkipEnumerable<TSource>(enumerable.derived(), _items);
+			}
 		};
 	}
 	/*@endcond*/
@@ -33,8 +33,15 @@ SOFTWARE.
 #include <algorithm>
 #include <vector>
 #include <functional>
+#include <iterator>
+#include <cstddef>
+#include <utility>
+#include <mutex>
 #include "xlinq_base.h"
 #include "xlinq_from.h"
+#include "xlinq_parallel.h"
+#include "xlinq_radix_sort.h"
+#include "xlinq_take.h"
 
 namespace xlinq
 {
@@ -42,21 +49,519 @@ namespace xlinq
 	namespace internal
 	{
 
-		template<typename TEnumerable, typename TComparer>
-		std::shared_ptr<IRandomAccessEnumerable<typename TEnumerable::element_type::ElemType>> build_sort(TEnumerable enumerable, TComparer comparer, int size = -1)
+		template<typename TKeySelector, typename TKey>
+		class _KeyComparer
 		{
-			typedef typename TEnumerable::element_type::ElemType TElem;
-			auto vec = std::shared_ptr<std::vector<TElem>>(new std::vector<TElem>());
-			if (size >= 0)
-				vec->reserve(size);
-			for (auto it = enumerable->getEnumerator(); it->next();)
+		public:
+			typedef TKey KeyType;
+			static const bool ascending = true;
+
+			TKeySelector selector;
+
+			_KeyComparer(TKeySelector selector) : selector(selector) {}
+
+			template<typename TElem>
+			KeyType key(const TElem& elem)
+			{
+				return selector(elem);
+			}
+
+			bool less(const KeyType& first, const KeyType& second) const
+			{
+				return std::less<TKey>()(first, second);
+			}
+
+			template<typename TElem>
+			bool operator()(const TElem& first, const TElem& second)
+			{
+				return less(selector(first), selector(second));
+			}
+		};
+
+		template<typename TPrevious, typename TKeySelector, typename TKey, bool DESCENDING>
+		class _ThenByComparer
+		{
+		public:
+			typedef std::pair<typename TPrevious::KeyType, TKey> KeyType;
+			static const bool ascending = TPrevious::ascending && !DESCENDING;
+
+			TPrevious previous;
+			TKeySelector selector;
+
+			_ThenByComparer(TPrevious previous, TKeySelector selector) : previous(previous), selector(selector) {}
+
+			template<typename TElem>
+			KeyType key(const TElem& elem)
+			{
+				return KeyType(previous.key(elem), selector(elem));
+			}
+
+			bool less(const KeyType& first, const KeyType& second) const
+			{
+				if (previous.less(first.first, second.first)) return true;
+				if (previous.less(second.first, first.first)) return false;
+				return DESCENDING ? std::less<TKey>()(second.second, first.second) : std::less<TKey>()(first.second, second.second);
+			}
+
+			template<typename TElem>
+			bool operator()(const TElem& first, const TElem& second)
+			{
+				return less(key(first), key(second));
+			}
+		};
+
+		template<typename TElem, typename TComparer>
+		void sort_elements(std::vector<TElem>& elements, TComparer comparer)
+		{
+			std::stable_sort(elements.begin(), elements.end(), comparer);
+		}
+
+		template<typename TElem>
+		void sort_elements(std::vector<TElem>& elements, std::less<TElem> comparer, std::true_type)
+		{
+			if (elements.size() < XLINQ_RADIX_SORT_MIN_SIZE)
+				std::stable_sort(elements.begin(), elements.end(), comparer);
+			else radix_sort<TElem>(elements, _RadixIdentity());
+		}
+
+		template<typename TElem>
+		void sort_elements(std::vector<TElem>& elements, std::less<TElem> comparer, std::false_type)
+		{
+			std::stable_sort(elements.begin(), elements.end(), comparer);
+		}
+
+		template<typename TElem>
+		void sort_elements(std::vector<TElem>& elements, std::less<TElem> comparer)
+		{
+			sort_elements(elements, comparer, std::integral_constant<bool, _RadixTraits<TElem>::value>());
+		}
+
+		template<typename TKey, typename TComparer>
+		void sort_keys(std::vector<std::pair<TKey, int>>& keys, TComparer& comparer, std::false_type)
+		{
+			std::stable_sort(keys.begin(), keys.end(), [&comparer](const std::pair<TKey, int>& first, const std::pair<TKey, int>& second)
+			{
+				return comparer.less(first.first, second.first);
+			});
+		}
+
+		template<typename TKey, typename TComparer>
+		void sort_keys(std::vector<std::pair<TKey, int>>& keys, TComparer& comparer, std::true_type)
+		{
+			if (keys.size() < XLINQ_RADIX_SORT_MIN_SIZE)
+				sort_keys(keys, comparer, std::false_type());
+			else radix_sort<TKey>(keys, _RadixFirst());
+		}
+
+		template<typename TElem, typename TComparer>
+		void sort_elements_by_keys(std::vector<TElem>& elements, TComparer& comparer)
+		{
+			typedef typename TComparer::KeyType TKey;
+			std::vector<std::pair<TKey, int>> keys;
+			keys.reserve(elements.size());
+			for (int i = 0; i < (int)elements.size(); ++i)
+				keys.push_back(std::pair<TKey, int>(comparer.key(elements[i]), i));
+			sort_keys(keys, comparer, std::integral_constant<bool, TComparer::ascending && _RadixTraits<TKey>::value>());
+			std::vector<TElem> sorted;
+			sorted.reserve(elements.size());
+			for (auto& key : keys)
+				sorted.push_back(std::move(elements[key.second]));
+			elements.swap(sorted);
+		}
+
+		template<typename TElem, typename TKeySelector, typename TKey>
+		void sort_elements(std::vector<TElem>& elements, _KeyComparer<TKeySelector, TKey> comparer)
+		{
+			sort_elements_by_keys(elements, comparer);
+		}
+
+		template<typename TElem, typename TPrevious, typename TKeySelector, typename TKey, bool DESCENDING>
+		void sort_elements(std::vector<TElem>& elements, _ThenByComparer<TPrevious, TKeySelector, TKey, DESCENDING> comparer)
+		{
+			sort_elements_by_keys(elements, comparer);
+		}
+
+		template<typename TElem, typename TComparer>
+		void parallel_sort_elements(std::vector<TElem>& elements, TComparer comparer)
+		{
+			auto& pool = _WorkStealingPool::instance();
+			int threads = pool.size() + 1;
+			int runs = (int)std::min<std::size_t>(threads, elements.size() / XLINQ_PARALLEL_CHUNK_SIZE);
+			if (runs < 2)
+			{
+				sort_elements(elements, comparer);
+				return;
+			}
+
+			std::vector<std::size_t> bounds;
+			for (int run = 0; run <= runs; ++run)
+				bounds.push_back(elements.size() * run / runs);
+			pool.parallel_for(runs, [&](int run)
+			{
+				std::vector<TElem> chunk(std::make_move_iterator(elements.begin() + bounds[run]), std::make_move_iterator(elements.begin() + bounds[run + 1]));
+				sort_elements(chunk, comparer);
+				std::move(chunk.begin(), chunk.end(), elements.begin() + bounds[run]);
+			});
+
+			std::vector<TElem> buffer(elements);
+			auto source = &elements;
+			auto target = &buffer;
+			while (bounds.size() > 2)
+			{
+				int pairs = (int)(bounds.size() - 1) / 2;
+				bool odd = (bounds.size() - 1) % 2 != 0;
+				int pieces = std::max(1, threads / pairs);
+				std::vector<std::size_t> splits;
+				for (int pair = 0; pair < pairs; ++pair)
+				{
+					auto first = source->begin() + bounds[2 * pair];
+					auto middle = source->begin() + bounds[2 * pair + 1];
+					auto last = source->begin() + bounds[2 * pair + 2];
+					for (int piece = 0; piece <= pieces; ++piece)
+					{
+						auto firstSplit = first + (middle - first) * piece / pieces;
+						auto secondSplit = piece == 0 ? middle : piece == pieces ? last : std::lower_bound(middle, last, *firstSplit, comparer);
+						splits.push_back(firstSplit - source->begin());
+						splits.push_back(secondSplit - source->begin());
+					}
+				}
+				pool.parallel_for(pairs * pieces + (odd ? 1 : 0), [&](int task)
+				{
+					if (task == pairs * pieces)
+					{
+						std::move(source->begin() + bounds[2 * pairs], source->end(), target->begin() + bounds[2 * pairs]);
+						return;
+					}
+					int pair = task / pieces;
+					auto split = splits.begin() + 2 * (pair * (pieces + 1) + task % pieces);
+					auto output = target->begin() + bounds[2 * pair] + (split[0] - bounds[2 * pair]) + (split[1] - bounds[2 * pair + 1]);
+					std::merge(std::make_move_iterator(source->begin() + split[0]), std::make_move_iterator(source->begin() + split[2]),
+						std::make_move_iterator(source->begin() + split[1]), std::make_move_iterator(source->begin() + split[3]),
+						output, comparer);
+				});
+				std::vector<std::size_t> merged;
+				for (std::size_t i = 0; i < bounds.size(); i += 2)
+					merged.push_back(bounds[i]);
+				if (odd)
+					merged.push_back(bounds.back());
+				bounds.swap(merged);
+				std::swap(source, target);
+			}
+			if (source != &elements)
+				elements.swap(buffer);
+		}
+
+		template<typename TElem, typename TComparer>
+		class _LazySortState
+		{
+		private:
+			std::vector<TElem> _elements;
+			std::vector<int> _order;
+			std::vector<char> _sorted;
+			TComparer _comparer;
+
+			bool less(int first, int second)
+			{
+				if (_comparer(_elements[first], _elements[second])) return true;
+				if (_comparer(_elements[second], _elements[first])) return false;
+				return first < second;
+			}
+
+			void select(int index)
+			{
+				int lo = index, hi = index + 1;
+				while (lo > 0 && !_sorted[lo - 1])
+					--lo;
+				while (hi < (int)_order.size() && !_sorted[hi])
+					++hi;
+				while (hi - lo > 16)
+				{
+					int mid = lo + (hi - lo) / 2;
+					if (less(_order[mid], _order[lo])) std::swap(_order[mid], _order[lo]);
+					if (less(_order[hi - 1], _order[lo])) std::swap(_order[hi - 1], _order[lo]);
+					if (less(_order[mid], _order[hi - 1])) std::swap(_order[mid], _order[hi - 1]);
+					int pivot = _order[hi - 1];
+					auto split = std::partition(_order.begin() + lo, _order.begin() + hi - 1, [this, pivot](int elem) { return less(elem, pivot); });
+					std::iter_swap(split, _order.begin() + hi - 1);
+					int position = (int)(split - _order.begin());
+					_sorted[position] = 1;
+					if (position == index)
+						return;
+					if (index < position)
+						hi = position;
+					else lo = position + 1;
+				}
+				std::sort(_order.begin() + lo, _order.begin() + hi, [this](int first, int second) { return less(first, second); });
+				std::fill(_sorted.begin() + lo, _sorted.begin() + hi, 1);
+			}
+
+		public:
+			_LazySortState(std::shared_ptr<IEnumerable<TElem>> source, TComparer comparer) : _comparer(comparer)
+			{
+				auto it = source->getEnumerator();
+				while (it->next_batch(_elements, XLINQ_BATCH_SIZE) == XLINQ_BATCH_SIZE);
+				_order.reserve(_elements.size());
+				for (int i = 0; i < (int)_elements.size(); ++i)
+					_order.push_back(i);
+				_sorted.assign(_elements.size(), 0);
+			}
+
+			int size() const { return (int)_order.size(); }
+
+			const TElem& at(int index)
+			{
+				if (!_sorted[index])
+					select(index);
+				return _elements[_order[index]];
+			}
+		};
+
+		template<typename TElem, typename TComparer>
+		class _LazySortIterator
+		{
+		private:
+			std::shared_ptr<_LazySortState<TElem, TComparer>> _state;
+			int _index;
+
+		public:
+			typedef std::random_access_iterator_tag iterator_category;
+			typedef TElem value_type;
+			typedef std::ptrdiff_t difference_type;
+			typedef const TElem* pointer;
+			typedef const TElem& reference;
+
+			_LazySortIterator(std::shared_ptr<_LazySortState<TElem, TComparer>> state, int index) : _state(state), _index(index) {}
+
+			reference operator*() const { return _state->at(_index); }
+
+			pointer operator->() const { return &_state->at(_index); }
+
+			_LazySortIterator& operator++() { ++_index; return *this; }
+
+			_LazySortIterator& operator--() { --_index; return *this; }
+
+			_LazySortIterator& operator+=(difference_type step) { _index += (int)step; return *this; }
+
+			_LazySortIterator& operator-=(difference_type step) { _index -= (int)step; return *this; }
+
+			difference_type operator-(const _LazySortIterator& other) const { return _index - other._index; }
+
+			bool operator==(const _LazySortIterator& other) const { return _index == other._index && _state == other._state; }
+
+			bool operator!=(const _LazySortIterator& other) const { return !(*this == other); }
+
+			bool operator<(const _LazySortIterator& other) const { return _index < other._index; }
+
+			bool operator>(const _LazySortIterator& other) const { return _index > other._index; }
+		};
+
+		template<typename TElem, typename TComparer>
+		class _LazySortEnumerable : public IRandomAccessEnumerable<TElem>
+		{
+		private:
+			typedef _LazySortIterator<TElem, TComparer> iterator;
+			std::shared_ptr<IEnumerable<TElem>> _source;
+			TComparer _comparer;
+			std::shared_ptr<_LazySortState<TElem, TComparer>> _state;
+
+			std::shared_ptr<_LazySortState<TElem, TComparer>> state()
+			{
+				if (!_state)
+				{
+					_state = std::shared_ptr<_LazySortState<TElem, TComparer>>(new _LazySortState<TElem, TComparer>(_source, _comparer));
+					_source = nullptr;
+				}
+				return _state;
+			}
+
+		public:
+			_LazySortEnumerable(std::shared_ptr<IEnumerable<TElem>> source, TComparer comparer) : _source(source), _comparer(comparer) {}
+
+			std::shared_ptr<IEnumerator<TElem>> createEnumerator() override
+			{
+				auto sorted = state();
+				return std::shared_ptr<IEnumerator<TElem>>(new _StlRandomAccessEnumerator<iterator, TElem>(iterator(sorted, 0), iterator(sorted, sorted->size())));
+			}
+
+			std::shared_ptr<IBidirectionalEnumerator<TElem>> createEndEnumerator() override
+			{
+				auto sorted = state();
+				return std::shared_ptr<IBidirectionalEnumerator<TElem>>(new _StlRandomAccessEnumerator<iterator, TElem>(iterator(sorted, 0), iterator(sorted, sorted->size()), iterator(sorted, sorted->size())));
+			}
+
+			std::shared_ptr<IRandomAccessEnumerator<TElem>> createEnumeratorAt(int elementIndex) override
+			{
+				auto result = this->getEnumerator();
+				result->advance(elementIndex + 1);
+				return result;
+			}
+
+			int size() override
+			{
+				return state()->size();
+			}
+		};
+
+		template<typename TElem, typename TComparer>
+		class _TopKHeap
+		{
+		private:
+			typedef std::pair<TElem, long long> Entry;
+
+			struct EntryComparer
+			{
+				TComparer comparer;
+
+				EntryComparer(TComparer comparer) : comparer(comparer) {}
+
+				bool operator()(const Entry& first, const Entry& second)
+				{
+					if (comparer(first.first, second.first)) return true;
+					if (comparer(second.first, first.first)) return false;
+					return first.second < second.second;
+				}
+			};
+
+			std::vector<Entry> _heap;
+			EntryComparer _comparer;
+			int _count;
+			long long _index;
+
+		public:
+			_TopKHeap(int count, TComparer comparer) : _comparer(comparer), _count(count), _index(0)
+			{
+				_heap.reserve(count);
+			}
+
+			void push(const TElem& elem)
+			{
+				if ((int)_heap.size() < _count)
+				{
+					_heap.push_back(Entry(elem, _index++));
+					std::push_heap(_heap.begin(), _heap.end(), _comparer);
+				}
+				else
+				{
+					++_index;
+					if (_comparer.comparer(elem, _heap.front().first))
+					{
+						std::pop_heap(_heap.begin(), _heap.end(), _comparer);
+						_heap.back() = Entry(elem, _index - 1);
+						std::push_heap(_heap.begin(), _heap.end(), _comparer);
+					}
+				}
+			}
+
+			std::shared_ptr<std::vector<TElem>> sorted()
+			{
+				std::sort_heap(_heap.begin(), _heap.end(), _comparer);
+				auto vec = std::shared_ptr<std::vector<TElem>>(new std::vector<TElem>());
+				vec->reserve(_heap.size());
+				for (auto& entry : _heap)
+					vec->push_back(std::move(entry.first));
+				_heap.clear();
+				return vec;
+			}
+		};
+
+		template<typename TElem, typename TComparer>
+		std::shared_ptr<IRandomAccessEnumerable<TElem>> build_top_k(std::shared_ptr<IEnumerable<TElem>> enumerable, int count, TComparer comparer)
+		{
+			if (count <= 0)
+				return from(std::shared_ptr<std::vector<TElem>>(new std::vector<TElem>()));
+			_TopKHeap<TElem, TComparer> heap(count, comparer);
+			auto randomAccess = std::dynamic_pointer_cast<IRandomAccessEnumerable<TElem>>(enumerable);
+			auto data = randomAccess ? randomAccess->data() : nullptr;
+			if (data)
+			{
+				for (auto end = data + randomAccess->size(); data != end; ++data)
+					heap.push(*data);
+			}
+			else
 			{
-				vec->push_back(it->current());
+				_BatchReader<TElem> reader(enumerable->getEnumerator());
+				while (reader.read())
+					for (int i = 0; i < reader.size(); ++i)
+						heap.push(reader[i]);
 			}
-			std::stable_sort(vec->begin(), vec->end(), comparer);
-			return from(vec);
+			return from(heap.sorted());
 		}
 
+		template<typename TElem, typename TComparer>
+		class _SortEnumerable : public IRandomAccessEnumerable<TElem>, public _SortedFrontSource<TElem>
+		{
+		private:
+			std::shared_ptr<std::vector<TElem>> _elements;
+			TComparer _comparer;
+			std::shared_ptr<IRandomAccessEnumerable<TElem>> _sorted;
+			std::mutex _mutex;
+
+			std::shared_ptr<IRandomAccessEnumerable<TElem>> sorted()
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+				if (!_sorted)
+				{
+					sort_elements(*_elements, _comparer);
+					_sorted = from(_elements);
+				}
+				return _sorted;
+			}
+
+		public:
+			_SortEnumerable(std::shared_ptr<IEnumerable<TElem>> source, TComparer comparer)
+				: _elements(new std::vector<TElem>()), _comparer(comparer)
+			{
+				auto randomAccess = std::dynamic_pointer_cast<IRandomAccessEnumerable<TElem>>(source);
+				auto data = randomAccess ? randomAccess->data() : nullptr;
+				if (data)
+				{
+					_elements->assign(data, data + randomAccess->size());
+					return;
+				}
+				if (randomAccess)
+					_elements->reserve(randomAccess->size());
+				auto it = source->getEnumerator();
+				while (it->next_batch(*_elements, XLINQ_BATCH_SIZE) == XLINQ_BATCH_SIZE);
+			}
+
+			std::shared_ptr<IEnumerator<TElem>> createEnumerator() override
+			{
+				return sorted()->getEnumerator();
+			}
+
+			std::shared_ptr<IBidirectionalEnumerator<TElem>> createEndEnumerator() override
+			{
+				return sorted()->getEndEnumerator();
+			}
+
+			std::shared_ptr<IRandomAccessEnumerator<TElem>> createEnumeratorAt(int index) override
+			{
+				return sorted()->getEnumeratorAt(index);
+			}
+
+			int size() override
+			{
+				return (int)_elements->size();
+			}
+
+			const TElem* data() override
+			{
+				return sorted()->data();
+			}
+
+			std::shared_ptr<IRandomAccessEnumerable<TElem>> sorted_front(int count) override
+			{
+				if (count < 0)
+					count = 0;
+				{
+					std::lock_guard<std::mutex> lock(_mutex);
+					if (!_sorted && count < (int)_elements->size())
+						return build_top_k<TElem>(from(_elements), count, _comparer);
+				}
+				return std::shared_ptr<IRandomAccessEnumerable<TElem>>(new _TakeRandomAccessEnumerable<TElem>(sorted(), count));
+			}
+		};
+
 		template<typename TComparer>
 		class _SortBuilderWithComp
 		{
@@ -67,19 +572,27 @@ namespace xlinq
 			template<typename TElem>
 			std::shared_ptr<IRandomAccessEnumerable<TElem>> build(std::shared_ptr<IEnumerable<TElem>> enumerable)
 			{
-				return build_sort(enumerable, _comparer);
+				return std::shared_ptr<IRandomAccessEnumerable<TElem>>(new _SortEnumerable<TElem, TComparer>(enumerable, _comparer));
 			}
 
 			template<typename TElem>
 			std::shared_ptr<IRandomAccessEnumerable<TElem>> build(std::shared_ptr<IBidirectionalEnumerable<TElem>> enumerable)
 			{
-				return build_sort(enumerable, _comparer);
+				return build((std::shared_ptr<IEnumerable<TElem>>)enumerable);
 			}
 
 			template<typename TElem>
 			std::shared_ptr<IRandomAccessEnumerable<TElem>> build(std::shared_ptr<IRandomAccessEnumerable<TElem>> enumerable)
 			{
-				return build_sort(enumerable, _comparer, enumerable->size());
+				return build((std::shared_ptr<IEnumerable<TElem>>)enumerable);
+			}
+
+			template<typename TQuery>
+			std::shared_ptr<IRandomAccessEnumerable<typename TQuery::ElemType>> build(const ParallelEnumerable<TQuery>& enumerable)
+			{
+				auto vec = std::make_shared<std::vector<typename TQuery::ElemType>>(enumerable.derived().to_vector());
+				parallel_sort_elements(*vec, _comparer);
+				return from(vec);
 			}
 		};
 
@@ -89,19 +602,208 @@ namespace xlinq
 			template<typename TElem>
 			std::shared_ptr<IRandomAccessEnumerable<TElem>> build(std::shared_ptr<IEnumerable<TElem>> enumerable)
 			{
-				return build_sort(enumerable, std::less<TElem>());
+				return std::shared_ptr<IRandomAccessEnumerable<TElem>>(new _SortEnumerable<TElem, std::less<TElem>>(enumerable, std::less<TElem>()));
+			}
+
+			template<typename TElem>
+			std::shared_ptr<IRandomAccessEnumerable<TElem>> build(std::shared_ptr<IBidirectionalEnumerable<TElem>> enumerable)
+			{
+				return build((std::shared_ptr<IEnumerable<TElem>>)enumerable);
+			}
+
+			template<typename TElem>
+			std::shared_ptr<IRandomAccessEnumerable<TElem>> build(std::shared_ptr<IRandomAccessEnumerable<TElem>> enumerable)
+			{
+				return build((std::shared_ptr<IEnumerable<TElem>>)enumerable);
+			}
+
+			template<typename TQuery>
+			std::shared_ptr<IRandomAccessEnumerable<typename TQuery::ElemType>> build(const ParallelEnumerable<TQuery>& enumerable)
+			{
+				typedef typename TQuery::ElemType TElem;
+				auto vec = std::make_shared<std::vector<TElem>>(enumerable.derived().to_vector());
+				parallel_sort_elements(*vec, std::less<TElem>());
+				return from(vec);
+			}
+		};
+
+		template<typename TPrevious, typename TKeySelector, bool DESCENDING>
+		class _ThenByBuilder;
+
+		template<typename TDerived>
+		class _KeySortBuilder
+		{
+		public:
+			template<typename TKeySelector>
+			_ThenByBuilder<TDerived, TKeySelector, false> then_by(TKeySelector keySelector) const
+			{
+				return _ThenByBuilder<TDerived, TKeySelector, false>(static_cast<const TDerived&>(*this), keySelector);
+			}
+
+			template<typename TKeySelector>
+			_ThenByBuilder<TDerived, TKeySelector, true> then_by_descending(TKeySelector keySelector) const
+			{
+				return _ThenByBuilder<TDerived, TKeySelector, true>(static_cast<const TDerived&>(*this), keySelector);
+			}
+
+			template<typename TElem>
+			std::shared_ptr<IRandomAccessEnumerable<TElem>> build(std::shared_ptr<IEnumerable<TElem>> enumerable)
+			{
+				typedef typename TDerived::template comparer_type<TElem>::type TComparer;
+				return std::shared_ptr<IRandomAccessEnumerable<TElem>>(new _SortEnumerable<TElem, TComparer>(enumerable, static_cast<const TDerived*>(this)->template comparer<TElem>()));
+			}
+
+			template<typename TElem>
+			std::shared_ptr<IRandomAccessEnumerable<TElem>> build(std::shared_ptr<IBidirectionalEnumerable<TElem>> enumerable)
+			{
+				return build((std::shared_ptr<IEnumerable<TElem>>)enumerable);
+			}
+
+			template<typename TElem>
+			std::shared_ptr<IRandomAccessEnumerable<TElem>> build(std::shared_ptr<IRandomAccessEnumerable<TElem>> enumerable)
+			{
+				return build((std::shared_ptr<IEnumerable<TElem>>)enumerable);
+			}
+		};
+
+		template<typename TKeySelector>
+		class _SortByBuilder : public _KeySortBuilder<_SortByBuilder<TKeySelector>>
+		{
+			TKeySelector _keySelector;
+		public:
+			template<typename TElem>
+			struct comparer_type
+			{
+				typedef _KeyComparer<TKeySelector, typename std::decay<typename unaryreturntype<TKeySelector, TElem>::type>::type> type;
+			};
+
+			_SortByBuilder(TKeySelector keySelector) : _keySelector(keySelector) {}
+
+			template<typename TElem>
+			typename comparer_type<TElem>::type comparer() const
+			{
+				return typename comparer_type<TElem>::type(_keySelector);
+			}
+		};
+
+		template<typename TPrevious, typename TKeySelector, bool DESCENDING>
+		class _ThenByBuilder : public _KeySortBuilder<_ThenByBuilder<TPrevious, TKeySelector, DESCENDING>>
+		{
+			TPrevious _previous;
+			TKeySelector _keySelector;
+		public:
+			template<typename TElem>
+			struct comparer_type
+			{
+				typedef _ThenByComparer<typename TPrevious::template comparer_type<TElem>::type, TKeySelector, typename std::decay<typename unaryreturntype<TKeySelector, TElem>::type>::type, DESCENDING> type;
+			};
+
+			_ThenByBuilder(TPrevious previous, TKeySelector keySelector) : _previous(previous), _keySelector(keySelector) {}
+
+			template<typename TElem>
+			typename comparer_type<TElem>::type comparer() const
+			{
+				return typename comparer_type<TElem>::type(_previous.template comparer<TElem>(), _keySelector);
+			}
+		};
+
+		template<typename TComparer>
+		class _OrderByLazyBuilderWithComp
+		{
+			TComparer _comparer;
+		public:
+			_OrderByLazyBuilderWithComp(TComparer comparer) : _comparer(comparer) {}
+
+			template<typename TElem>
+			std::shared_ptr<IRandomAccessEnumerable<TElem>> build(std::shared_ptr<IEnumerable<TElem>> enumerable)
+			{
+				return std::shared_ptr<IRandomAccessEnumerable<TElem>>(new _LazySortEnumerable<TElem, TComparer>(enumerable, _comparer));
+			}
+
+			template<typename TElem>
+			std::shared_ptr<IRandomAccessEnumerable<TElem>> build(std::shared_ptr<IBidirectionalEnumerable<TElem>> enumerable)
+			{
+				return build((std::shared_ptr<IEnumerable<TElem>>)enumerable);
+			}
+
+			template<typename TElem>
+			std::shared_ptr<IRandomAccessEnumerable<TElem>> build(std::shared_ptr<IRandomAccessEnumerable<TElem>> enumerable)
+			{
+				return build((std::shared_ptr<IEnumerable<TElem>>)enumerable);
+			}
+		};
+
+		class _OrderByLazyBuilder
+		{
+		public:
+			template<typename TElem>
+			std::shared_ptr<IRandomAccessEnumerable<TElem>> build(std::shared_ptr<IEnumerable<TElem>> enumerable)
+			{
+				return std::shared_ptr<IRandomAccessEnumerable<TElem>>(new _LazySortEnumerable<TElem, std::less<TElem>>(enumerable, std::less<TElem>()));
+			}
+
+			template<typename TElem>
+			std::shared_ptr<IRandomAccessEnumerable<TElem>> build(std::shared_ptr<IBidirectionalEnumerable<TElem>> enumerable)
+			{
+				return build((std::shared_ptr<IEnumerable<TElem>>)enumerable);
+			}
+
+			template<typename TElem>
+			std::shared_ptr<IRandomAccessEnumerable<TElem>> build(std::shared_ptr<IRandomAccessEnumerable<TElem>> enumerable)
+			{
+				return build((std::shared_ptr<IEnumerable<TElem>>)enumerable);
+			}
+		};
+
+		template<typename TComparer>
+		class _TopKBuilderWithComp
+		{
+			int _count;
+			TComparer _comparer;
+		public:
+			_TopKBuilderWithComp(int count, TComparer comparer) : _count(count), _comparer(comparer) {}
+
+			template<typename TElem>
+			std::shared_ptr<IRandomAccessEnumerable<TElem>> build(std::shared_ptr<IEnumerable<TElem>> enumerable)
+			{
+				return build_top_k(enumerable, _count, _comparer);
+			}
+
+			template<typename TElem>
+			std::shared_ptr<IRandomAccessEnumerable<TElem>> build(std::shared_ptr<IBidirectionalEnumerable<TElem>> enumerable)
+			{
+				return build((std::shared_ptr<IEnumerable<TElem>>)enumerable);
+			}
+
+			template<typename TElem>
+			std::shared_ptr<IRandomAccessEnumerable<TElem>> build(std::shared_ptr<IRandomAccessEnumerable<TElem>> enumerable)
+			{
+				return build((std::shared_ptr<IEnumerable<TElem>>)enumerable);
+			}
+		};
+
+		class _TopKBuilder
+		{
+			int _count;
+		public:
+			_TopKBuilder(int count) : _count(count) {}
+
+			template<typename TElem>
+			std::shared_ptr<IRandomAccessEnumerable<TElem>> build(std::shared_ptr<IEnumerable<TElem>> enumerable)
+			{
+				return build_top_k(enumerable, _count, std::less<TElem>());
 			}
 
 			template<typename TElem>
 			std::shared_ptr<IRandomAccessEnumerable<TElem>> build(std::shared_ptr<IBidirectionalEnumerable<TElem>> enumerable)
 			{
-				return build_sort(enumerable, std::less<TElem>());
+				return build((std::shared_ptr<IEnumerable<TElem>>)enumerable);
 			}
 
 			template<typename TElem>
 			std::shared_ptr<IRandomAccessEnumerable<TElem>> build(std::shared_ptr<IRandomAccessEnumerable<TElem>> enumerable)
 			{
-				return build_sort(enumerable, std::less<TElem>(), enumerable->size());
+				return build((std::shared_ptr<IEnumerable<TElem>>)enumerable);
 			}
 		};
 	}
@@ -110,7 +812,12 @@ namespace xlinq
 	/**
 	*	Performs stable sort on collection.
 	*	This function may be used to sort collection elements using standard
-	*	std::stable_sort algorithm using std::less<T> comparer.
+	*	std::stable_sort algorithm using std::less<T> comparer. Integral, float
+	*	and double elements and tuples or pairs of them are sorted with radix sort.
+	*	Elements are copied when the expression is built and sorted when the
+	*	collection is first accessed. When it is followed by take or first, only
+	*	requested number of smallest elements is selected from the copy instead.
+	*	Parallel queries are sorted by many threads with parallel merge sort.
 	*	@return Builder of sort expression.
 	*/
 	XLINQ_INLINE internal::_SortBuilder sort()
@@ -122,6 +829,8 @@ namespace xlinq
 	*	Performs stable sort on collection.
 	*	This function may be used to sort collection elements using standard
 	*	std::stable_sort algorithm with specified elements comparer.
+	*	Parallel queries are sorted by many threads, so comparer has to be safe
+	*	to call concurrently.
 	*	@return Builder of sort expression.
 	*/
 	template<typename TComparer>
@@ -129,6 +838,83 @@ namespace xlinq
 	{
 		return internal::_SortBuilderWithComp<TComparer>(comparer);
 	}
+
+	/**
+	*	Performs stable sort on collection by keys selected from elements.
+	*	This function may be used to sort collection elements by keys extracted
+	*	from them by keySelector and compared with std::less. Keys are selected
+	*	once per element. Integral keys, float and double keys and tuples or pairs
+	*	of them are sorted with radix sort. Elements with equal keys may be further
+	*	ordered by chaining then_by and then_by_descending calls on returned builder,
+	*	e.g. sort_by(f).then_by(g), in which case keys of all levels are selected
+	*	once per element as well.
+	*	@param keySelector Function selecting key from element.
+	*	@return Builder of sort_by expression.
+	*/
+	template<typename TKeySelector>
+	XLINQ_INLINE internal::_SortByBuilder<TKeySelector> sort_by(TKeySelector keySelector)
+	{
+		return internal::_SortByBuilder<TKeySelector>(keySelector);
+	}
+
+	/**
+	*	Performs lazy stable sort on collection.
+	*	This function may be used to sort collection elements using std::less<T>
+	*	comparer when only some of sorted elements are going to be read. Elements
+	*	are partitioned on demand like in quickselect algorithm, so reading first
+	*	elements or accessing single element by index costs linear time instead of
+	*	sorting whole collection.
+	*	@return Builder of order_by_lazy expression.
+	*/
+	XLINQ_INLINE internal::_OrderByLazyBuilder order_by_lazy()
+	{
+		return internal::_OrderByLazyBuilder();
+	}
+
+	/**
+	*	Performs lazy stable sort on collection.
+	*	This function may be used to sort collection elements using specified
+	*	elements comparer when only some of sorted elements are going to be read.
+	*	Elements are partitioned on demand like in quickselect algorithm, so reading
+	*	first elements or accessing single element by index costs linear time instead
+	*	of sorting whole collection.
+	*	@param comparer Comparer of elements.
+	*	@return Builder of order_by_lazy expression.
+	*/
+	template<typename TComparer>
+	XLINQ_INLINE internal::_OrderByLazyBuilderWithComp<TComparer> order_by_lazy(TComparer comparer)
+	{
+		return internal::_OrderByLazyBuilderWithComp<TComparer>(comparer);
+	}
+
+	/**
+	*	Selects given number of smallest elements in sorted order.
+	*	This function may be used instead of sort followed by take. Elements are
+	*	selected in single pass using bounded heap, so only count elements are kept
+	*	in memory. Order of equal elements is preserved like in stable sort.
+	*	@param count Number of elements to select.
+	*	@return Builder of top_k expression.
+	*/
+	XLINQ_INLINE internal::_TopKBuilder top_k(int count)
+	{
+		return internal::_TopKBuilder(count);
+	}
+
+	/**
+	*	Selects given number of smallest elements in sorted order.
+	*	This function may be used instead of sort followed by take. Elements are
+	*	selected in single pass using bounded heap with specified elements comparer,
+	*	so only count elements are kept in memory. Order of equal elements is
+	*	preserved like in stable sort.
+	*	@param count Number of elements to select.
+	*	@param comparer Comparer of elements.
+	*	@return Builder of top_k expression.
+	*/
+	template<typename TComparer>
+	XLINQ_INLINE internal::_TopKBuilderWithComp<TComparer> top_k(int count, TComparer comparer)
+	{
+		return internal::_TopKBuilderWithComp<TComparer>(count, comparer);
+	}
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,201 @@
+/*
+MIT License
+
+Copyright (c) 2017 TrolleY
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+*	@file xlinq_spill.h
+*	Temporary storage of elements exceeding memory budget.
+*	@author TrolleY
+*/
+#ifndef XLINQ_SPILL_H_
+#define XLINQ_SPILL_H_
+
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "xlinq_defs.h"
+#include "xlinq_base.h"
+#include "xlinq_exception.h"
+
+namespace xlinq
+{
+	/*@cond XLINQ_INTERNAL*/
+	namespace internal
+	{
+		class _BinarySerializer
+		{
+		public:
+			template<typename TElem>
+			void write(std::FILE* file, const TElem& elem) const
+			{
+				static_assert(std::is_trivially_copy_constructible<TElem>::value && std::is_trivially_destructible<TElem>::value, "Elements without custom serializer have to be trivially copyable");
+				std::fwrite(&elem, sizeof(TElem), 1, file);
+			}
+
+			template<typename TElem>
+			bool read(std::FILE* file, TElem& elem) const
+			{
+				return std::fread(&elem, sizeof(TElem), 1, file) == 1;
+			}
+		};
+
+		class _SpillFile
+		{
+			std::shared_ptr<std::FILE> _file;
+			std::mutex _mutex;
+			long long _position;
+			long long _end;
+			bool _writing;
+
+			static long long tell(std::FILE* file)
+			{
+#ifdef _WIN32
+				return _ftelli64(file);
+#else
+				return ftello(file);
+#endif
+			}
+
+			static bool seek(std::FILE* file, long long offset)
+			{
+#ifdef _WIN32
+				return _fseeki64(file, offset, SEEK_SET) == 0;
+#else
+				return fseeko(file, (off_t)offset, SEEK_SET) == 0;
+#endif
+			}
+
+		public:
+			_SpillFile() : _file(std::tmpfile(), [](std::FILE* file) { if (file) std::fclose(file); }), _position(0), _end(0), _writing(false)
+			{
+				if (!_file)
+					throw SpillFailedException();
+			}
+
+			long long end() const { return _end; }
+
+			template<typename TElem, typename TSerializer>
+			void write(const TElem& elem, TSerializer& serializer)
+			{
+				if (!_writing)
+				{
+					if (_position != _end && !seek(_file.get(), _end))
+						throw SpillFailedException();
+					_position = -1;
+					_writing = true;
+				}
+				serializer.write(_file.get(), elem);
+			}
+
+			long long finish()
+			{
+				if (std::fflush(_file.get()) != 0 || std::ferror(_file.get()))
+					throw SpillFailedException();
+				_end = tell(_file.get());
+				_position = _end;
+				_writing = false;
+				return _end;
+			}
+
+			template<typename TElem, typename TSerializer>
+			bool read(long long& offset, TElem& elem, TSerializer& serializer)
+			{
+				if (offset >= _end)
+					return false;
+				std::lock_guard<std::mutex> lock(_mutex);
+				if (offset != _position && !seek(_file.get(), offset))
+					throw SpillFailedException();
+				_position = -1;
+				if (!serializer.read(_file.get(), elem))
+					throw SpillFailedException();
+				_position = offset = tell(_file.get());
+				return true;
+			}
+		};
+
+		template<typename TElem, typename TSerializer>
+		class _SpillFileEnumerator : public IEnumerator<TElem>
+		{
+			std::shared_ptr<_SpillFile> _file;
+			std::shared_ptr<const std::vector<std::pair<long long, long long>>> _ranges;
+			TSerializer _serializer;
+			int _range;
+			long long _offset;
+			TElem _current;
+			bool _started, _finished;
+
+		public:
+			_SpillFileEnumerator(std::shared_ptr<_SpillFile> file, std::shared_ptr<const std::vector<std::pair<long long, long long>>> ranges, TSerializer serializer)
+				: _file(file), _ranges(ranges), _serializer(serializer), _range(0), _offset(ranges->empty() ? 0 : ranges->front().first), _started(false), _finished(false) {}
+
+			bool next() override
+			{
+				if (_finished) throw IterationFinishedException();
+				_started = true;
+				while (_range < (int)_ranges->size() && _offset >= (*_ranges)[_range].second)
+				{
+					if (++_range < (int)_ranges->size())
+						_offset = (*_ranges)[_range].first;
+				}
+				if (_range == (int)_ranges->size() || !_file->read(_offset, _current, _serializer))
+					_finished = true;
+				return !_finished;
+			}
+
+			TElem current() override
+			{
+				if (_finished) throw IterationFinishedException();
+				if (!_started) throw IterationNotStartedException();
+				return _current;
+			}
+
+			const TElem* current_ptr() override
+			{
+				return _started && !_finished ? &_current : nullptr;
+			}
+
+			bool equals(std::shared_ptr<IEnumerator<TElem>> other) const override
+			{
+				auto pother = std::dynamic_pointer_cast<_SpillFileEnumerator<TElem, TSerializer>>(other);
+				if (!pother)
+					return false;
+				return this->_file == pother->_file &&
+					this->_ranges == pother->_ranges &&
+					this->_offset == pother->_offset &&
+					this->_started == pother->_started &&
+					this->_finished == pother->_finished;
+			}
+
+			std::shared_ptr<IEnumerator<TElem>> clone() const override
+			{
+				return std::shared_ptr<IEnumerator<TElem>>(new _SpillFileEnumerator<TElem, TSerializer>(*this));
+			}
+		};
+	}
+	/*@endcond*/
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,236 @@
+/*
+MIT License
+
+Copyright (c) 2017 TrolleY
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+*	@file xlinq_static.h
+*	Compile time xlinq pipelines without virtual dispatch and heap allocations.
+*	@author TrolleY
+*/
+#ifndef XLINQ_STATIC_H_
+#define XLINQ_STATIC_H_
+
+#include <memory>
+#include <iterator>
+#include "xlinq_base.h"
+#include "xlinq_exception.h"
+
+namespace xlinq
+{
+	/**
+	*	Base class of statically composed enumerables.
+	*	Static enumerable is a value type which knows type of every stage of
+	*	the query, so whole pipeline is compiled into single loop without
+	*	virtual calls and without heap allocations. Deriving class should define
+	*	ElemType and Enumerator types and const getEnumerator method returning
+	*	Enumerator by value. Static enumerators provide non virtual next and current
+	*	methods following the same protocol as IEnumerator, except they do not
+	*	validate state, so current may be called only after next returned true.
+	*	Static enumerables may be converted to IEnumerable using to_enumerable builder.
+	*/
+	template<typename TDerived>
+	class StaticEnumerable
+	{
+	public:
+		/**
+		*	Returns reference to deriving enumerable.
+		*	@return Reference to deriving enumerable.
+		*/
+		const TDerived& derived() const
+		{
+			return static_cast<const TDerived&>(*this);
+		}
+	};
+
+	/*@cond XLINQ_INTERNAL*/
+	namespace internal
+	{
+		template<typename TIterator, typename TElem>
+		class _StaticStlEnumerator
+		{
+		private:
+			TIterator _begin, _end;
+			bool _started;
+
+		public:
+			_StaticStlEnumerator(TIterator begin, TIterator end) : _begin(begin), _end(end), _started(false) {}
+
+			bool next()
+			{
+				if (_started)
+					++_begin;
+				else _started = true;
+				return _begin != _end;
+			}
+
+			TElem current()
+			{
+				return *_begin;
+			}
+		};
+
+		template<typename TIterator>
+		class _StaticStlEnumerable : public StaticEnumerable<_StaticStlEnumerable<TIterator>>
+		{
+		private:
+			TIterator _begin, _end;
+
+		public:
+			typedef typename std::decay<decltype(*std::declval<TIterator>())>::type ElemType;
+			typedef _StaticStlEnumerator<TIterator, ElemType> Enumerator;
+
+			_StaticStlEnumerable(TIterator begin, TIterator end) : _begin(begin), _end(end) {}
+
+			Enumerator getEnumerator() const
+			{
+				return Enumerator(_begin, _end);
+			}
+		};
+
+		template<typename TSource>
+		class _StaticBridgeEnumerator : public IEnumerator<typename TSource::ElemType>
+		{
+		private:
+			typedef typename TSource::ElemType TElem;
+
+			typename TSource::Enumerator _enumerator;
+			const TSource* _owner;
+			int _index;
+			bool _finished;
+
+		public:
+			_StaticBridgeEnumerator(typename TSource::Enumerator enumerator, const TSource* owner)
+				: _enumerator(enumerator), _owner(owner), _index(-1), _finished(false) {}
+
+			bool next() override
+			{
+				if (_finished)
+					throw IterationFinishedException();
+				++_index;
+				_finished = !_enumerator.next();
+				return !_finished;
+			}
+
+			TElem current() override
+			{
+				if (_index < 0)
+					throw IterationNotStartedException();
+				if (_finished)
+					throw IterationFinishedException();
+				return _enumerator.current();
+			}
+
+			bool equals(std::shared_ptr<IEnumerator<TElem>> other) const override
+			{
+				auto pother = std::dynamic_pointer_cast<_StaticBridgeEnumerator<TSource>>(other);
+				if (!pother)
+					return false;
+				return this->_owner == pother->_owner &&
+					this->_index == pother->_index;
+			}
+
+			std::shared_ptr<IEnumerator<TElem>> clone() const override
+			{
+				return std::shared_ptr<IEnumerator<TElem>>(new _StaticBridgeEnumerator<TSource>(*this));
+			}
+		};
+
+		template<typename TSource>
+		class _StaticBridgeEnumerable : public IEnumerable<typename TSource::ElemType>
+		{
+		private:
+			typedef typename TSource::ElemType TElem;
+
+			TSource _source;
+
+		public:
+			_StaticBridgeEnumerable(const TSource& source) : _source(source) {}
+
+			std::shared_ptr<IEnumerator<TElem>> createEnumerator() override
+			{
+				return std::shared_ptr<IEnumerator<TElem>>(new _StaticBridgeEnumerator<TSource>(_source.getEnumerator(), &_source));
+			}
+		};
+
+		class _ToEnumerableBuilder
+		{
+		public:
+			template<typename TSource>
+			std::shared_ptr<IEnumerable<typename TSource::ElemType>> build(const StaticEnumerable<TSource>& enumerable)
+			{
+				return std::shared_ptr<IEnumerable<typename TSource::ElemType>>(new _StaticBridgeEnumerable<TSource>(enumerable.derived()));
+			}
+		};
+	}
+	/*@endcond*/
+
+	/**
+	*	Nice syntax operator for executing static xlinq command.
+	*	This operator should be used to build static xlinq queries.
+	*	@param obj The static enumerable object.
+	*	@param builder The expression builder object. It should have build method
+	*	accepting static enumerables defined.
+	*/
+	template<typename TSource, typename TBuilder>
+	auto operator>>(const StaticEnumerable<TSource>& obj, TBuilder builder) -> decltype(builder.build(obj))
+	{
+		return builder.build(obj);
+	}
+
+	/**
+	*	Creates static enumerable from STL container.
+	*	Container is not copied, so it has to outlive created enumerable.
+	*	@param container Source container.
+	*	@return Static enumerable over container elements.
+	*/
+	template<typename TContainer>
+	XLINQ_INLINE internal::_StaticStlEnumerable<decltype(std::begin(std::declval<const TContainer&>()))> from_static(const TContainer& container)
+	{
+		return internal::_StaticStlEnumerable<decltype(std::begin(std::declval<const TContainer&>()))>(std::begin(container), std::end(container));
+	}
+
+	/**
+	*	Creates static enumerable from pair of iterators.
+	*	@param begin Iterator pointing to first element.
+	*	@param end Iterator pointing after last element.
+	*	@return Static enumerable over given range.
+	*/
+	template<typename TIterator>
+	XLINQ_INLINE internal::_StaticStlEnumerable<TIterator> from_static(TIterator begin, TIterator end)
+	{
+		return internal::_StaticStlEnumerable<TIterator>(begin, end);
+	}
+
+	/**
+	*	Converts static enumerable into IEnumerable.
+	*	This function may be used to return statically composed query
+	*	through dynamic xlinq interfaces. Static pipeline is copied into
+	*	created enumerable.
+	*	@return Builder of to_enumerable expression.
+	*/
+	XLINQ_INLINE internal::_ToEnumerableBuilder to_enumerable()
+	{
+		return internal::_ToEnumerableBuilder();
+	}
+}
+
+#endif
\ No newline at end of file
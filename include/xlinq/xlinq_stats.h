@@ -0,0 +1,260 @@
+/*
+MIT License
+
+Copyright (c) 2017 TrolleY
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+*	@file xlinq_stats.h
+*	Calculating several statistics of collection elements in one pass.
+*	@author TrolleY
+*/
+#ifndef XLINQ_STATS_H_
+#define XLINQ_STATS_H_
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+#include "xlinq_base.h"
+#include "xlinq_exception.h"
+#include "xlinq_reduce.h"
+#include "xlinq_static.h"
+
+namespace xlinq
+{
+	/**
+	*	Statistics of collection elements calculated by stats.
+	*/
+	template<typename TElem>
+	struct Statistics
+	{
+		/**
+		*	Number of elements.
+		*/
+		int count;
+		/**
+		*	Sum of elements accumulated in element type, as in sum.
+		*/
+		TElem sum;
+		/**
+		*	Smallest element.
+		*/
+		TElem min;
+		/**
+		*	Largest element.
+		*/
+		TElem max;
+		/**
+		*	Arithmetic mean of elements calculated in double precision.
+		*/
+		double mean;
+		/**
+		*	Sum of squared deviations of elements from mean.
+		*/
+		double squaredDeviations;
+
+		/**
+		*	Returns population variance of elements.
+		*	@return Mean of squared deviations of elements from mean.
+		*/
+		double variance() const
+		{
+			return squaredDeviations / count;
+		}
+
+		/**
+		*	Returns sample variance of elements.
+		*	It is not a number if collection contains only one element.
+		*	@return Sum of squared deviations of elements from mean divided by count - 1.
+		*/
+		double sample_variance() const
+		{
+			return squaredDeviations / (count - 1);
+		}
+
+		/**
+		*	Returns population standard deviation of elements.
+		*	@return Square root of population variance.
+		*/
+		double stddev() const
+		{
+			return std::sqrt(variance());
+		}
+	};
+
+	/*@cond XLINQ_INTERNAL*/
+	namespace internal
+	{
+		template<typename TElem>
+		class _StatisticsAccumulator
+		{
+		private:
+			Statistics<TElem> _statistics;
+
+			void add_block(const TElem* data, int size)
+			{
+				TElem sum = reduce_span<TElem, REDUCE_SUM>(data, size);
+				TElem min = reduce_span<TElem, REDUCE_MIN>(data, size);
+				TElem max = reduce_span<TElem, REDUCE_MAX>(data, size);
+				double mean = reduce_span<double, REDUCE_SUM>(data, size) / size;
+				double squaredDeviations = deviation_span(data, size, mean);
+				if (!_statistics.count)
+				{
+					_statistics.count = size;
+					_statistics.sum = sum;
+					_statistics.min = min;
+					_statistics.max = max;
+					_statistics.mean = mean;
+					_statistics.squaredDeviations = squaredDeviations;
+					return;
+				}
+				double delta = mean - _statistics.mean;
+				double total = (double)_statistics.count + size;
+				_statistics.squaredDeviations += squaredDeviations + delta * delta * _statistics.count * size / total;
+				_statistics.mean += delta * size / total;
+				_statistics.count += size;
+				_statistics.sum += sum;
+				if (_statistics.min > min)
+					_statistics.min = min;
+				if (_statistics.max < max)
+					_statistics.max = max;
+			}
+		public:
+			_StatisticsAccumulator()
+			{
+				_statistics.count = 0;
+			}
+
+			void add(const TElem* data, int size)
+			{
+				for (int offset = 0; offset < size; offset += XLINQ_BATCH_SIZE)
+					add_block(data + offset, std::min(XLINQ_BATCH_SIZE, size - offset));
+			}
+
+			Statistics<TElem> result() const
+			{
+				if (!_statistics.count)
+					throw IterationFinishedException();
+				return _statistics;
+			}
+		};
+
+		template<typename TElem>
+		void add_batch(_StatisticsAccumulator<TElem>& statistics, const std::vector<TElem>& batch)
+		{
+			statistics.add(batch.data(), (int)batch.size());
+		}
+
+		inline void add_batch(_StatisticsAccumulator<bool>& statistics, const std::vector<bool>& batch)
+		{
+			std::unique_ptr<bool[]> elements(new bool[batch.size()]);
+			std::copy(batch.begin(), batch.end(), elements.get());
+			statistics.add(elements.get(), (int)batch.size());
+		}
+
+		class _StatsBuilder
+		{
+			template<typename TElem>
+			Statistics<TElem> int_stats(std::shared_ptr<IEnumerable<TElem>> enumerable)
+			{
+				_StatisticsAccumulator<TElem> statistics;
+				_BatchReader<TElem> reader(enumerable->getEnumerator());
+				while (reader.read())
+					add_batch(statistics, reader.batch());
+				return statistics.result();
+			}
+		public:
+			template<typename TElem>
+			Statistics<TElem> build(std::shared_ptr<IEnumerable<TElem>> enumerable)
+			{
+				return int_stats(enumerable);
+			}
+
+			template<typename TElem>
+			Statistics<TElem> build(std::shared_ptr<IBidirectionalEnumerable<TElem>> enumerable)
+			{
+				return int_stats((std::shared_ptr<IEnumerable<TElem>>)enumerable);
+			}
+
+			template<typename TElem>
+			Statistics<TElem> build(std::shared_ptr<IRandomAccessEnumerable<TElem>> enumerable)
+			{
+				auto data = enumerable->data();
+				if (!data)
+					return int_stats((std::shared_ptr<IEnumerable<TElem>>)enumerable);
+				_StatisticsAccumulator<TElem> statistics;
+				statistics.add(data, enumerable->size());
+				return statistics.result();
+			}
+
+			template<typename TSource>
+			Statistics<typename TSource::ElemType> build(const StaticEnumerable<TSource>& enumerable)
+			{
+				_StatisticsAccumulator<typename TSource::ElemType> statistics;
+				std::vector<typename TSource::ElemType> batch;
+				batch.reserve(XLINQ_BATCH_SIZE);
+				auto en = enumerable.derived().getEnumerator();
+				while (en.next())
+				{
+					batch.push_back(en.current());
+					if ((int)batch.size() == XLINQ_BATCH_SIZE)
+					{
+						add_batch(statistics, batch);
+						batch.clear();
+					}
+				}
+				if (!batch.empty())
+					add_batch(statistics, batch);
+				return statistics.result();
+			}
+
+			template<typename TQuery>
+			Statistics<typename TQuery::ElemType> build(const ParallelEnumerable<TQuery>& enumerable)
+			{
+				_StatisticsAccumulator<typename TQuery::ElemType> statistics;
+				auto elements = enumerable.derived().to_vector();
+				if (!elements.empty())
+					add_batch(statistics, elements);
+				return statistics.result();
+			}
+		};
+	}
+	/*@endcond*/
+
+	/**
+	*	Calculates count, sum, minimum, maximum, mean and variance of collection elements.
+	*	This function may be used instead of separate count, sum, min, max and avg
+	*	expressions. It enumerates collection only once, so filtering and projections
+	*	of source collection are evaluated once for every element.
+	*	Elements are processed in blocks of XLINQ_BATCH_SIZE elements, with vector
+	*	instructions where possible, and variance of blocks is merged in a numerically
+	*	stable way.
+	*	It will throw IterationFinishedException if collection contains no elements.
+	*	@return Builder of stats expression.
+	*/
+	XLINQ_INLINE internal::_StatsBuilder stats()
+	{
+		return internal::_StatsBuilder();
+	}
+}
+
+#endif
\ No newline at end of file
@@ -30,44 +30,99 @@ SOFTWARE.
 #define XLINQ_SUM_H_
 
 #include "xlinq_base.h"
+#include "xlinq_from.h"
+#include "xlinq_reduce.h"
+#include "xlinq_static.h"
 
 namespace xlinq
 {
 	/*@cond XLINQ_INTERNAL*/
 	namespace internal
 	{
+		template<typename TAcc>
 		class _SumBuilder
 		{
 			template<typename TElem>
-			TElem int_sum(std::shared_ptr<IEnumerable<TElem>> enumerable)
+			using Result = typename std::conditional<std::is_void<TAcc>::value, TElem, TAcc>::type;
+
+			SumMode _mode;
+
+			template<typename TElem>
+			Result<TElem> int_sum(std::shared_ptr<IEnumerable<TElem>> enumerable)
 			{
-				auto en = enumerable->getEnumerator();
-				en->next();
-				auto sumVal = en->current();
-				while(en->next())
-				{
-					sumVal += en->current();
-				}
-				return sumVal;
+				_BatchReader<TElem> reader(enumerable->getEnumerator());
+				if (!reader.read())
+					throw IterationFinishedException();
+				long long count;
+				return sum_batches<Result<TElem>>(reader, _mode, count);
+			}
+
+			template<typename TElem>
+			Result<TElem> span_sum(const TElem* data, int size)
+			{
+				if (!size)
+					throw IterationFinishedException();
+				return sum_span<Result<TElem>>(data, size, _mode);
 			}
 		public:
+			_SumBuilder() : _mode(SumMode::FAST) {}
+
+			_SumBuilder mode(SumMode mode) const
+			{
+				_SumBuilder builder(*this);
+				builder._mode = mode;
+				return builder;
+			}
+
 			template<typename TElem>
-			TElem build(std::shared_ptr<IEnumerable<TElem>> enumerable)
+			Result<TElem> build(std::shared_ptr<IEnumerable<TElem>> enumerable)
 			{
 				return int_sum(enumerable);
 			}
 
 			template<typename TElem>
-			TElem build(std::shared_ptr<IBidirectionalEnumerable<TElem>> enumerable)
+			Result<TElem> build(std::shared_ptr<IBidirectionalEnumerable<TElem>> enumerable)
 			{
 				return int_sum((std::shared_ptr<IEnumerable<TElem>>)enumerable);
 			}
 
 			template<typename TElem>
-			TElem build(std::shared_ptr<IRandomAccessEnumerable<TElem>> enumerable)
+			Result<TElem> build(std::shared_ptr<IRandomAccessEnumerable<TElem>> enumerable)
 			{
+				auto data = enumerable->data();
+				if (data)
+					return span_sum(data, enumerable->size());
 				return int_sum((std::shared_ptr<IEnumerable<TElem>>)enumerable);
 			}
+
+			template<typename TSource>
+			Result<typename TSource::ElemType> build(const StaticEnumerable<TSource>& enumerable)
+			{
+				auto en = enumerable.derived().getEnumerator();
+				if (!en.next())
+					throw IterationFinishedException();
+				if (_mode != SumMode::FAST && std::is_floating_point<Result<typename TSource::ElemType>>::value)
+				{
+					std::vector<Result<typename TSource::ElemType>> elements;
+					do
+						elements.push_back(en.current());
+					while (en.next());
+					return span_sum(elements.data(), (int)elements.size());
+				}
+				Result<typename TSource::ElemType> result = en.current();
+				while (en.next())
+					result += en.current();
+				return result;
+			}
+
+			template<typename TQuery>
+			Result<typename TQuery::ElemType> build(const ParallelEnumerable<TQuery>& enumerable)
+			{
+				if (std::is_void<TAcc>::value && _mode == SumMode::FAST)
+					return enumerable.derived().sum();
+				auto elements = enumerable.derived().to_vector();
+				return build(from(elements));
+			}
 		};
 	}
 	/*@endcond*/
@@ -77,11 +132,20 @@ namespace xlinq
 	*	Calculates sum of collection elements.
 	*	This function may be used to calculate sum of collection elements.
 	*	It will throw IterationFinishedException if collection contains no elements.
+	*	Contiguous or batched integer and floating point elements are added with
+	*	SSE2 or AVX2 instructions, so floating point sums may be rounded differently
+	*	than when elements are added one by one.
+	*	Elements are accumulated in TAcc type, or in element type if TAcc is void, so
+	*	sum<long long>() may be used to add ints without overflow.
+	*	Floating point accumulation may be made more accurate with mode method of
+	*	returned builder, which accepts SumMode. Mode is ignored for other accumulators,
+	*	as they are always exact.
 	*	@return Builder of sum expression.
 	*/
-	XLINQ_INLINE internal::_SumBuilder sum()
+	template<typename TAcc = void>
+	XLINQ_INLINE internal::_SumBuilder<TAcc> sum()
 	{
-		return internal::_SumBuilder();
+		return internal::_SumBuilder<TAcc>();
 	}
 }
 
@@ -29,9 +29,11 @@ SOFTWARE.
 #ifndef XLINQ_TAKE_H_
 #define XLINQ_TAKE_H_
 
+#include <algorithm>
 #include <memory>
 #include <cassert>
 #include "xlinq_base.h"
+#include "xlinq_static.h"
 
 namespace xlinq
 {
@@ -51,7 +53,7 @@ namespace xlinq
 
 			bool next() override
 			{
-				if (_source && _source->next() && _predicate(_source->current()))
+				if (_source && _source->next() && current_matches(_source, _predicate))
 					return true;
 				_source = nullptr;
 				return false;
@@ -63,6 +65,12 @@ namespace xlinq
 				return _source->current();
 			}
 
+			const TElem* current_ptr() override
+			{
+				if (!_source) throw IterationFinishedException();
+				return _source->current_ptr();
+			}
+
 			bool equals(std::shared_ptr<IEnumerator<TElem>> other) const override
 			{
 				auto pother = std::dynamic_pointer_cast<_TakeWhileEnumerator<TElem, TPredicate>>(other);
@@ -145,6 +153,11 @@ namespace xlinq
 				return _source->current();
 			}
 
+			const TElem* current_ptr() override
+			{
+				return _source->current_ptr();
+			}
+
 			bool equals(std::shared_ptr<IEnumerator<TElem>> other) const override
 			{
 				auto pother = std::dynamic_pointer_cast<_TakeEnumerator<TElem>>(other);
@@ -171,6 +184,14 @@ namespace xlinq
 				: _source(source), _maxItems(maxItems)
 			{}
 
+			int known_size() override
+			{
+				int size = _source->known_size();
+				if (size < 0)
+					return -1;
+				return std::max(0, std::min(size, _maxItems));
+			}
+
 			std::shared_ptr<IEnumerator<TElem>> createEnumerator() override
 			{
 				return std::shared_ptr<IEnumerator<TElem>>(new _TakeEnumerator<TElem>(_source->getEnumerator(), _maxItems));
@@ -233,6 +254,13 @@ namespace xlinq
 				return _source->current();
 			}
 
+			const TElem* current_ptr() override
+			{
+				if (_index < 0) throw IterationNotStartedException();
+				if (_index == _maxItems) throw IterationFinishedException();
+				return _source->current_ptr();
+			}
+
 			bool equals(std::shared_ptr<IEnumerator<TElem>> other) const override
 			{
 				auto pother = std::dynamic_pointer_cast<_TakeRandomAccessEnumerator<TElem>>(other);
@@ -304,7 +332,54 @@ namespace xlinq
 
 			int size() override
 			{
-				return _maxItems;
+				auto size = _source->size();
+				return size > _maxItems ? _maxItems : size;
+			}
+
+			const TElem* data() override
+			{
+				return _source->data();
+			}
+		};
+
+		template<typename TSourceEnumerator, typename TElem>
+		class _StaticTakeEnumerator
+		{
+		private:
+			TSourceEnumerator _source;
+			int _maxItems;
+		public:
+			_StaticTakeEnumerator(TSourceEnumerator source, int maxItems) : _source(source), _maxItems(maxItems) {}
+
+			bool next()
+			{
+				if (_maxItems <= 0)
+					return false;
+				--_maxItems;
+				return _source.next();
+			}
+
+			TElem current()
+			{
+				return _source.current();
+			}
+		};
+
+		template<typename TSource>
+		class _StaticTakeEnumerable : public StaticEnumerable<_StaticTakeEnumerable<TSource>>
+		{
+		private:
+			TSource _source;
+			int _maxItems;
+		public:
+			typedef typename TSource::ElemType ElemType;
+			typedef _StaticTakeEnumerator<typename TSource::Enumerator, ElemType> Enumerator;
+
+			_StaticTakeEnumerable(const TSource& source, int maxItems) : _source(source), _maxItems(maxItems) {}
+
+			Enumerator getEnumerator() const
+			{
+				return Enumerator(_source.getEnumerator(), _maxItems);
 			}
 		};
 
@@ -330,8 +405,17 @@ namespace xlinq
 			template<typename TElem>
 			std::shared_ptr<IRandomAccessEnumerable<TElem>> build(std::shared_ptr<IRandomAccessEnumerable<TElem>> enumerable)
 			{
+				auto sorted = std::dynamic_pointer_cast<_SortedFrontSource<TElem>>(enumerable);
+				if (sorted)
+					return sorted->sorted_front(_maxItems);
 				return std::shared_ptr<IRandomAccessEnumerable<TElem>>(new internal::_TakeRandomAccessEnumerable<TElem>(enumerable, _maxItems));
 			}
+
+			template<typename TSource>
+			_StaticTakeEnumerable<TSource> build(const StaticEnumerable<TSource>& enumerable)
+			{
+				return _StaticTakeEnumerable<TSource>(enumerable.derived(), _maxItems);
+			}
 		};
 	}
 	/*@endcond*/
@@ -30,6 +30,7 @@ SOFTWARE.
 #define XLINQ_TO_CONTAINER_H_
 
 #include "xlinq_base.h"
+#include "xlinq_static.h"
 #include "xlinq_stl.h"
 #include "xlinq_select.h"
 #include <utility>
@@ -48,26 +49,55 @@ namespace xlinq
 	{
 		class _ToVectorBuilder
 		{
+			template<typename TElem>
+			void int_to_vector(std::shared_ptr<IEnumerator<TElem>> enumerator, std::vector<TElem>& result)
+			{
+				while (enumerator->next_batch(result, XLINQ_BATCH_SIZE) == XLINQ_BATCH_SIZE);
+			}
 		public:
 			template<typename TElem>
 			std::vector<TElem> build(std::shared_ptr<IEnumerable<TElem>> enumerable)
 			{
-				auto container = enumerable >> stl();
-				return std::vector<TElem>(container.begin(), container.end());
+				std::vector<TElem> result;
+				int size = enumerable->known_size();
+				if (size > 0)
+					result.reserve(size);
+				int_to_vector(enumerable->getEnumerator(), result);
+				return result;
 			}
 
 			template<typename TElem>
 			std::vector<TElem> build(std::shared_ptr<IBidirectionalEnumerable<TElem>> enumerable)
 			{
-				auto container = enumerable >> stl();
-				return std::vector<TElem>(container.begin(), container.end());
+				return build((std::shared_ptr<IEnumerable<TElem>>)enumerable);
 			}
 
 			template<typename TElem>
 			std::vector<TElem> build(std::shared_ptr<IRandomAccessEnumerable<TElem>> enumerable)
 			{
-				auto container = enumerable >> stl();
-				return std::vector<TElem>(container.begin(), container.end());
+				auto data = enumerable->data();
+				if (data)
+					return std::vector<TElem>(data, data + enumerable->size());
+				std::vector<TElem> result;
+				result.reserve(enumerable->size());
+				int_to_vector((std::shared_ptr<IEnumerator<TElem>>)enumerable->getEnumerator(), result);
+				return result;
+			}
+
+			template<typename TSource>
+			std::vector<typename TSource::ElemType> build(const StaticEnumerable<TSource>& enumerable)
+			{
+				std::vector<typename TSource::ElemType> result;
+				auto enumerator = enumerable.derived().getEnumerator();
+				while (enumerator.next())
+					result.push_back(enumerator.current());
+				return result;
+			}
+
+			template<typename TQuery>
+			auto build(const ParallelEnumerable<TQuery>& enumerable) -> decltype(enumerable.derived().to_vector())
+			{
+				return enumerable.derived().to_vector();
 			}
 		};
 
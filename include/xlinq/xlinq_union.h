@@ -30,10 +30,10 @@ SOFTWARE.
 #define XLINQ_UNION_H_
 
 #include <memory>
-#include <unordered_set>
 #include "xlinq_base.h"
 #include "xlinq_from.h"
 #include "xlinq_concat.h"
+#include "xlinq_hash_set.h"
 
 namespace xlinq
 {
@@ -49,21 +49,20 @@ namespace xlinq
 		template<typename TContainer, typename TElem, typename THasher, typename TEqComp>
 		class _UnionEnumerator : public IEnumerator<TElem>
 		{
-			const int default_buckets = 8;
 			std::shared_ptr<UnionContainerHolder<TContainer>> _holder; // just to prevent container from dealloc
-			std::unordered_set<TElem, THasher, TEqComp> _set;
+			FlatHashSet<TElem, THasher, TEqComp> _set;
 			std::shared_ptr<IEnumerator<TElem>> _source;
 
-			_UnionEnumerator(std::shared_ptr<UnionContainerHolder<TContainer>> holder, const std::unordered_set<TElem, THasher, TEqComp>& set, std::shared_ptr<IEnumerator<TElem>> source)
+			_UnionEnumerator(std::shared_ptr<UnionContainerHolder<TContainer>> holder, const FlatHashSet<TElem, THasher, TEqComp>& set, std::shared_ptr<IEnumerator<TElem>> source)
 				: _holder(holder), _set(set), _source(source) {}
 		public:
-			_UnionEnumerator(std::shared_ptr<UnionContainerHolder<TContainer>> holder, THasher hasher, TEqComp eqComp, std::shared_ptr<IEnumerator<TElem>> source)
-				: _holder(holder), _set(default_buckets, hasher, eqComp), _source(source) {}
+			_UnionEnumerator(std::shared_ptr<UnionContainerHolder<TContainer>> holder, THasher hasher, TEqComp eqComp, int sizeHint, std::shared_ptr<IEnumerator<TElem>> source)
+				: _holder(holder), _set(hasher, eqComp, sizeHint), _source(source) {}
 
 			bool next() override
 			{
 				while (_source->next())
-					if (_set.insert(_source->current()).second)
+					if (_set.insert(_source->current()))
 						return true;
 				return false;
 			}
@@ -102,7 +101,8 @@ namespace xlinq
 
 			std::shared_ptr<IEnumerator<TElem>> createEnumerator() override
 			{
-				return std::shared_ptr<IEnumerator<TElem>>(new _UnionEnumerator<TContainer, TElem, THasher, TEqComp>(_holder, _hasher, _eqComp, (_source >> concat(_holder->container))->getEnumerator()));
+				std::shared_ptr<IEnumerable<TElem>> concatenated = _source >> concat(_holder->container);
+				return std::shared_ptr<IEnumerator<TElem>>(new _UnionEnumerator<TContainer, TElem, THasher, TEqComp>(_holder, _hasher, _eqComp, size_hint(concatenated), concatenated->getEnumerator()));
 			}
 		};
 
@@ -29,20 +29,70 @@ SOFTWARE.
 #ifndef XLINQ_WHERE_H_
 #define XLINQ_WHERE_H_
 
+#include <algorithm>
+#include <cstdint>
 #include <memory>
+#include <vector>
 #include "xlinq_base.h"
+#include "xlinq_predicate.h"
+#include "xlinq_static.h"
 
 namespace xlinq
 {
 	/*@cond XLINQ_INTERNAL*/
 	namespace internal
 	{
+		template<typename TElem, typename TPredicate>
+		int select_batch(TPredicate& predicate, const std::vector<TElem>& batch, std::vector<TElem>& buffer, std::false_type)
+		{
+			int fetched = 0;
+			for (auto& elem : batch)
+			{
+				if (predicate(elem))
+				{
+					buffer.push_back(elem);
+					++fetched;
+				}
+			}
+			return fetched;
+		}
+
+		template<typename TElem, typename TPredicate>
+		int select_batch(TPredicate& predicate, const std::vector<TElem>& batch, std::vector<TElem>& buffer, std::true_type)
+		{
+			int selection[PREDICATE_BLOCK];
+			int fetched = 0;
+			for (int offset = 0; offset < (int)batch.size(); offset += PREDICATE_BLOCK)
+			{
+				int size = std::min((int)PREDICATE_BLOCK, (int)batch.size() - offset);
+				std::uint64_t mask = predicate.match(batch.data() + offset, size);
+				int selected = 0;
+				for (int i = 0; i < size; ++i)
+				{
+					selection[selected] = i;
+					selected += (int)((mask >> i) & 1);
+				}
+				for (int i = 0; i < selected; ++i)
+					buffer.push_back(batch[offset + selection[i]]);
+				fetched += selected;
+			}
+			return fetched;
+		}
+
+		template<typename TElem, typename TPredicate>
+		int select_batch(TPredicate& predicate, const std::vector<TElem>& batch, std::vector<TElem>& buffer)
+		{
+			return select_batch(predicate, batch, buffer, std::integral_constant<bool,
+				_IsPredicateExpression<TPredicate>::value && !std::is_same<TElem, bool>::value>());
+		}
+
 		template<typename TElem, typename TPredicate>
 		class _WhereEnumerator : public IEnumerator<TElem>
 		{
 		private:
 			std::shared_ptr<IEnumerator<TElem>> _source;
 			TPredicate _predicate;
+			std::vector<TElem> _batch;
 		public:
 			_WhereEnumerator(std::shared_ptr<IEnumerator<TElem>> source, TPredicate predicate)
 				: _source(source), _predicate(predicate)
@@ -51,7 +101,7 @@ namespace xlinq
 			bool next() override
 			{
 				while (_source->next())
-					if (_predicate(_source->current()))
+					if (current_matches(_source, _predicate))
 						return true;
 				return false;
 			}
@@ -61,6 +111,25 @@ namespace xlinq
 				return _source->current();
 			}
 
+			const TElem* current_ptr() override
+			{
+				return _source->current_ptr();
+			}
+
+			int next_batch(std::vector<TElem>& buffer, int count) override
+			{
+				int fetched = 0;
+				int requested;
+				do
+				{
+					requested = count - fetched;
+					_batch.clear();
+					_source->next_batch(_batch, requested);
+					fetched += select_batch(_predicate, _batch, buffer);
+				} while (fetched < count && (int)_batch.size() == requested);
+				return fetched;
+			}
+
 			bool equals(std::shared_ptr<IEnumerator<TElem>> other) const override
 			{
 				auto pother = std::dynamic_pointer_cast<_WhereEnumerator<TElem, TPredicate>>(other);
@@ -81,6 +150,7 @@ namespace xlinq
 		private:
 			std::shared_ptr<IBidirectionalEnumerator<TElem>> _source;
 			TPredicate _predicate;
+			std::vector<TElem> _batch;
 		public:
 			_WhereBidirectionalEnumerator(std::shared_ptr<IBidirectionalEnumerator<TElem>> source, TPredicate predicate)
 				: _source(source), _predicate(predicate)
@@ -89,7 +159,7 @@ namespace xlinq
 			bool next() override
 			{
 				while (_source->next())
-					if (_predicate(_source->current()))
+					if (current_matches(_source, _predicate))
 						return true;
 				return false;
 			}
@@ -97,7 +167,7 @@ namespace xlinq
 			bool back() override
 			{
 				while (_source->back())
-					if (_predicate(_source->current()))
+					if (current_matches(_source, _predicate))
 						return true;
 				return false;
 			}
@@ -107,6 +177,25 @@ namespace xlinq
 				return _source->current();
 			}
 
+			const TElem* current_ptr() override
+			{
+				return _source->current_ptr();
+			}
+
+			int next_batch(std::vector<TElem>& buffer, int count) override
+			{
+				int fetched = 0;
+				int requested;
+				do
+				{
+					requested = count - fetched;
+					_batch.clear();
+					_source->next_batch(_batch, requested);
+					fetched += select_batch(_predicate, _batch, buffer);
+				} while (fetched < count && (int)_batch.size() == requested);
+				return fetched;
+			}
+
 			bool equals(std::shared_ptr<IEnumerator<TElem>> other) const override
 			{
 				auto pother = std::dynamic_pointer_cast<_WhereBidirectionalEnumerator<TElem, TPredicate>>(other);
@@ -162,6 +251,51 @@ namespace xlinq
 			}
 		};
 
+		template<typename TSourceEnumerator, typename TElem, typename TPredicate>
+		class _StaticWhereEnumerator
+		{
+		private:
+			TSourceEnumerator _source;
+			TPredicate _predicate;
+		public:
+			_StaticWhereEnumerator(TSourceEnumerator source, TPredicate predicate)
+				: _source(source), _predicate(predicate)
+			{}
+
+			bool next()
+			{
+				while (_source.next())
+					if (_predicate(_source.current()))
+						return true;
+				return false;
+			}
+
+			TElem current()
+			{
+				return _source.current();
+			}
+		};
+
+		template<typename TSource, typename TPredicate>
+		class _StaticWhereEnumerable : public StaticEnumerable<_StaticWhereEnumerable<TSource, TPredicate>>
+		{
+		private:
+			TSource _source;
+			TPredicate _predicate;
+		public:
+			typedef typename TSource::ElemType ElemType;
+			typedef _StaticWhereEnumerator<typename TSource::Enumerator, ElemType, TPredicate> Enumerator;
+
+			_StaticWhereEnumerable(const TSource& source, TPredicate predicate)
+				: _source(source), _predicate(predicate)
+			{}
+
+			Enumerator getEnumerator() const
+			{
+				return Enumerator(_source.getEnumerator(), _predicate);
+			}
+		};
+
 		template<typename TPredicate>
 		class _WhereBuilder
 		{
@@ -187,6 +321,18 @@ namespace xlinq
 			{
 				return std::shared_ptr<IBidirectionalEnumerable<TElem>>(new internal::_WhereBidirectionalEnumerable<TElem, TPredicate>(enumerable, _predicate));
 			}
+
+			template<typename TSource>
+			_StaticWhereEnumerable<TSource, TPredicate> build(const StaticEnumerable<TSource>& enumerable)
+			{
+				return _StaticWhereEnumerable<TSource, TPredicate>(enumerable.derived(), _predicate);
+			}
+
+			template<typename TQuery>
+			auto build(const ParallelEnumerable<TQuery>& enumerable) -> decltype(enumerable.derived().where(_predicate))
+			{
+				return enumerable.derived().where(_predicate);
+			}
 		};
 	}
 	/*@endcond*/
@@ -198,7 +344,9 @@ namespace xlinq
 	*	in looking for next element passing given criteria stops until next element
 	*	will be requested.
 	*	@param predicate Function used to filter elements of source collection.
-	*	It is common to use lambda expression as predicate.
+	*	It is common to use lambda expression as predicate. Predicates built from
+	*	field() are evaluated for whole blocks of batched elements, with vector
+	*	instructions where possible, and only selected elements are passed further.
 	*	@return Builder of where expression.
 	*/
 	template<typename TPredicate>
@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+#include "model/xlinq_test_model.h"
+#include <xlinq/xlinq_from.h>
+#include <xlinq/xlinq_aggregate_by.h>
+#include <xlinq/xlinq_parallel.h>
+#include <xlinq/xlinq_select.h>
+#include <xlinq/xlinq_to_container.h>
+#include <list>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace std;
+using namespace xlinq;
+
+TEST(XlinqAggregateByTest, SumsElementsByKey)
+{
+	list<int> numbers = { 5, 1, 2, 8, 3, 4, 7 };
+	auto result = from(numbers) >> aggregate_by([](int n) { return n % 3; }, 0, [](int acc, int n) { return acc + n; }) >> to_vector();
+	ASSERT_EQ(3, (int)result.size());
+	ASSERT_EQ(make_pair(2, 5 + 2 + 8), result[0]);
+	ASSERT_EQ(make_pair(1, 1 + 4 + 7), result[1]);
+	ASSERT_EQ(make_pair(0, 3), result[2]);
+}
+
+TEST(XlinqAggregateByTest, EmptyCollection)
+{
+	vector<int> numbers;
+	auto result = from(numbers) >> aggregate_by([](int n) { return n; }, 0, [](int acc, int) { return acc + 1; }) >> to_vector();
+	ASSERT_TRUE(result.empty());
+}
+
+TEST(XlinqAggregateByTest, AccumulatorOfOtherType)
+{
+	auto persons = getPersons();
+	auto result = from(persons)
+		>> aggregate_by([](const Person& person) { return person.age; }, string(), [](string acc, const Person& person) { return acc + person.firstName; })
+		>> to_vector();
+	ASSERT_FALSE(result.empty());
+	for (auto& entry : result)
+	{
+		string expected;
+		for (auto& person : persons)
+			if (person.age == entry.first)
+				expected += person.firstName;
+		ASSERT_EQ(expected, entry.second);
+	}
+}
+
+TEST(XlinqAggregateByTest, ParallelMatchesSequential)
+{
+	vector<int> numbers;
+	for (int i = 0; i < 7 * XLINQ_PARALLEL_CHUNK_SIZE + 3; ++i)
+		numbers.push_back((int)((long long)i * 104729 % 5003));
+	auto keySelector = [](int n) { return n % 97; };
+	auto aggregator = [](long long acc, int n) { return acc + n; };
+	auto combiner = [](long long lhs, long long rhs) { return lhs + rhs; };
+	auto expected = from(numbers) >> aggregate_by(keySelector, 0LL, aggregator, combiner) >> to_vector();
+	auto result = from(numbers) >> parallel() >> aggregate_by(keySelector, 0LL, aggregator, combiner) >> to_vector();
+	ASSERT_EQ(97, (int)expected.size());
+	ASSERT_EQ(expected, result);
+}
+
+TEST(XlinqAggregateByTest, ParallelAfterSelect)
+{
+	vector<int> numbers;
+	for (int i = 0; i < 2 * XLINQ_PARALLEL_CHUNK_SIZE; ++i)
+		numbers.push_back(i);
+	auto result = from(numbers)
+		>> parallel()
+		>> select([](int n) { return to_string(n % 4); })
+		>> aggregate_by([](const string& s) { return s; }, 0, [](int acc, const string&) { return acc + 1; }, [](int lhs, int rhs) { return lhs + rhs; })
+		>> to_vector();
+	ASSERT_EQ(4, (int)result.size());
+	for (int i = 0; i < 4; ++i)
+	{
+		ASSERT_EQ(to_string(i), result[i].first);
+		ASSERT_EQ(XLINQ_PARALLEL_CHUNK_SIZE / 2, result[i].second);
+	}
+}
\ No newline at end of file
@@ -65,4 +65,13 @@ TEST(XlinqAggregateResultTest, AggregateUsingDelegate)
 	int numbers[] = { 3, 7, -32, 0, -1, 3 };
 	auto result = (from(numbers) >> aggregate(0.1f, [](float first, int second) { return first + second * 0.1f; }));
 	ASSERT_TRUE(0.001f > (-1.9f - result));
-}
\ No newline at end of file
+}
+
+TEST(XlinqAggregateTest, AggregateOfManyBatches)
+{
+	list<int> numbers;
+	for (int i = 1; i <= 1000; ++i)
+		numbers.push_back(i);
+	ASSERT_EQ(1000, from(numbers) >> aggregate([](int first, int second) { return first > second ? first : second; }));
+	ASSERT_EQ(500500L, from(numbers) >> aggregate(0L, [](long acc, int elem) { return acc + elem; }));
+}
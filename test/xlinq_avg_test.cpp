@@ -1,8 +1,10 @@
 #include <gtest/gtest.h>
 #include <memory>
 #include <list>
+#include <vector>
 #include <xlinq/xlinq_from.h>
 #include <xlinq/xlinq_avg.h>
+#include <xlinq/xlinq_skip.h>
 
 using namespace std;
 using namespace xlinq;
@@ -234,4 +236,58 @@ TEST(XlinqAvgTest, IntAvgFromDouble)
 {
 	double numbers[] = { 3, 7, -32, 0, -1, 2 };
 	ASSERT_EQ(-3, from(numbers) >> avg<int>());
+}
+
+TEST(XlinqAvgTest, EmptyVectorThrowsException)
+{
+	auto numbers = vector<int>();
+	numbers.reserve(8);
+	try
+	{
+		from(numbers) >> avg();
+		FAIL();
+	}
+	catch (IterationFinishedException)
+	{
+	}
+}
+
+TEST(XlinqAvgTest, SkippedVectorUsesContiguousData)
+{
+	vector<int> numbers = { 100, 3, 7, -32, 0, -1, 2 };
+	ASSERT_EQ(-3.5, from(numbers) >> skip(1) >> avg());
+}
+
+TEST(XlinqAvgTest, AvgOfVectorTails)
+{
+	vector<int> numbers;
+	for (int i = 1; i <= 33; ++i)
+		numbers.push_back(i);
+	ASSERT_EQ(17, from(numbers) >> avg());
+	numbers.pop_back();
+	ASSERT_EQ(16.5, from(numbers) >> avg());
+	numbers.pop_back();
+	ASSERT_EQ(16, from(numbers) >> avg());
+}
+
+TEST(XlinqAvgTest, VectorAvgMatchesListAvg)
+{
+	vector<int> ints = { 2000000000, 2000000000, -7, 12, 5, 2000000000, 1, -3, 9 };
+	list<int> intList(ints.begin(), ints.end());
+	ASSERT_EQ(from(intList) >> avg(), from(ints) >> avg());
+
+	vector<float> floats = { 0.5f, -1.25f, 3.0f, 2.75f, -0.5f, 8.0f, 1.5f, 0.25f, -4.0f, 6.5f };
+	list<float> floatList(floats.begin(), floats.end());
+	ASSERT_EQ(1.675, from(floats) >> avg());
+	ASSERT_EQ(from(floatList) >> avg(), from(floats) >> avg());
+}
+
+TEST(XlinqAvgTest, AvgWithSumModes)
+{
+	vector<float> floats(1, 100000000.0f);
+	floats.insert(floats.end(), 100000, 1.0f);
+	list<float> listed(floats.begin(), floats.end());
+	ASSERT_EQ(100100000.0f / 100001.0f, from(floats) >> avg<float>().mode(SumMode::KAHAN));
+	ASSERT_EQ(100100000.0f / 100001.0f, from(listed) >> avg<float>().mode(SumMode::KAHAN));
+	ASSERT_EQ(100100000.0 / 100001.0, from(floats) >> avg().mode(SumMode::PAIRWISE));
 }
\ No newline at end of file
@@ -131,4 +131,21 @@ TEST(XLinqBaseTest, CloneAndEqualsEnumeratorTest)
 	ASSERT_EQ("Piotr", second->current().firstName);
 	ASSERT_TRUE(second->next());
 	ASSERT_EQ("Micha", second->current().firstName);
-}
\ No newline at end of file
+}
+
+TEST(XLinqBaseTest, DefaultNextBatchTest)
+{
+	shared_ptr<PersonEnumerable> enumerable(new PersonEnumerable());
+	shared_ptr<IEnumerator<Person>> enumerator = enumerable->getEnumerator();
+	vector<Person> buffer;
+	ASSERT_EQ(4, enumerator->next_batch(buffer, 4));
+	ASSERT_EQ(4, (int)buffer.size());
+	ASSERT_EQ("Piotr", buffer[0].firstName);
+	ASSERT_EQ("Joanna", buffer[3].firstName);
+	ASSERT_EQ("Joanna", enumerator->current().firstName);
+
+	ASSERT_EQ(2, enumerator->next_batch(buffer, 4));
+	ASSERT_EQ(6, (int)buffer.size());
+	ASSERT_EQ("Kamil", buffer[4].firstName);
+	ASSERT_EQ("Jan", buffer[5].firstName);
+}
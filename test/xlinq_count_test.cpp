@@ -2,6 +2,12 @@
 #include "model/xlinq_test_model.h"
 #include <xlinq/xlinq_from.h>
 #include <xlinq/xlinq_count.h>
+#include <xlinq/xlinq_concat.h>
+#include <xlinq/xlinq_enumerable.h>
+#include <xlinq/xlinq_select.h>
+#include <xlinq/xlinq_skip.h>
+#include <xlinq/xlinq_take.h>
+#include <xlinq/xlinq_to_container.h>
 #include <list>
 #include <forward_list>
 #include <vector>
@@ -25,4 +31,31 @@ TEST(XLinqCountTest, GetCountFromVector)
 {
 	vector<int> numbers = { 1, 2, 3, 4, 5 };
 	ASSERT_EQ(5, from(numbers) >> count());
+}
+
+TEST(XLinqCountTest, GetCountOfManyBatches)
+{
+	list<int> numbers(3 * XLINQ_BATCH_SIZE + 7, 1);
+	ASSERT_EQ(3 * XLINQ_BATCH_SIZE + 7, from(numbers) >> count());
+}
+
+TEST(XLinqCountTest, GetCountOfKnownSizeWithoutEnumeration)
+{
+	int selected = 0;
+	auto query = Enumerable::range(0, 1000)
+		>> select([&](int i) { ++selected; return i * 2; })
+		>> skip(10)
+		>> take(500);
+	ASSERT_EQ(500, query->known_size());
+	ASSERT_EQ(500, query >> count());
+	ASSERT_EQ(0, selected);
+
+	vector<int> numbers = { 1, 2, 3, 4, 5 };
+	ASSERT_EQ(105, Enumerable::repeat(7, 100) >> concat(numbers) >> count());
+	ASSERT_EQ(0, Enumerable::range(0, 10) >> skip(20) >> count());
+
+	auto doubled = query >> to_vector();
+	ASSERT_EQ(500u, doubled.size());
+	ASSERT_EQ(20, doubled[0]);
+	ASSERT_EQ(500, selected);
 }
\ No newline at end of file
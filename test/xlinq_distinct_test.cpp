@@ -402,4 +402,31 @@ TEST(XLinqDistinctByTest, DistinctByFullFromRandomAccessEnumerable)
 	ASSERT_TRUE(enumerator->next());
 	ASSERT_EQ(2, enumerator->current());
 	ASSERT_FALSE(enumerator->next());
+}
+
+TEST(XLinqDistinctTest, DistinctManyElementsKeepsFirstOccurrences)
+{
+	vector<long long> numbers;
+	for (int i = 0; i < 200000; ++i)
+		numbers.push_back(((long long)i * 7919) % 50021 * 1000003);
+	list<long long> listed(numbers.begin(), numbers.end());
+
+	vector<long long> expected;
+	vector<bool> seen(50021, false);
+	for (long long number : numbers)
+	{
+		if (!seen[number / 1000003])
+		{
+			seen[number / 1000003] = true;
+			expected.push_back(number);
+		}
+	}
+
+	vector<long long> fromVector, fromList;
+	for (auto enumerator = from(numbers) >> distinct() >> getEnumerator(); enumerator->next();)
+		fromVector.push_back(enumerator->current());
+	for (auto enumerator = from(listed) >> distinct() >> getEnumerator(); enumerator->next();)
+		fromList.push_back(enumerator->current());
+	ASSERT_EQ(expected, fromVector);
+	ASSERT_EQ(expected, fromList);
 }
\ No newline at end of file
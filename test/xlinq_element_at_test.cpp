@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 #include <xlinq/xlinq_element_at.h>
 #include <xlinq/xlinq_from.h>
+#include <xlinq/xlinq_enumerable.h>
+#include <xlinq/xlinq_select.h>
 #include <forward_list>
 #include <list>
 #include <vector>
@@ -126,4 +128,14 @@ TEST(XLinqElementAtOrDefaultTest, ElementAtOrDefaultEmptyRandomAccessEnumerable)
 	vector<int> numbers;
 	ASSERT_EQ(0, from(numbers) >> element_at_or_default(0, 0));
 	ASSERT_EQ(0, from(numbers) >> element_at_or_default(-1, 0));
+}
+
+TEST(XLinqElementAtTest, ElementAtBeyondKnownSizeDoesNotEnumerate)
+{
+	int selected = 0;
+	auto query = Enumerable::range(0, 100) >> select([&](int i) { ++selected; return i; });
+	ASSERT_THROW(query >> element_at(100), IterationFinishedException);
+	ASSERT_EQ(-1, query >> element_at_or_default(150, -1));
+	ASSERT_EQ(0, selected);
+	ASSERT_EQ(42, query >> element_at(42));
 }
\ No newline at end of file
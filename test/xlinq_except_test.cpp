@@ -134,4 +134,30 @@ TEST(XLinqExceptTest, EnumerableFull_CloneAndEqualsEnumeratorTest)
 	ASSERT_EQ(2, second->current());
 	ASSERT_TRUE(second->next());
 	ASSERT_EQ(4, second->current());
+}
+
+TEST(XLinqExceptTest, EnumeratorsShareSetAndKeepOwnState)
+{
+	forward_list<int> numbers = { 1, 1, 2, 2, 2, 3, 4, 4, 5 };
+	vector<int> toskip = { 1, 3 };
+	auto enumerable = from(numbers) >> except(toskip);
+	auto first = enumerable >> getEnumerator();
+	ASSERT_TRUE(first->next());
+	ASSERT_EQ(2, first->current());
+
+	auto second = enumerable >> getEnumerator();
+	vector<int> result;
+	while (second->next())
+		result.push_back(second->current());
+	ASSERT_EQ(vector<int>({ 2, 4, 5 }), result);
+
+	auto clone = first->clone();
+	result.clear();
+	while (first->next())
+		result.push_back(first->current());
+	ASSERT_EQ(vector<int>({ 4, 5 }), result);
+	result.clear();
+	while (clone->next())
+		result.push_back(clone->current());
+	ASSERT_EQ(vector<int>({ 4, 5 }), result);
 }
\ No newline at end of file
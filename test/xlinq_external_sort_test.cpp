@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+#include <xlinq/xlinq_external_sort.h>
+#include <xlinq/xlinq_from.h>
+#include <xlinq/xlinq_select.h>
+#include <xlinq/xlinq_to_container.h>
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace std;
+using namespace xlinq;
+
+TEST(XLinqExternalSortTest, ExternalSortMergesSpilledRuns)
+{
+	vector<int> numbers;
+	for (int i = 0; i < 1000; ++i)
+		numbers.push_back((i * 7919) % 1009 - 500);
+	vector<int> expected = numbers;
+	sort(expected.begin(), expected.end());
+
+	ASSERT_EQ(expected, from(numbers) >> external_sort(64) >> to_vector());
+	ASSERT_EQ(expected, from(numbers) >> external_sort(5000) >> to_vector());
+	reverse(expected.begin(), expected.end());
+	ASSERT_EQ(expected, from(numbers) >> external_sort(100, [](int a, int b) { return a > b; }) >> to_vector());
+
+	vector<int> empty;
+	ASSERT_EQ(empty, from(empty) >> external_sort(16) >> to_vector());
+}
+
+TEST(XLinqExternalSortTest, ExternalSortKeepsStableOrder)
+{
+	vector<pair<int, int>> items;
+	for (int i = 0; i < 500; ++i)
+		items.push_back(make_pair(i % 7, i));
+	vector<pair<int, int>> expected = items;
+	auto byFirst = [](const pair<int, int>& a, const pair<int, int>& b) { return a.first < b.first; };
+	stable_sort(expected.begin(), expected.end(), byFirst);
+
+	auto sorted = from(items) >> external_sort(33, byFirst);
+	ASSERT_EQ(expected, sorted >> to_vector());
+
+	auto enumerator = sorted->getEnumerator();
+	ASSERT_TRUE(enumerator->next());
+	ASSERT_TRUE(enumerator->next());
+	auto copy = enumerator->clone();
+	ASSERT_EQ(expected[1], copy->current());
+	ASSERT_TRUE(enumerator->next());
+	ASSERT_TRUE(copy->next());
+	ASSERT_EQ(expected[2], enumerator->current());
+	ASSERT_EQ(expected[2], copy->current());
+	ASSERT_TRUE(enumerator->equals(copy));
+}
+
+TEST(XLinqExternalSortTest, ExternalSortMergesRunsInPasses)
+{
+	vector<pair<int, int>> items;
+	for (int i = 0; i < 4 * (XLINQ_EXTERNAL_SORT_MERGE_WAYS * XLINQ_EXTERNAL_SORT_MERGE_WAYS + 100); ++i)
+		items.push_back(make_pair((i * 7919) % 13, i));
+	vector<pair<int, int>> expected = items;
+	auto byFirst = [](const pair<int, int>& a, const pair<int, int>& b) { return a.first < b.first; };
+	stable_sort(expected.begin(), expected.end(), byFirst);
+
+	ASSERT_EQ(expected, from(items) >> external_sort(4, byFirst) >> to_vector());
+}
+
+TEST(XLinqExternalSortTest, ExternalSortReadsSourceOnce)
+{
+	vector<int> numbers;
+	for (int i = 0; i < 1000; ++i)
+		numbers.push_back((i * 7919) % 1009);
+	vector<int> expected = numbers;
+	sort(expected.begin(), expected.end());
+
+	int reads = 0;
+	auto counted = from(numbers) >> select([&reads](int i) { ++reads; return i; });
+	auto spilled = counted >> external_sort(64);
+	ASSERT_EQ(expected, spilled >> to_vector());
+	ASSERT_EQ(expected, spilled >> to_vector());
+	ASSERT_EQ(1000, reads);
+
+	auto inMemory = counted >> external_sort(5000);
+	ASSERT_EQ(expected, inMemory >> to_vector());
+	ASSERT_EQ(expected, inMemory >> to_vector());
+	ASSERT_EQ(2000, reads);
+}
+
+class StringSerializer
+{
+public:
+	void write(FILE* file, const string& elem) const
+	{
+		size_t size = elem.size();
+		fwrite(&size, sizeof(size), 1, file);
+		fwrite(elem.data(), 1, size, file);
+	}
+
+	bool read(FILE* file, string& elem) const
+	{
+		size_t size;
+		if (fread(&size, sizeof(size), 1, file) != 1)
+			return false;
+		elem.resize(size);
+		return size == 0 || fread(&elem[0], 1, size, file) == size;
+	}
+};
+
+TEST(XLinqExternalSortTest, ExternalSortWithSerializer)
+{
+	vector<string> words;
+	for (int i = 0; i < 300; ++i)
+		words.push_back(string((i * 31) % 17, (char)('a' + (i * 13) % 26)));
+	vector<string> expected = words;
+	sort(expected.begin(), expected.end());
+
+	ASSERT_EQ(expected, from(words) >> external_sort(20, less<string>(), StringSerializer()) >> to_vector());
+}
\ No newline at end of file
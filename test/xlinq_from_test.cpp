@@ -6,6 +6,8 @@
 #include <memory>
 #include <vector>
 #include <array>
+#include <forward_list>
+#include <deque>
 #include <iterator>
 
 using namespace std;
@@ -809,4 +811,85 @@ TEST(XLinqFromTest, XlinqFromVectorRandomAccessEnumerator)
 	ASSERT_FALSE(enumerator->advance(-10));
 	ASSERT_TRUE(enumerator->advance(1));
 	ASSERT_EQ(1, enumerator->current());
-}
\ No newline at end of file
+}
+
+TEST(XLinqFromTest, XLinqArrayEnumeratorNextBatch)
+{
+	int numbers[] = { 1, 2, 3, 4, 5 };
+	auto enumerator = from(numbers) >> getEnumerator();
+	vector<int> buffer;
+
+	ASSERT_TRUE(enumerator->next());
+	ASSERT_EQ(3, enumerator->next_batch(buffer, 3));
+	ASSERT_EQ(vector<int>({ 2, 3, 4 }), buffer);
+	ASSERT_EQ(4, enumerator->current());
+	ASSERT_EQ(1, enumerator->next_batch(buffer, 3));
+	ASSERT_EQ(vector<int>({ 2, 3, 4, 5 }), buffer);
+	ASSERT_TRUE(enumerator->back());
+	ASSERT_EQ(5, enumerator->current());
+}
+
+TEST(XLinqFromTest, XLinqStlEnumeratorNextBatch)
+{
+	forward_list<int> numbers = { 1, 2, 3, 4, 5 };
+	auto enumerator = from(numbers) >> getEnumerator();
+	vector<int> buffer;
+
+	ASSERT_EQ(2, enumerator->next_batch(buffer, 2));
+	ASSERT_EQ(2, enumerator->current());
+	ASSERT_TRUE(enumerator->next());
+	ASSERT_EQ(3, enumerator->current());
+	ASSERT_EQ(2, enumerator->next_batch(buffer, 5));
+	ASSERT_EQ(vector<int>({ 1, 2, 4, 5 }), buffer);
+	try
+	{
+		enumerator->next();
+		FAIL();
+	}
+	catch (IterationFinishedException)
+	{
+	}
+}
+
+TEST(XLinqFromTest, XLinqStlRandomAccessEnumeratorNextBatch)
+{
+	vector<int> numbers = { 1, 2, 3, 4, 5 };
+	auto enumerator = from(numbers) >> getEnumerator();
+	vector<int> buffer;
+
+	ASSERT_EQ(5, enumerator->next_batch(buffer, 5));
+	ASSERT_EQ(numbers, buffer);
+	ASSERT_EQ(5, enumerator->current());
+	ASSERT_FALSE(enumerator->next());
+	ASSERT_TRUE(enumerator->back());
+	ASSERT_EQ(5, enumerator->current());
+}
+
+TEST(XLinqFromTest, XLinqContiguousDataFromArrayAndVector)
+{
+	int numbers[] = { 1, 2, 3, 4, 5 };
+	auto arrayEnumerable = from(numbers);
+	ASSERT_EQ(numbers, arrayEnumerable->data());
+	ASSERT_EQ(5, arrayEnumerable->size());
+
+	vector<int> vec = { 1, 2, 3 };
+	ASSERT_EQ(vec.data(), from(vec)->data());
+
+	auto vecPtr = make_shared<vector<int>>(vec);
+	ASSERT_EQ(vecPtr->data(), from(vecPtr)->data());
+
+	array<int, 3> arr = { { 1, 2, 3 } };
+	ASSERT_EQ(arr.data(), from(arr)->data());
+
+	int multidim[2][3] = { { 1, 2, 3 }, { 4, 5, 6 } };
+	ASSERT_EQ(&multidim[0][0], from_array(multidim)->data());
+}
+
+TEST(XLinqFromTest, XLinqContiguousDataNotAvailable)
+{
+	deque<int> numbers = { 1, 2, 3 };
+	ASSERT_EQ(nullptr, from(numbers)->data());
+
+	vector<bool> flags = { true, false };
+	ASSERT_EQ(nullptr, from(flags)->data());
+}
@@ -4,6 +4,13 @@
 #include <xlinq/xlinq_group_by.h>
 #include <xlinq/xlinq_first.h>
 #include <xlinq/xlinq_count.h>
+#include <xlinq/xlinq_parallel.h>
+#include <xlinq/xlinq_stl.h>
+#include <xlinq/xlinq_sum.h>
+#include <xlinq/xlinq_to_container.h>
+#include <algorithm>
+#include <list>
+#include <map>
 #include <memory>
 #include <vector>
 #include <utility>
@@ -188,4 +195,143 @@ TEST(XlinqGroupByResultTest, TestGroupingOwnHasherAndEqComp)
 	ASSERT_EQ(1, grouping.first);
 	ASSERT_EQ(3, grouping.second);
 	ASSERT_FALSE(enumerator->next());
+}
+
+TEST(XlinqGroupByTest, ParallelGroupingKeepsOrder)
+{
+	vector<int> numbers;
+	for (int i = 0; i < 5 * XLINQ_PARALLEL_CHUNK_SIZE; ++i)
+		numbers.push_back((i * 7919) % 1000);
+	auto groups = from(numbers) >> parallel() >> where([](int n) { return n % 3 != 0; }) >> group_by([](int n) { return n % 10; });
+	auto expected = from(numbers) >> where([](int n) { return n % 3 != 0; }) >> group_by([](int n) { return n % 10; }) >> to_vector();
+	ASSERT_EQ((int)expected.size(), groups >> count());
+	auto enumerator = groups >> getEnumerator();
+	for (auto& expectedGroup : expected)
+	{
+		ASSERT_TRUE(enumerator->next());
+		auto group = enumerator->current();
+		ASSERT_EQ(expectedGroup->getKey(), group->getKey());
+		ASSERT_EQ(expectedGroup >> to_vector(), group >> to_vector());
+	}
+	ASSERT_FALSE(enumerator->next());
+}
+
+TEST(XlinqGroupByTest, ParallelGroupingWithSelector)
+{
+	vector<int> numbers;
+	for (int i = 0; i < 3 * XLINQ_PARALLEL_CHUNK_SIZE; ++i)
+		numbers.push_back(i);
+	auto sums = from(numbers)
+		>> parallel()
+		>> group_by([](int n) { return n % 3; }, [](shared_ptr<IGrouping<int, int>> group)
+		{
+			return make_pair(group->getKey(), group >> select([](int n) { return (long long)n; }) >> sum());
+		})
+		>> to_vector();
+	ASSERT_EQ(3, (int)sums.size());
+	for (int key = 0; key < 3; ++key)
+	{
+		long long expected = 0;
+		for (int i = key; i < (int)numbers.size(); i += 3)
+			expected += i;
+		ASSERT_EQ(key, sums[key].first);
+		ASSERT_EQ(expected, sums[key].second);
+	}
+}
+
+TEST(XlinqGroupByTest, FlatGroupingManyKeys)
+{
+	vector<int> numbers;
+	for (int i = 0; i < 1000; ++i)
+		numbers.push_back((i * 31) % 1000);
+	vector<int> keys;
+	for (int n : numbers)
+		if (find(keys.begin(), keys.end(), n % 97) == keys.end())
+			keys.push_back(n % 97);
+	auto groups = from(numbers) >> group_by([](int n) { return n % 97; }) >> to_vector();
+	ASSERT_EQ(97, (int)groups.size());
+	for (int i = 0; i < 97; ++i)
+	{
+		int key = keys[i];
+		ASSERT_EQ(key, groups[i]->getKey());
+		vector<int> expected;
+		for (int n : numbers)
+			if (n % 97 == key)
+				expected.push_back(n);
+		ASSERT_EQ(expected, groups[i] >> to_vector());
+	}
+}
+
+TEST(XlinqGroupByTest, FlatGroupingKeysSharingLowBits)
+{
+	vector<long long> numbers;
+	for (long long i = 0; i < 40000; ++i)
+		numbers.push_back((i % 20000) << 20);
+	auto groups = from(numbers) >> group_by([](long long n) { return n; }) >> to_vector();
+	ASSERT_EQ(20000, (int)groups.size());
+	for (int i = 0; i < 20000; ++i)
+	{
+		ASSERT_EQ((long long)i << 20, groups[i]->getKey());
+		ASSERT_EQ(2, groups[i] >> count());
+	}
+}
+
+TEST(XlinqGroupByTest, LazyGroupingOfListSource)
+{
+	list<int> numbers = { 1, 2, 3, 4, 5, 6 };
+	auto enumerator = from(numbers) >> group_by([](int num) { return num % 2 + 1; }) >> getEnumerator();
+	ASSERT_TRUE(enumerator->next());
+	auto grouping = enumerator->current();
+	ASSERT_EQ(2, grouping->getKey());
+	ASSERT_EQ(vector<int>({ 1, 3, 5 }), grouping >> to_vector());
+	ASSERT_TRUE(enumerator->next());
+	grouping = enumerator->current();
+	ASSERT_EQ(1, grouping->getKey());
+	ASSERT_EQ(vector<int>({ 2, 4, 6 }), grouping >> to_vector());
+	ASSERT_FALSE(enumerator->next());
+}
+
+TEST(XlinqGroupByTest, SpilledGroupingMatchesInMemoryGrouping)
+{
+	vector<pair<int, int>> items;
+	for (int i = 0; i < 2000; ++i)
+		items.push_back(make_pair((i * 7919) % 331, i));
+	auto key = [](const pair<int, int>& item) { return item.first; };
+
+	map<int, vector<pair<int, int>>> expected;
+	for (auto& item : items)
+		expected[item.first].push_back(item);
+
+	for (int budget : { 5000, 100, 1 })
+	{
+		map<int, vector<pair<int, int>>> grouped;
+		for (auto group : from(items) >> group_by(key).spill(budget) >> stl())
+			grouped[group->getKey()] = group >> to_vector();
+		ASSERT_EQ(expected, grouped);
+	}
+
+	map<int, int> sizes;
+	for (auto& entry : expected)
+		sizes[entry.first] = (int)entry.second.size();
+	auto counted = from(items) >> group_by(key, [](shared_ptr<IGrouping<int, pair<int, int>>> group) { return make_pair(group->getKey(), group >> count()); },
+		hash<int>(), equal_to<int>()).spill(64) >> to_vector();
+	map<int, int> countedSizes(counted.begin(), counted.end());
+	ASSERT_EQ(sizes, countedSizes);
+}
+
+TEST(XlinqGroupByTest, SpilledGroupingOfManyKeys)
+{
+	vector<int> numbers;
+	for (int i = 0; i < 200000; ++i)
+		numbers.push_back((i * 7919) % 100000);
+	int groups = 0;
+	long long sum = 0;
+	for (auto group : from(numbers) >> group_by([](int n) { return n; }).spill(1000) >> stl())
+	{
+		ASSERT_EQ(2, group >> count());
+		sum += group->getKey();
+		++groups;
+	}
+	ASSERT_EQ(100000, groups);
+	ASSERT_EQ(100000LL * 99999 / 2, sum);
 }
\ No newline at end of file
@@ -1,7 +1,12 @@
 #include <gtest/gtest.h>
 #include "model/xlinq_test_model.h"
+#include <xlinq/xlinq_all.h>
+#include <xlinq/xlinq_count.h>
 #include <xlinq/xlinq_from.h>
 #include <xlinq/xlinq_join.h>
+#include <xlinq/xlinq_select.h>
+#include <xlinq/xlinq_to_container.h>
+#include <algorithm>
 #include <memory>
 #include <vector>
 #include <utility>
@@ -139,4 +144,124 @@ TEST(XlinqJoinFullTest, TestJoin)
 	ASSERT_TRUE(enumerator->next());
 	ASSERT_EQ("5fffff", enumerator->current());
 	ASSERT_FALSE(enumerator->next());
+}
+
+TEST(XlinqJoinTest, JoinManyKeys)
+{
+	vector<int> numbers;
+	for (int i = 0; i < 200; ++i)
+		numbers.push_back(i % 50);
+	vector<int> others;
+	for (int i = 0; i < 300; ++i)
+		others.push_back(i % 75);
+	auto enumerator = from(numbers) >> join(others,
+		[](int i) { return i; },
+		[](int i) { return i + 25; },
+		[](int i, int o) { return make_pair(i, o); }) >> getEnumerator();
+	int count = 0;
+	while (enumerator->next())
+	{
+		auto current = enumerator->current();
+		ASSERT_EQ(current.first, current.second + 25);
+		++count;
+	}
+	ASSERT_EQ(25 * 4 * 4, count);
+}
+
+TEST(XlinqJoinTest, JoinFollowsProbingCollection)
+{
+	vector<int> small = { 1, 2, 1, 2 };
+	vector<int> large = { 2, 1, 2, 1, 3, 2 };
+	auto identity = [](int i) { return i; };
+	auto pair = [](int i, int o) { return make_pair(i, o); };
+
+	vector<std::pair<int, int>> expected;
+	for (int o : large)
+		for (int i : small)
+			if (i == o)
+				expected.push_back(make_pair(i, o));
+	ASSERT_EQ(expected, from(small) >> join(large, identity, identity, pair) >> to_vector());
+
+	expected.clear();
+	for (int i : large)
+		for (int o : small)
+			if (i == o)
+				expected.push_back(make_pair(i, o));
+	ASSERT_EQ(expected, from(large) >> join(small, identity, identity, pair) >> to_vector());
+}
+
+TEST(XlinqJoinTest, JoinStreamsOuterCollectionWhenBuiltOnInner)
+{
+	vector<int> dimension = { 3, 7 };
+	vector<int> facts;
+	for (int i = 0; i < 100000; ++i)
+		facts.push_back(i % 10);
+	int reads = 0;
+	auto counted = from(facts) >> select([&reads](int f) { ++reads; return f; });
+	auto enumerator = from(dimension) >> join(counted,
+		[](int d) { return d; },
+		[](int f) { return f; },
+		[](int d, int f) { return d * 100 + f; }) >> getEnumerator();
+
+	ASSERT_TRUE(enumerator->next());
+	ASSERT_EQ(303, enumerator->current());
+	ASSERT_TRUE(enumerator->next());
+	ASSERT_EQ(707, enumerator->current());
+	ASSERT_LT(reads, 100);
+}
+
+TEST(XlinqJoinTest, JoinKeysSharingLowBits)
+{
+	vector<long long> inner, outer;
+	for (long long i = 0; i < 40000; ++i)
+	{
+		inner.push_back(i << 20);
+		outer.push_back((39999 - i) << 20);
+	}
+	auto identity = [](long long key) { return key; };
+	auto joined = from(inner) >> join(outer, identity, identity, [](long long i, long long o) { return i - o; });
+	ASSERT_EQ(40000, joined >> count());
+	ASSERT_TRUE(joined >> all([](long long difference) { return difference == 0; }));
+}
+
+TEST(XlinqJoinTest, JoinPartitionedStrategy)
+{
+	vector<int> facts;
+	for (int i = 0; i < 20000; ++i)
+		facts.push_back((i * 7919) % 3001);
+	vector<int> dimension;
+	for (int i = 0; i < 5000; ++i)
+		dimension.push_back(i % 2500);
+	auto joinFacts = join(facts,
+		[](int d) { return d; },
+		[](int f) { return f; },
+		[](int d, int f) { return make_pair(d, f); });
+
+	auto expected = from(dimension) >> joinFacts >> to_vector();
+	auto result = from(dimension) >> joinFacts.strategy(JoinStrategy::PARTITIONED) >> to_vector();
+	sort(expected.begin(), expected.end());
+	sort(result.begin(), result.end());
+	ASSERT_FALSE(expected.empty());
+	ASSERT_EQ(expected, result);
+
+	auto reversed = from(facts) >> join(dimension,
+		[](int f) { return f; },
+		[](int d) { return d; },
+		[](int f, int d) { return make_pair(d, f); }).strategy(JoinStrategy::PARTITIONED) >> to_vector();
+	sort(reversed.begin(), reversed.end());
+	ASSERT_EQ(expected, reversed);
+}
+
+TEST(XlinqJoinTest, JoinPartitionedKeysSharingLowBits)
+{
+	vector<long long> inner, outer;
+	for (long long i = 0; i < 40000; ++i)
+	{
+		inner.push_back(i << 20);
+		outer.push_back((39999 - i) << 20);
+	}
+	auto identity = [](long long key) { return key; };
+	auto joined = from(inner) >> join(outer, identity, identity, [](long long i, long long o) { return i == o; }).strategy(JoinStrategy::PARTITIONED);
+	ASSERT_EQ(40000, joined >> count());
+	ASSERT_TRUE(joined >> all([](bool equal) { return equal; }));
 }
\ No newline at end of file
@@ -1,8 +1,10 @@
 #include <gtest/gtest.h>
 #include <memory>
 #include <list>
+#include <vector>
 #include <xlinq/xlinq_from.h>
 #include <xlinq/xlinq_max.h>
+#include <xlinq/xlinq_skip.h>
 
 using namespace std;
 using namespace xlinq;
@@ -90,4 +92,53 @@ TEST(XlinqMaxTest, MaximumFromDouble)
 {
 	double numbers[] = { 3, 7, -32, 0, -1, 2 };
 	ASSERT_EQ(7, from(numbers) >> max());
+}
+
+TEST(XlinqMaxTest, EmptyVectorThrowsException)
+{
+	auto numbers = vector<int>();
+	numbers.reserve(8);
+	try
+	{
+		from(numbers) >> max();
+		FAIL();
+	}
+	catch (IterationFinishedException)
+	{
+	}
+}
+
+TEST(XlinqMaxTest, SkippedVectorUsesContiguousData)
+{
+	vector<int> numbers = { 100, 3, 7, -32, 0, -1, 2 };
+	ASSERT_EQ(7, from(numbers) >> skip(1) >> max());
+}
+
+TEST(XlinqMaxTest, MaxInLastLane)
+{
+	vector<int> numbers(32, -5);
+	numbers[7] = 1;
+	ASSERT_EQ(1, from(numbers) >> max());
+	numbers[31] = 2;
+	ASSERT_EQ(2, from(numbers) >> max());
+	numbers.push_back(3);
+	ASSERT_EQ(3, from(numbers) >> max());
+
+	vector<double> doubles(16, -2.5);
+	doubles[3] = 0.5;
+	ASSERT_EQ(0.5, from(doubles) >> max());
+	doubles[15] = 1.5;
+	ASSERT_EQ(1.5, from(doubles) >> max());
+}
+
+TEST(XlinqMaxTest, VectorMaxMatchesListMax)
+{
+	vector<long long> longs = { -30000000000LL, -3, 7, 20000000000LL, 5, -1, 8, 2, 9 };
+	list<long long> longList(longs.begin(), longs.end());
+	ASSERT_EQ(20000000000LL, from(longs) >> max());
+	ASSERT_EQ(from(longList) >> max(), from(longs) >> max());
+
+	vector<float> floats = { 0.5f, -1.25f, 3.0f, 2.75f, -0.5f, 8.0f, 1.5f, 0.25f, -4.0f, 6.5f, 0.75f };
+	list<float> floatList(floats.begin(), floats.end());
+	ASSERT_EQ(from(floatList) >> max(), from(floats) >> max());
 }
\ No newline at end of file
@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+#include <xlinq/xlinq_from.h>
+#include <xlinq/xlinq_merge_join.h>
+#include <xlinq/xlinq_to_container.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include <utility>
+
+using namespace std;
+using namespace xlinq;
+
+TEST(XlinqMergeJoinTest, MergeJoinPairsEqualKeys)
+{
+	vector<int> numbers = { 1, 2, 2, 4, 5, 7 };
+	vector<string> strings = { "a", "bb", "zz", "ccc", "eeeee", "fffff", "gggggg" };
+	auto result = from(numbers) >> merge_join(strings,
+		[](int i) { return i; },
+		[](const string& s) { return (int)s.size(); },
+		[](int i, const string& s) { return to_string(i) + s; }) >> to_vector();
+	ASSERT_EQ(vector<string>({ "1a", "2bb", "2zz", "2bb", "2zz", "5eeeee", "5fffff" }), result);
+
+	vector<int> empty;
+	ASSERT_TRUE((from(empty) >> merge_join(strings,
+		[](int i) { return i; },
+		[](const string& s) { return (int)s.size(); },
+		[](int i, const string& s) { return to_string(i) + s; }) >> to_vector()).empty());
+}
+
+TEST(XlinqMergeJoinTest, OuterMergeJoinKeepsUnmatchedElements)
+{
+	vector<int> numbers = { 1, 2, 2, 4, 7 };
+	vector<string> strings = { "a", "bb", "ccc", "ddddd", "gggggggg" };
+	auto describe = [](const int* i, const string* s) { return (i ? to_string(*i) : string("-")) + (s ? *s : string("-")); };
+
+	auto left = from(numbers) >> left_merge_join(strings,
+		[](int i) { return i; },
+		[](const string& s) { return (int)s.size(); },
+		describe) >> to_vector();
+	ASSERT_EQ(vector<string>({ "1a", "2bb", "2bb", "4-", "7-" }), left);
+
+	auto full = from(numbers) >> full_merge_join(strings,
+		[](int i) { return i; },
+		[](const string& s) { return (int)s.size(); },
+		describe) >> to_vector();
+	ASSERT_EQ(vector<string>({ "1a", "2bb", "2bb", "-ccc", "4-", "-ddddd", "7-", "-gggggggg" }), full);
+
+	vector<int> first = { 7, 4, 2 };
+	vector<int> second = { 5, 4, 1 };
+	auto descending = from(first) >> full_merge_join(second,
+		[](int i) { return i; },
+		[](int o) { return o; },
+		[](const int* i, const int* o) { return make_pair(i ? *i : 0, o ? *o : 0); },
+		[](int first, int second) { return first > second; }) >> to_vector();
+	vector<pair<int, int>> expected = { make_pair(7, 0), make_pair(0, 5), make_pair(4, 4), make_pair(2, 0), make_pair(0, 1) };
+	ASSERT_EQ(expected, descending);
+}
+
+TEST(XlinqMergeJoinTest, CloneAndEqualsEnumeratorTest)
+{
+	vector<int> numbers = { 1, 1, 3 };
+	vector<int> others = { 1, 1, 2, 3 };
+	auto enumerator = from(numbers) >> merge_join(others,
+		[](int i) { return i; },
+		[](int o) { return o; },
+		[](int i, int o) { return i * 10 + o; }) >> getEnumerator();
+	ASSERT_TRUE(enumerator->next());
+	auto second = enumerator->clone();
+	ASSERT_TRUE(enumerator->equals(second));
+	ASSERT_TRUE(enumerator->next());
+	ASSERT_FALSE(enumerator->equals(second));
+	ASSERT_TRUE(second->next());
+	ASSERT_TRUE(enumerator->equals(second));
+	for (int i = 0; i < 2; ++i)
+	{
+		ASSERT_TRUE(enumerator->next());
+		ASSERT_EQ(11, enumerator->current());
+	}
+	ASSERT_TRUE(enumerator->next());
+	ASSERT_EQ(33, enumerator->current());
+	ASSERT_FALSE(enumerator->next());
+	ASSERT_EQ(11, second->current());
+}
\ No newline at end of file
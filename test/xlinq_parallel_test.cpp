@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+#include <xlinq/xlinq_from.h>
+#include <xlinq/xlinq_parallel.h>
+#include <xlinq/xlinq_where.h>
+#include <xlinq/xlinq_select.h>
+#include <xlinq/xlinq_sum.h>
+#include <xlinq/xlinq_count.h>
+#include <xlinq/xlinq_min.h>
+#include <xlinq/xlinq_max.h>
+#include <xlinq/xlinq_aggregate.h>
+#include <xlinq/xlinq_any.h>
+#include <xlinq/xlinq_all.h>
+#include <xlinq/xlinq_to_container.h>
+#include <xlinq/xlinq_gather.h>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <list>
+
+using namespace std;
+using namespace xlinq;
+
+static vector<int> getNumbers()
+{
+	vector<int> numbers;
+	for (int i = 0; i < 10 * XLINQ_PARALLEL_CHUNK_SIZE + 17; ++i)
+		numbers.push_back(i);
+	return numbers;
+}
+
+TEST(XLinqParallelTest, WhereSelectSum)
+{
+	auto numbers = getNumbers();
+	long long expected = 0;
+	for (auto n : numbers)
+		if (n % 3 == 0)
+			expected += 2 * (long long)n;
+	long long result = from(numbers)
+		>> parallel()
+		>> where([](int n) { return n % 3 == 0; })
+		>> select([](int n) { return 2 * (long long)n; })
+		>> sum();
+	ASSERT_EQ(expected, result);
+}
+
+TEST(XLinqParallelTest, CountMinMax)
+{
+	auto numbers = getNumbers();
+	int size = (int)numbers.size();
+	ASSERT_EQ(size, from(numbers) >> parallel() >> count());
+	ASSERT_EQ(size / 2, from(numbers) >> parallel() >> where([](int n) { return n % 2 == 1; }) >> count());
+	numbers[size / 2] = -5;
+	numbers[size / 3] = 1000000;
+	ASSERT_EQ(-5, from(numbers) >> parallel() >> min());
+	ASSERT_EQ(1000000, from(numbers) >> parallel() >> max());
+}
+
+TEST(XLinqParallelTest, EmptyResultThrowsException)
+{
+	auto numbers = getNumbers();
+	auto query = from(numbers) >> parallel() >> where([](int n) { return n < 0; });
+	ASSERT_EQ(0, query >> count());
+	ASSERT_THROW(query >> sum(), IterationFinishedException);
+	ASSERT_THROW(query >> min(), IterationFinishedException);
+}
+
+TEST(XLinqParallelTest, AggregateKeepsOrder)
+{
+	auto numbers = getNumbers();
+	auto query = from(numbers) >> parallel() >> where([](int n) { return n % 1000 == 0; });
+	string expected;
+	for (auto n : numbers)
+		if (n % 1000 == 0)
+			expected += to_string(n) + ";";
+	string result = query >> aggregate(string(), [](string acc, int n) { return acc + to_string(n) + ";"; }, [](string lhs, string rhs) { return lhs + rhs; });
+	ASSERT_EQ(expected, result);
+	ASSERT_EQ(expected, from(numbers) >> where([](int n) { return n % 1000 == 0; })
+		>> aggregate(string(), [](string acc, int n) { return acc + to_string(n) + ";"; }, [](string lhs, string rhs) { return lhs + rhs; }));
+	ASSERT_EQ(numbers.back(), from(numbers) >> parallel() >> aggregate([](int lhs, int rhs) { return lhs > rhs ? lhs : rhs; }));
+}
+
+TEST(XLinqParallelTest, AnyAndAll)
+{
+	auto numbers = getNumbers();
+	ASSERT_TRUE(from(numbers) >> parallel() >> any());
+	ASSERT_TRUE(from(numbers) >> parallel() >> any([](int n) { return n == 12345; }));
+	ASSERT_FALSE(from(numbers) >> parallel() >> any([](int n) { return n < 0; }));
+	ASSERT_TRUE(from(numbers) >> parallel() >> all([](int n) { return n >= 0; }));
+	ASSERT_FALSE(from(numbers) >> parallel() >> all([](int n) { return n != 7; }));
+	vector<int> empty;
+	ASSERT_FALSE(from(empty) >> parallel() >> any());
+	ASSERT_TRUE(from(empty) >> parallel() >> all([](int) { return false; }));
+}
+
+TEST(XLinqParallelTest, ToVectorKeepsOrder)
+{
+	auto numbers = getNumbers();
+	vector<int> result = from(numbers)
+		>> parallel()
+		>> where([](int n) { return n % 2 == 0; })
+		>> select([](int n) { return n / 2; })
+		>> to_vector();
+	ASSERT_EQ((numbers.size() + 1) / 2, result.size());
+	for (int i = 0; i < (int)result.size(); ++i)
+		ASSERT_EQ(i, result[i]);
+}
+
+TEST(XLinqParallelTest, NonContiguousSource)
+{
+	auto numbers = getNumbers();
+	auto gathered = from(numbers) >> select([](int n) { return n + 1; }) >> gather();
+	long long expected = 0;
+	for (auto n : numbers)
+		expected += n + 1;
+	ASSERT_EQ(expected, gathered >> parallel() >> select([](int n) { return (long long)n; }) >> sum());
+	ASSERT_EQ((int)numbers.size(), from(numbers) >> select([](int n) { return n; }) >> parallel() >> count());
+}
+
+TEST(XLinqParallelTest, ExceptionIsPropagated)
+{
+	auto numbers = getNumbers();
+	ASSERT_THROW(from(numbers) >> parallel() >> where([](int n)
+	{
+		if (n == 5000)
+			throw runtime_error("failure");
+		return true;
+	}) >> count(), runtime_error);
+}
\ No newline at end of file
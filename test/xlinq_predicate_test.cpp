@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+#include <xlinq/xlinq_from.h>
+#include <xlinq/xlinq_predicate.h>
+#include <xlinq/xlinq_where.h>
+#include <xlinq/xlinq_select.h>
+#include <xlinq/xlinq_count.h>
+#include <xlinq/xlinq_sum.h>
+#include <xlinq/xlinq_to_container.h>
+#include <limits>
+#include <list>
+#include <vector>
+
+using namespace std;
+using namespace xlinq;
+
+TEST(XlinqPredicateTest, ComparisonsFilterIntegers)
+{
+	vector<int> numbers = { -5, 3, 10, 11, 0, 42, -20, 7 };
+	ASSERT_EQ(vector<int>({ 11, 42 }), from(numbers) >> where(field() > 10) >> to_vector());
+	ASSERT_EQ(vector<int>({ -5, 0, -20 }), from(numbers) >> where(field() <= 0) >> to_vector());
+	ASSERT_EQ(vector<int>({ 7 }), from(numbers) >> where(field() == 7) >> to_vector());
+	ASSERT_EQ(vector<int>({ 10, 11, 0, 42, 7 }), from(numbers) >> where(field() != 3 && field() >= 0) >> to_vector());
+	ASSERT_EQ(vector<int>({ -5, 42, -20 }), from(numbers) >> where(field() < -1 || field() > 20) >> to_vector());
+	ASSERT_EQ(vector<int>({ -5, 0, -20 }), from(numbers) >> where(!(field() > 0)) >> to_vector());
+	ASSERT_EQ(vector<int>({ -5, 0, -20 }), from(numbers) >> where(field() < 2.5) >> to_vector());
+}
+
+TEST(XlinqPredicateTest, ComparisonsFilterAcrossBlocks)
+{
+	vector<int> numbers;
+	for (int i = 0; i < 130; ++i)
+		numbers.push_back(i);
+	list<int> listed(numbers.begin(), numbers.end());
+	auto predicate = field() >= 62 && field() < 67;
+	ASSERT_EQ(vector<int>({ 62, 63, 64, 65, 66 }), from(numbers) >> where(predicate) >> to_vector());
+	ASSERT_EQ(from(listed) >> where(predicate) >> to_vector(), from(numbers) >> where(predicate) >> to_vector());
+	ASSERT_EQ(vector<int>({ 128, 129 }), from(numbers) >> where(field() > 127) >> to_vector());
+	ASSERT_EQ(0, from(numbers) >> where(field() < 0 && field() > 5) >> count());
+}
+
+TEST(XlinqPredicateTest, ComparisonsFilterWideAndFloatingTypes)
+{
+	vector<long long> longs = { 10000000000LL, -1, 0, 30000000000LL };
+	ASSERT_EQ(vector<long long>({ 10000000000LL, 30000000000LL }), from(longs) >> where(field() >= 10000000000LL) >> to_vector());
+
+	vector<float> floats = { 0.5f, 1.5f, -2.25f, 10.0f, 12.0f };
+	ASSERT_EQ(vector<float>({ 1.5f, 10.0f }), from(floats) >> where(field() > 1.25f && field() <= 10) >> to_vector());
+	ASSERT_EQ(vector<float>({ -2.25f }), from(floats) >> where(field() < 0.1 && field() < 0.5) >> to_vector());
+
+	vector<double> doubles = { 0.5, 5.5, -1.0, 6.0 };
+	ASSERT_EQ(vector<double>({ 0.5, 5.5, 6.0 }), from(doubles) >> where(field() == 0.5 || field() > 5.0) >> to_vector());
+
+	vector<unsigned> unsigneds = { 1u, 60u, 50u, 99u };
+	ASSERT_EQ(vector<unsigned>({ 60u, 99u }), from(unsigneds) >> where(field() > 50u) >> to_vector());
+}
+
+TEST(XlinqPredicateTest, NotANumberComparesAsInScalarCode)
+{
+	double nan = numeric_limits<double>::quiet_NaN();
+	vector<double> doubles = { 1, nan, 3, nan, 5, 6, nan, 8, 9, 10, nan, 12 };
+	ASSERT_EQ(vector<double>({ 1, 3, 5, 6 }), from(doubles) >> where(field() < 7.0) >> to_vector());
+	ASSERT_EQ(11, from(doubles) >> where(field() != 3.0) >> count());
+	ASSERT_EQ(8, from(doubles) >> where(!(field() >= 7.0)) >> count());
+	ASSERT_FALSE((field() < 7.0)(nan));
+	ASSERT_TRUE((!(field() >= 7.0))(nan));
+
+	vector<float> floats(doubles.begin(), doubles.end());
+	ASSERT_EQ(vector<float>({ 5, 6, 8, 9, 10, 12 }), from(floats) >> where(field() >= 5.0f) >> to_vector());
+	ASSERT_EQ(11, from(floats) >> where(field() != 5.0f) >> count());
+}
+
+struct PredicatePoint
+{
+	int x;
+	double y;
+};
+
+TEST(XlinqPredicateTest, MemberFieldPredicatesFilterElements)
+{
+	vector<PredicatePoint> points = { { 1, 2.5 }, { 4, -1.0 }, { 7, 3.5 }, { 9, 0.0 } };
+	auto xs = from(points) >> where(field(&PredicatePoint::x) > 3 && field(&PredicatePoint::y) >= 0.0)
+		>> select([](const PredicatePoint& p) { return p.x; }) >> to_vector();
+	ASSERT_EQ(vector<int>({ 7, 9 }), xs);
+}
+
+TEST(XlinqPredicateTest, SelectedElementsFlowToBatchedStages)
+{
+	vector<int> numbers;
+	for (int i = 0; i < 10000; ++i)
+		numbers.push_back(i);
+	ASSERT_EQ(4500, from(numbers) >> where(field() >= 1000 && field() < 5500) >> count());
+	ASSERT_EQ(1000LL * 999 / 2, from(numbers) >> where(field() < 1000) >> select([](int i) { return (long long)i; }) >> sum());
+	ASSERT_EQ(vector<int>({ 9998, 9999 }), from(numbers) >> where(field() > 9997) >> to_vector());
+}
\ No newline at end of file
@@ -251,4 +251,19 @@ TEST(XLinqSelectTest, EqualsDifferentSelectorsFromTheSameSource)
 		>> select([](Person person) { return person.secondName; })
 		>> getEnumerator();
 	ASSERT_FALSE(enumerator->equals(second));
-}
\ No newline at end of file
+}
+
+TEST(XLinqSelectTest, NextBatchConvertsElementsTest)
+{
+	auto persons = getPersonsList();
+	auto enumerator = from(persons)
+		>> select([](Person person) { return person.age; })
+		>> getEnumerator();
+	vector<int> buffer;
+
+	ASSERT_EQ(4, enumerator->next_batch(buffer, 4));
+	ASSERT_EQ(vector<int>({ 21, 22, 54, 37 }), buffer);
+	ASSERT_EQ(37, enumerator->current());
+	ASSERT_EQ(2, enumerator->next_batch(buffer, 4));
+	ASSERT_EQ(vector<int>({ 21, 22, 54, 37, 18, 71 }), buffer);
+}
@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+#include <xlinq/xlinq_from.h>
+#include <xlinq/xlinq_semi_join.h>
+#include <xlinq/xlinq_to_container.h>
+#include <cctype>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace xlinq;
+
+TEST(XlinqSemiJoinTest, SemiJoinKeepsElementsWithMatchingKeys)
+{
+	vector<string> strings = { "a", "bb", "ccc", "dd", "eeee", "f" };
+	vector<long> lengths = { 2, 4, 2, 7 };
+	auto semi = from(strings) >> semi_join(lengths,
+		[](const string& s) { return (long)s.size(); },
+		[](long l) { return l; }) >> to_vector();
+	ASSERT_EQ(vector<string>({ "bb", "dd", "eeee" }), semi);
+
+	auto anti = from(strings) >> anti_join(lengths,
+		[](const string& s) { return (long)s.size(); },
+		[](long l) { return l; }) >> to_vector();
+	ASSERT_EQ(vector<string>({ "a", "ccc", "f" }), anti);
+
+	vector<string> prefixes = { "B", "E" };
+	auto caseless = from(strings) >> semi_join(prefixes,
+		[](const string& s) { return s[0]; },
+		[](const string& p) { return p[0]; },
+		[](char c) { return std::hash<char>()((char)toupper(c)); },
+		[](char first, char second) { return toupper(first) == toupper(second); }) >> to_vector();
+	ASSERT_EQ(vector<string>({ "bb", "eeee" }), caseless);
+}
+
+TEST(XlinqSemiJoinTest, AntiJoinWithBloomFilter)
+{
+	vector<int> numbers;
+	for (int i = 0; i < 100000; ++i)
+		numbers.push_back(i * 3);
+	vector<int> others;
+	for (int i = 0; i < 60000; ++i)
+		others.push_back(i * 5);
+
+	vector<int> expectedSemi, expectedAnti;
+	for (int number : numbers)
+		(number % 5 == 0 && number < 300000 ? expectedSemi : expectedAnti).push_back(number);
+
+	auto semi = from(numbers) >> semi_join(others, [](int i) { return i; }, [](int i) { return i; });
+	ASSERT_EQ(expectedSemi, semi >> to_vector());
+	ASSERT_EQ(expectedSemi, semi >> to_vector());
+	auto anti = from(numbers) >> anti_join(others, [](int i) { return i; }, [](int i) { return i; }) >> to_vector();
+	ASSERT_EQ(expectedAnti, anti);
+}
+
+TEST(XlinqSemiJoinTest, SemiJoinKeysSharingLowBits)
+{
+	vector<long long> keys, probes;
+	for (long long i = 0; i < 40000; ++i)
+	{
+		keys.push_back(i << 21);
+		probes.push_back(i << 20);
+	}
+	auto identity = [](long long key) { return key; };
+	auto semi = from(probes) >> semi_join(keys, identity, identity) >> to_vector();
+	ASSERT_EQ(20000u, semi.size());
+	for (int i = 0; i < 20000; ++i)
+		ASSERT_EQ((long long)i << 21, semi[i]);
+	ASSERT_EQ(20000u, (from(probes) >> anti_join(keys, identity, identity) >> to_vector()).size());
+}
\ No newline at end of file
@@ -242,4 +242,16 @@ TEST(XLinqSkipWhileTest, SkipFromEnumerable)
 	ASSERT_TRUE(enumerator->next());
 	ASSERT_EQ(3, enumerator->current());
 	ASSERT_FALSE(enumerator->next());
-}
\ No newline at end of file
+}
+
+TEST(XLinqSkipTest, SkipFromVectorKeepsContiguousData)
+{
+	vector<int> numbers = { 1, 2, 3, 4, 5, 6, 7 };
+	auto enumerable = from(numbers) >> skip(3);
+	ASSERT_EQ(numbers.data() + 3, enumerable->data());
+	ASSERT_EQ(4, enumerable->size());
+
+	auto empty = from(numbers) >> skip(10);
+	ASSERT_EQ(nullptr, empty->data());
+	ASSERT_EQ(0, empty->size());
+}
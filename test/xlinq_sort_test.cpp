@@ -1,8 +1,18 @@
 #include <gtest/gtest.h>
 #include <xlinq/xlinq_sort.h>
 #include <xlinq/xlinq_from.h>
+#include <xlinq/xlinq_count.h>
+#include <xlinq/xlinq_element_at.h>
+#include <xlinq/xlinq_first.h>
+#include <xlinq/xlinq_parallel.h>
+#include <xlinq/xlinq_take.h>
+#include <xlinq/xlinq_where.h>
+#include <xlinq/xlinq_to_container.h>
+#include <algorithm>
 #include <vector>
 #include <string>
+#include <tuple>
+#include <cstdint>
 
 using namespace std;
 using namespace xlinq;
@@ -56,4 +66,180 @@ TEST(XLinqSortTest, SortUnorderedWithComparer)
 	ASSERT_TRUE(enumerator->next());
 	ASSERT_EQ("gggggg", enumerator->current());
 	ASSERT_FALSE(enumerator->next());
+}
+
+TEST(XLinqSortTest, TopKKeepsStableOrder)
+{
+	vector<string> words = { "hh", "gggggg", "ff", "d", "eee", "ccc", "bbb", "aa" };
+	auto top = from(words) >> top_k(4, word_length_comparer) >> to_vector();
+	ASSERT_EQ(vector<string>({ "d", "hh", "ff", "aa" }), top);
+	ASSERT_EQ(vector<string>({ "aa", "bbb" }), from(words) >> top_k(2) >> to_vector());
+	ASSERT_EQ(8, from(words) >> top_k(100) >> count());
+	ASSERT_EQ(0, from(words) >> top_k(0) >> count());
+}
+
+TEST(XLinqSortTest, SortFollowedByTakeSelectsSmallest)
+{
+	vector<int> numbers;
+	for (int i = 0; i < 10000; ++i)
+		numbers.push_back((i * 7919) % 10007);
+	auto expected = numbers;
+	stable_sort(expected.begin(), expected.end());
+	expected.resize(10);
+
+	ASSERT_EQ(expected, from(numbers) >> sort() >> take(10) >> to_vector());
+	ASSERT_EQ(expected, from(numbers) >> where([](int) { return true; }) >> sort() >> take(10) >> to_vector());
+	ASSERT_EQ(expected[0], from(numbers) >> sort() >> first());
+	ASSERT_EQ(*max_element(numbers.begin(), numbers.end()), from(numbers) >> sort([](int a, int b) { return a > b; }) >> take(5) >> first_or_default(-1));
+	vector<int> empty;
+	ASSERT_EQ(-1, from(empty) >> sort() >> first_or_default(-1));
+}
+
+TEST(XLinqSortTest, SortCopiesSourceWhenBuilt)
+{
+	vector<int> numbers = { 3, 1, 2 };
+	auto sorted = from(numbers) >> sort();
+	auto smallest = from(numbers) >> sort() >> take(2);
+	numbers.push_back(0);
+	numbers.clear();
+
+	ASSERT_EQ(vector<int>({ 1, 2, 3 }), sorted >> to_vector());
+	ASSERT_EQ(vector<int>({ 1, 2 }), smallest >> to_vector());
+	ASSERT_EQ(vector<int>({ 1, 2 }), sorted >> take(2) >> to_vector());
+}
+
+TEST(XLinqSortTest, OrderByLazyMatchesStableSort)
+{
+	vector<string> words = { "hh", "gggggg", "ff", "d", "eee", "ccc", "bbb", "aa" };
+	ASSERT_EQ(vector<string>({ "d", "hh", "ff", "aa", "eee", "ccc", "bbb", "gggggg" }), from(words) >> order_by_lazy(word_length_comparer) >> to_vector());
+
+	vector<int> numbers;
+	for (int i = 0; i < 5000; ++i)
+		numbers.push_back((i * 7919) % 1009);
+	auto expected = numbers;
+	stable_sort(expected.begin(), expected.end());
+	auto sorted = from(numbers) >> order_by_lazy();
+	ASSERT_EQ(expected[2500], sorted >> element_at(2500));
+	ASSERT_EQ(expected[17], sorted >> element_at(17));
+	ASSERT_EQ((int)expected.size(), sorted >> count());
+	ASSERT_EQ(expected, sorted >> to_vector());
+
+	auto enumerator = sorted >> getEndEnumerator();
+	for (int i = (int)expected.size() - 1; i >= 0; --i)
+	{
+		ASSERT_TRUE(enumerator->back());
+		ASSERT_EQ(expected[i], enumerator->current());
+	}
+	ASSERT_FALSE(enumerator->back());
+}
+
+TEST(XLinqSortTest, OrderByLazySortsOnlyRequestedPrefix)
+{
+	vector<int> numbers;
+	for (int i = 0; i < 20000; ++i)
+		numbers.push_back((i * 7919) % 20011);
+	int comparisons = 0;
+	auto sorted = from(numbers) >> order_by_lazy([&comparisons](int a, int b) { ++comparisons; return a < b; });
+	auto enumerator = sorted >> getEnumerator();
+	for (int i = 0; i < 10; ++i)
+	{
+		ASSERT_TRUE(enumerator->next());
+		ASSERT_EQ(i, enumerator->current());
+	}
+	ASSERT_LT(comparisons, 10 * (int)numbers.size());
+}
+
+TEST(XLinqSortTest, RadixSortOfNumbers)
+{
+	vector<int> numbers;
+	vector<double> doubles;
+	vector<uint64_t> timestamps;
+	for (int i = 0; i < 3000; ++i)
+	{
+		numbers.push_back((i * 7919) % 6007 - 3000);
+		doubles.push_back(((i * 104729) % 2003 - 1000) / 7.0);
+		timestamps.push_back(1500000000000ULL + (uint64_t)((i * 7919) % 3001) * 1000);
+	}
+	doubles.push_back(-0.0);
+	doubles.push_back(0.0);
+
+	auto expectedNumbers = numbers;
+	stable_sort(expectedNumbers.begin(), expectedNumbers.end());
+	ASSERT_EQ(expectedNumbers, from(numbers) >> sort() >> to_vector());
+
+	auto expectedDoubles = doubles;
+	stable_sort(expectedDoubles.begin(), expectedDoubles.end());
+	ASSERT_EQ(expectedDoubles, from(doubles) >> sort() >> to_vector());
+
+	auto expectedTimestamps = timestamps;
+	stable_sort(expectedTimestamps.begin(), expectedTimestamps.end());
+	ASSERT_EQ(expectedTimestamps, from(timestamps) >> sort() >> to_vector());
+}
+
+TEST(XLinqSortTest, SortByKeepsStableOrder)
+{
+	vector<tuple<int, double, string>> rows;
+	for (int i = 0; i < 2000; ++i)
+		rows.push_back(make_tuple((i * 7919) % 13 - 6, (i % 7) / 2.0, to_string(i)));
+
+	auto expected = rows;
+	stable_sort(expected.begin(), expected.end(), [](const tuple<int, double, string>& a, const tuple<int, double, string>& b)
+	{
+		return make_tuple(get<0>(a), get<1>(a)) < make_tuple(get<0>(b), get<1>(b));
+	});
+	ASSERT_EQ(expected, from(rows) >> sort_by([](const tuple<int, double, string>& row) { return make_tuple(get<0>(row), get<1>(row)); }) >> to_vector());
+
+	stable_sort(expected.begin(), expected.end(), [](const tuple<int, double, string>& a, const tuple<int, double, string>& b)
+	{
+		return get<2>(a) < get<2>(b);
+	});
+	ASSERT_EQ(expected, from(rows) >> sort_by([](const tuple<int, double, string>& row) { return get<2>(row); }) >> to_vector());
+
+	vector<string> words = { "hh", "gggggg", "ff", "d", "eee", "ccc", "bbb", "aa" };
+	ASSERT_EQ(vector<string>({ "d", "hh", "ff", "aa" }), from(words) >> sort_by([](const string& word) { return word.size(); }) >> take(4) >> to_vector());
+}
+
+TEST(XLinqSortTest, ParallelSortKeepsStableOrder)
+{
+	vector<pair<int, int>> items;
+	for (int i = 0; i < 100000; ++i)
+		items.push_back(make_pair((i * 7919) % 1009, i));
+	auto byFirst = [](const pair<int, int>& a, const pair<int, int>& b) { return a.first < b.first; };
+
+	vector<pair<int, int>> expected = items;
+	stable_sort(expected.begin(), expected.end(), byFirst);
+	ASSERT_EQ(expected, from(items) >> sort(byFirst) >> to_vector());
+	ASSERT_EQ(expected, from(items) >> parallel() >> sort(byFirst) >> to_vector());
+
+	vector<int> numbers;
+	for (int i = 0; i < XLINQ_PARALLEL_CHUNK_SIZE * 3 + 17; ++i)
+		numbers.push_back((i * 104729) % 5003 - 2500);
+	vector<int> sorted = numbers;
+	stable_sort(sorted.begin(), sorted.end());
+	ASSERT_EQ(sorted, from(numbers) >> parallel() >> sort() >> to_vector());
+}
+
+TEST(XLinqSortTest, ThenBySortsByFollowingKeys)
+{
+	vector<tuple<string, int, int>> people;
+	for (int i = 0; i < 600; ++i)
+		people.push_back(make_tuple(string(1, 'a' + (i * 7) % 5), (i * 13) % 7, i));
+	auto expected = people;
+	stable_sort(expected.begin(), expected.end(), [](const tuple<string, int, int>& a, const tuple<string, int, int>& b)
+	{
+		if (get<0>(a) != get<0>(b)) return get<0>(a) < get<0>(b);
+		return get<1>(a) > get<1>(b);
+	});
+	ASSERT_EQ(expected, from(people) >> sort_by([](const tuple<string, int, int>& p) { return get<0>(p); })
+		.then_by_descending([](const tuple<string, int, int>& p) { return get<1>(p); }) >> to_vector());
+
+	expected = people;
+	stable_sort(expected.begin(), expected.end(), [](const tuple<string, int, int>& a, const tuple<string, int, int>& b)
+	{
+		return make_pair(get<1>(a), get<2>(a) % 3) < make_pair(get<1>(b), get<2>(b) % 3);
+	});
+	auto byNumbers = sort_by([](const tuple<string, int, int>& p) { return get<1>(p); }).then_by([](const tuple<string, int, int>& p) { return get<2>(p) % 3; });
+	ASSERT_EQ(expected, from(people) >> byNumbers >> to_vector());
+	expected.resize(5);
+	ASSERT_EQ(expected, from(people) >> byNumbers >> take(5) >> to_vector());
 }
\ No newline at end of file
@@ -0,0 +1,154 @@
+#include <gtest/gtest.h>
+#include <xlinq/xlinq_static.h>
+#include <xlinq/xlinq_where.h>
+#include <xlinq/xlinq_select.h>
+#include <xlinq/xlinq_select_many.h>
+#include <xlinq/xlinq_take.h>
+#include <xlinq/xlinq_skip.h>
+#include <xlinq/xlinq_concat.h>
+#include <xlinq/xlinq_sum.h>
+#include <xlinq/xlinq_count.h>
+#include <xlinq/xlinq_min.h>
+#include <xlinq/xlinq_max.h>
+#include <xlinq/xlinq_avg.h>
+#include <xlinq/xlinq_aggregate.h>
+#include <xlinq/xlinq_any.h>
+#include <xlinq/xlinq_all.h>
+#include <xlinq/xlinq_first.h>
+#include <xlinq/xlinq_to_container.h>
+#include <array>
+#include <list>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace xlinq;
+
+TEST(XLinqStaticTest, WhereSelectSum)
+{
+	vector<int> numbers = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+	int result = from_static(numbers)
+		>> where([](int n) { return n % 2 == 0; })
+		>> select([](int n) { return n * n; })
+		>> sum();
+	ASSERT_EQ(4 + 16 + 36 + 64 + 100, result);
+}
+
+TEST(XLinqStaticTest, SelectChangesElementType)
+{
+	list<int> numbers = { 1, 2, 3 };
+	vector<string> result = from_static(numbers)
+		>> select([](int n) { return to_string(n); })
+		>> to_vector();
+	ASSERT_EQ(3, (int)result.size());
+	ASSERT_EQ("1", result[0]);
+	ASSERT_EQ("2", result[1]);
+	ASSERT_EQ("3", result[2]);
+}
+
+TEST(XLinqStaticTest, SkipAndTake)
+{
+	int numbers[] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+	vector<int> result = from_static(numbers) >> skip(2) >> take(3) >> to_vector();
+	ASSERT_EQ((vector<int>{ 3, 4, 5 }), result);
+	ASSERT_EQ(0, from_static(numbers) >> skip(20) >> count());
+	ASSERT_EQ(8, from_static(numbers) >> take(20) >> count());
+	ASSERT_EQ(0, from_static(numbers) >> take(0) >> count());
+}
+
+TEST(XLinqStaticTest, SelectManyFlattensCollections)
+{
+	vector<int> numbers = { 1, 2, 3 };
+	auto query = from_static(numbers)
+		>> select_many([](int n)
+		{
+			vector<int> items;
+			for (int i = 0; i < n; ++i)
+				items.push_back(n);
+			return items;
+		});
+	ASSERT_EQ((vector<int>{ 1, 2, 2, 3, 3, 3 }), query >> to_vector());
+
+	auto enumerator = query.getEnumerator();
+	ASSERT_TRUE(enumerator.next());
+	ASSERT_TRUE(enumerator.next());
+	ASSERT_TRUE(enumerator.next());
+	auto copy = enumerator;
+	ASSERT_TRUE(enumerator.next());
+	ASSERT_EQ(3, enumerator.current());
+	ASSERT_EQ(2, copy.current());
+	ASSERT_TRUE(copy.next());
+	ASSERT_EQ(3, copy.current());
+}
+
+TEST(XLinqStaticTest, ConcatStaticEnumerables)
+{
+	vector<int> first = { 1, 2 };
+	list<int> second = { 3, 4 };
+	vector<int> empty;
+	ASSERT_EQ((vector<int>{ 1, 2, 3, 4 }), from_static(first) >> concat(from_static(second)) >> to_vector());
+	ASSERT_EQ((vector<int>{ 3, 4 }), from_static(empty) >> concat(from_static(second)) >> to_vector());
+	ASSERT_EQ((vector<int>{ 1, 2 }), from_static(first) >> concat(from_static(empty)) >> to_vector());
+}
+
+TEST(XLinqStaticTest, Terminals)
+{
+	vector<int> numbers = { 4, 2, 8, 6 };
+	auto source = from_static(numbers);
+	ASSERT_EQ(4, source >> count());
+	ASSERT_EQ(2, source >> min());
+	ASSERT_EQ(8, source >> max());
+	ASSERT_DOUBLE_EQ(5.0, source >> avg());
+	ASSERT_EQ(384, source >> aggregate([](int a, int b) { return a * b; }));
+	ASSERT_EQ(21, source >> aggregate(1, [](int a, int b) { return a + b; }));
+	ASSERT_TRUE(source >> any());
+	ASSERT_TRUE(source >> any([](int n) { return n > 7; }));
+	ASSERT_FALSE(source >> any([](int n) { return n > 8; }));
+	ASSERT_TRUE(source >> all([](int n) { return n % 2 == 0; }));
+	ASSERT_FALSE(source >> all([](int n) { return n > 2; }));
+	ASSERT_EQ(4, source >> first());
+	ASSERT_EQ(8, source >> first([](int n) { return n > 4; }));
+	ASSERT_EQ(-1, source >> first_or_default(-1, [](int n) { return n > 8; }));
+}
+
+TEST(XLinqStaticTest, EmptyCollectionTerminals)
+{
+	vector<int> empty;
+	auto source = from_static(empty);
+	ASSERT_EQ(0, source >> count());
+	ASSERT_FALSE(source >> any());
+	ASSERT_TRUE(source >> all([](int) { return false; }));
+	ASSERT_EQ(7, source >> first_or_default(7));
+	ASSERT_THROW(source >> sum(), IterationFinishedException);
+	ASSERT_THROW(source >> min(), IterationFinishedException);
+	ASSERT_THROW(source >> max(), IterationFinishedException);
+	ASSERT_THROW(source >> avg(), IterationFinishedException);
+	ASSERT_THROW(source >> first(), IterationFinishedException);
+}
+
+TEST(XLinqStaticTest, ToEnumerableBridge)
+{
+	vector<int> numbers = { 1, 2, 3, 4 };
+	shared_ptr<IEnumerable<int>> enumerable = from_static(numbers)
+		>> select([](int n) { return n * 10; })
+		>> to_enumerable();
+
+	auto enumerator = enumerable->getEnumerator();
+	ASSERT_THROW(enumerator->current(), IterationNotStartedException);
+	ASSERT_TRUE(enumerator->next());
+	ASSERT_EQ(10, enumerator->current());
+	auto clone = enumerator->clone();
+	ASSERT_TRUE(enumerator->equals(clone));
+	ASSERT_TRUE(enumerator->next());
+	ASSERT_FALSE(enumerator->equals(clone));
+	ASSERT_EQ(20, enumerator->current());
+	ASSERT_EQ(10, clone->current());
+	ASSERT_TRUE(enumerator->next());
+	ASSERT_TRUE(enumerator->next());
+	ASSERT_EQ(40, enumerator->current());
+	ASSERT_FALSE(enumerator->next());
+	ASSERT_THROW(enumerator->current(), IterationFinishedException);
+	ASSERT_THROW(enumerator->next(), IterationFinishedException);
+
+	ASSERT_EQ(90, enumerable >> where([](int n) { return n > 10; }) >> sum());
+}
\ No newline at end of file
@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include <xlinq/xlinq_from.h>
+#include <xlinq/xlinq_stats.h>
+#include <xlinq/xlinq_where.h>
+#include <xlinq/xlinq_parallel.h>
+#include <cmath>
+#include <list>
+#include <vector>
+
+using namespace std;
+using namespace xlinq;
+
+TEST(XlinqStatsTest, StatsOfIntegers)
+{
+	vector<int> numbers = { 4, -2, 7, 1, 10, -5 };
+	list<int> listed(numbers.begin(), numbers.end());
+	auto result = from(numbers) >> stats();
+	ASSERT_EQ(6, result.count);
+	ASSERT_EQ(15, result.sum);
+	ASSERT_EQ(-5, result.min);
+	ASSERT_EQ(10, result.max);
+	ASSERT_EQ(2.5, result.mean);
+	ASSERT_EQ(26.25, result.variance());
+	ASSERT_EQ(sqrt(26.25), result.stddev());
+
+	auto fromList = from(listed) >> stats();
+	ASSERT_EQ(result.sum, fromList.sum);
+	ASSERT_EQ(result.min, fromList.min);
+	ASSERT_EQ(result.max, fromList.max);
+	ASSERT_EQ(result.variance(), fromList.variance());
+}
+
+TEST(XlinqStatsTest, StatsOfFloatingPointNumbers)
+{
+	vector<double> doubles = { 2, 4, 4, 4, 5, 5, 7, 9 };
+	auto result = from(doubles) >> stats();
+	ASSERT_EQ(8, result.count);
+	ASSERT_EQ(40.0, result.sum);
+	ASSERT_EQ(2.0, result.min);
+	ASSERT_EQ(9.0, result.max);
+	ASSERT_EQ(5.0, result.mean);
+	ASSERT_EQ(4.0, result.variance());
+	ASSERT_EQ(2.0, result.stddev());
+
+	vector<float> floats(doubles.begin(), doubles.end());
+	auto staticResult = from_static(floats) >> stats();
+	ASSERT_EQ(40.0f, staticResult.sum);
+	ASSERT_EQ(9.0f, staticResult.max);
+	ASSERT_EQ(4.0, staticResult.variance());
+}
+
+TEST(XlinqStatsTest, ParallelStatsMergePartialResults)
+{
+	vector<int> numbers;
+	for (int i = 0; i < 10000; ++i)
+		numbers.push_back(i);
+	auto result = from(numbers) >> parallel() >> stats();
+	ASSERT_EQ(10000, result.count);
+	ASSERT_EQ(49995000, result.sum);
+	ASSERT_EQ(0, result.min);
+	ASSERT_EQ(9999, result.max);
+	ASSERT_EQ(4999.5, result.mean);
+	ASSERT_NEAR(8333333.25, result.variance(), 1e-6);
+}
+
+TEST(XlinqStatsTest, StatsEnumerateSourceOnce)
+{
+	vector<int> numbers;
+	for (int i = 0; i < 1000; ++i)
+		numbers.push_back(i);
+	int evaluated = 0;
+	auto result = from(numbers) >> where([&](int i) { ++evaluated; return i % 2 == 0; }) >> stats();
+	ASSERT_EQ(1000, evaluated);
+	ASSERT_EQ(500, result.count);
+	ASSERT_EQ(249500, result.sum);
+	ASSERT_EQ(0, result.min);
+	ASSERT_EQ(998, result.max);
+	ASSERT_EQ(499.0, result.mean);
+	ASSERT_EQ(83500.0, result.sample_variance());
+}
+
+TEST(XlinqStatsTest, VarianceOfLargeValuesIsStable)
+{
+	vector<long long> numbers;
+	for (int i = 0; i < 1000; ++i)
+		for (long long offset : { 4, 7, 13, 16 })
+			numbers.push_back(1000000000000LL + offset);
+	auto result = from(numbers) >> stats();
+	ASSERT_NEAR(22.5, result.variance(), 1e-3);
+	ASSERT_EQ(1000000000010.0, result.mean);
+}
+
+TEST(XlinqStatsTest, EmptyCollectionThrowsException)
+{
+	vector<int> numbers;
+	try
+	{
+		from(numbers) >> stats();
+		FAIL();
+	}
+	catch (IterationFinishedException)
+	{
+	}
+}
\ No newline at end of file
@@ -1,11 +1,16 @@
 #include <gtest/gtest.h>
 #include <xlinq/xlinq_from.h>
 #include <xlinq/xlinq_stl.h>
+#include <xlinq/xlinq_select.h>
+#include <xlinq/xlinq_where.h>
+#include <string>
 #include <memory>
 #include <vector>
 #include <list>
 #include <forward_list>
 #include <algorithm>
+#include <iterator>
+#include <type_traits>
 
 using namespace std;
 using namespace xlinq;
@@ -217,4 +222,29 @@ TEST(XlinqStlRandomAccessIteratorTest, StlMinElement)
 
 	minElement = std::min_element(container.rbegin(), container.rend());
 	ASSERT_EQ(-1, *minElement);
+}
+
+TEST(XlinqStlTest, ForwardIteratorAlgorithms)
+{
+	forward_list<string> words = { "a", "bb", "bb", "ccc", "dddd" };
+	auto container = from(words) >> where([](const string& w) { return w.size() > 1; }) >> stl();
+	static_assert(is_same<forward_iterator_tag, iterator_traits<decltype(container.begin())>::iterator_category>::value, "forward iterator expected");
+
+	auto repeated = std::adjacent_find(container.begin(), container.end());
+	ASSERT_EQ("bb", *repeated);
+	auto longest = std::max_element(container.begin(), container.end(), [](const string& a, const string& b) { return a.size() < b.size(); });
+	ASSERT_EQ("dddd", *longest);
+	ASSERT_EQ(4, (int)std::distance(container.begin(), container.end()));
+}
+
+TEST(XlinqStlRandomAccessIteratorTest, ComputedElementOutlivesIncrement)
+{
+	vector<int> numbers = { 1, 2, 3 };
+	auto container = from(numbers) >> select([](int i) { return i * 10; }) >> stl();
+
+	auto it = container.begin();
+	const int& first = *it;
+	++it;
+	ASSERT_EQ(10, first);
+	ASSERT_EQ(20, *it);
 }
\ No newline at end of file
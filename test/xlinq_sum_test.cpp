@@ -1,8 +1,10 @@
 #include <gtest/gtest.h>
 #include <memory>
 #include <list>
+#include <vector>
 #include <xlinq/xlinq_from.h>
 #include <xlinq/xlinq_sum.h>
+#include <xlinq/xlinq_skip.h>
 
 using namespace std;
 using namespace xlinq;
@@ -90,4 +92,80 @@ TEST(XlinqSumTest, SumFromDouble)
 {
 	double numbers[] = { 3, 7, -32, 0, -1, 2 };
 	ASSERT_EQ(-21, from(numbers) >> sum());
+}
+
+TEST(XlinqSumTest, SumOfManyBatches)
+{
+	list<int> numbers;
+	for (int i = 1; i <= 1000; ++i)
+		numbers.push_back(i);
+	ASSERT_EQ(500500, from(numbers) >> sum());
+}
+
+TEST(XlinqSumTest, EmptyVectorThrowsException)
+{
+	auto numbers = vector<int>();
+	numbers.reserve(8);
+	try
+	{
+		from(numbers) >> sum();
+		FAIL();
+	}
+	catch (IterationFinishedException)
+	{
+	}
+}
+
+TEST(XlinqSumTest, SkippedVectorUsesContiguousData)
+{
+	vector<int> numbers = { 100, 3, 7, -32, 0, -1, 2 };
+	ASSERT_EQ(-21, from(numbers) >> skip(1) >> sum());
+}
+
+TEST(XlinqSumTest, SumOfVectorTails)
+{
+	vector<int> numbers;
+	for (int i = 1; i <= 33; ++i)
+		numbers.push_back(i);
+	ASSERT_EQ(561, from(numbers) >> sum());
+	numbers.pop_back();
+	ASSERT_EQ(528, from(numbers) >> sum());
+	numbers.pop_back();
+	ASSERT_EQ(496, from(numbers) >> sum());
+	numbers.resize(7);
+	ASSERT_EQ(28, from(numbers) >> sum());
+}
+
+TEST(XlinqSumTest, VectorSumMatchesListSum)
+{
+	vector<long long> longs = { 10000000000LL, -3, 7, 20000000000LL, 5, -1, 8, 2, 9 };
+	list<long long> longList(longs.begin(), longs.end());
+	ASSERT_EQ(from(longList) >> sum(), from(longs) >> sum());
+
+	vector<double> doubles = { 0.5, -1.25, 3.0, 2.75, -0.5, 8.0, 1.5, 0.25, -4.0, 6.5, 0.75 };
+	list<double> doubleList(doubles.begin(), doubles.end());
+	ASSERT_EQ(17.5, from(doubles) >> sum());
+	ASSERT_EQ(from(doubleList) >> sum(), from(doubles) >> sum());
+}
+
+TEST(XlinqSumTest, AccumulatorTypesAndSumModes)
+{
+	vector<int> ints(100000, 100000);
+	list<int> listed(ints.begin(), ints.end());
+	ASSERT_EQ(10000000000LL, from(ints) >> sum<long long>());
+	ASSERT_EQ(10000000000LL, from(listed) >> sum<long long>());
+	ASSERT_EQ(10000000000.0, from(listed) >> sum<double>().mode(SumMode::KAHAN));
+
+	vector<float> floats(1, 100000000.0f);
+	floats.insert(floats.end(), 100000, 1.0f);
+	list<float> floatList(floats.begin(), floats.end());
+	ASSERT_EQ(100100000.0f, from(floats) >> sum().mode(SumMode::KAHAN));
+	ASSERT_EQ(100100000.0f, from(floatList) >> sum().mode(SumMode::KAHAN));
+
+	vector<float> tenths(100000, 0.1f);
+	double exact = 0;
+	for (float tenth : tenths)
+		exact += tenth;
+	ASSERT_NEAR(exact, from(tenths) >> sum().mode(SumMode::PAIRWISE), exact * 1e-6);
+	ASSERT_NEAR(exact, from(tenths) >> sum().mode(SumMode::KAHAN), exact * 1e-6);
 }
\ No newline at end of file
@@ -290,4 +290,15 @@ TEST(XLinqTakeWhileTest, TakeFromEnumerable)
 	ASSERT_TRUE(enumerator->next());
 	ASSERT_EQ(3, enumerator->current());
 	ASSERT_FALSE(enumerator->next());
-}
\ No newline at end of file
+}
+
+TEST(XLinqTakeTest, TakeFromVectorKeepsContiguousData)
+{
+	vector<int> numbers = { 1, 2, 3, 4, 5, 6, 7 };
+	auto enumerable = from(numbers) >> take(3);
+	ASSERT_EQ(numbers.data(), enumerable->data());
+	ASSERT_EQ(3, enumerable->size());
+
+	auto longer = from(numbers) >> take(10);
+	ASSERT_EQ(7, longer->size());
+}
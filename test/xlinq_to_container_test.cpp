@@ -47,6 +47,19 @@ TEST(XlinqToVectorTest, Test)
 	ASSERT_EQ(it, doubled.end());
 }
 
+TEST(XlinqToVectorTest, ManyBatchesTest)
+{
+	list<int> numbers;
+	for (int i = 0; i < 2 * XLINQ_BATCH_SIZE + 3; ++i)
+		numbers.push_back(i);
+	vector<int> odd = from(numbers)
+		>> select([](int n) { return 2 * n + 1; })
+		>> to_vector();
+	ASSERT_EQ(2 * XLINQ_BATCH_SIZE + 3, (int)odd.size());
+	for (int i = 0; i < (int)odd.size(); ++i)
+		ASSERT_EQ(2 * i + 1, odd[i]);
+}
+
 TEST(XlinqToListTest, Test)
 {
 	list<int> numbers = { 1, 2, 3, 4, 5 };
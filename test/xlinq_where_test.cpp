@@ -4,6 +4,9 @@
 #include "model/xlinq_test_model.h"
 #include <memory>
 #include <forward_list>
+#include <vector>
+#include <xlinq/xlinq_take.h>
+#include <xlinq/xlinq_skip.h>
 
 using namespace std;
 using namespace xlinq;
@@ -93,4 +96,68 @@ TEST(XLinqWhereTest, EqualsDifferentSelectorsFromTheSameSource)
 		>> where([](int number) { return number % 3; })
 		>> getEnumerator();
 	ASSERT_FALSE(enumerator->equals(second));
+}
+
+TEST(XLinqWhereTest, NextBatchFiltersAcrossSourceBatches)
+{
+	forward_list<int> numbers = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+	auto enumerator = from(numbers)
+		>> where([](int number) { return number % 2; })
+		>> getEnumerator();
+	vector<int> buffer;
+
+	ASSERT_EQ(3, enumerator->next_batch(buffer, 3));
+	ASSERT_EQ(vector<int>({ 1, 3, 5 }), buffer);
+	ASSERT_EQ(2, enumerator->next_batch(buffer, 3));
+	ASSERT_EQ(vector<int>({ 1, 3, 5, 7, 9 }), buffer);
+}
+
+TEST(XLinqWhereTest, BidirectionalNextBatchContinuesWithNext)
+{
+	vector<int> numbers = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+	auto enumerator = from(numbers)
+		>> where([](int number) { return number > 3; })
+		>> getEnumerator();
+	vector<int> buffer;
+
+	ASSERT_EQ(2, enumerator->next_batch(buffer, 2));
+	ASSERT_EQ(vector<int>({ 4, 5 }), buffer);
+	ASSERT_TRUE(enumerator->next());
+	ASSERT_EQ(6, enumerator->current());
+}
+
+/**
+*	Element counting its copies for test purposes.
+*/
+struct CopyCounter
+{
+	static int copies;
+	int value;
+
+	CopyCounter(int value) : value(value) {}
+	CopyCounter(const CopyCounter& other) : value(other.value) { ++copies; }
+};
+
+int CopyCounter::copies = 0;
+
+TEST(XLinqWhereTest, CurrentPtrDoesNotCopyElementsTest)
+{
+	vector<CopyCounter> numbers;
+	numbers.reserve(10);
+	for (int i = 1; i <= 10; ++i)
+		numbers.push_back(CopyCounter(i));
+	CopyCounter::copies = 0;
+	auto enumerator = from(numbers)
+		>> where([](const CopyCounter& number) { return number.value % 2 == 0; })
+		>> skip(1)
+		>> take(3)
+		>> getEnumerator();
+	ASSERT_TRUE(enumerator->next());
+	ASSERT_EQ(&numbers[3], enumerator->current_ptr());
+	ASSERT_TRUE(enumerator->next());
+	ASSERT_EQ(&numbers[5], enumerator->current_ptr());
+	ASSERT_TRUE(enumerator->next());
+	ASSERT_EQ(&numbers[7], enumerator->current_ptr());
+	ASSERT_FALSE(enumerator->next());
+	ASSERT_EQ(0, CopyCounter::copies);
 }
\ No newline at end of file